@@ -24,7 +24,14 @@ macro(_add_headercheck_target header)
     add_dependencies(headercheck ${target_name})
 
     # link current module's library and libraries provided by the user
-    target_link_libraries(${target_name} PRIVATE nias_cpp::nias_cpp)
+    # headers of the core library are checked against nias_cpp_core only (to ensure that they do not
+    # depend on pybind11 or Python)
+    string(REGEX REPLACE "^src/" "" header_in_src ${header})
+    if(header MATCHES "^src/nias_cpp/" AND NOT header_in_src IN_LIST NIAS_CPP_PYTHON_SOURCES)
+        target_link_libraries(${target_name} PRIVATE nias_cpp::nias_cpp_core)
+    else()
+        target_link_libraries(${target_name} PRIVATE nias_cpp::nias_cpp)
+    endif()
     target_link_libraries(${target_name} PRIVATE ${arg_ADDITIONAL_LIBRARIES})
 
     # add current module's include directories
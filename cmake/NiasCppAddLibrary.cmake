@@ -1,5 +1,10 @@
-# add nias_cpp library target
+# add nias_cpp_core, nias_cpp and nias_cpp_bindings library targets
+#
+# nias_cpp_core contains everything that does not need Python (interfaces, vector arrays, inner products, C++
+# algorithms) and does not link to pybind11 or libpython. nias_cpp adds the embedded Python interpreter and
+# the parts of the library that call into Python on top of nias_cpp_core.
 macro(NIAS_CPP_ADD_LIBRARY)
+    set(core_lib_name nias_cpp_core)
     set(lib_name nias_cpp)
     set(bindings_lib_name ${lib_name}_bindings)
 
@@ -7,13 +12,29 @@ macro(NIAS_CPP_ADD_LIBRARY)
         return()
     endif()
 
+    # files (relative to src/) that depend on pybind11 or the embedded interpreter
+    set(NIAS_CPP_PYTHON_SOURCES
+        nias_cpp/algorithms/gram_schmidt.h
+        nias_cpp/interpreter.cpp
+        nias_cpp/interpreter.h
+        nias_cpp/python_bridge.cpp
+        nias_cpp/python_bridge.h
+        nias_cpp/python_executor.cpp
+        nias_cpp/python_executor.h
+        nias_cpp/vectorarray/numpy.h)
+
     # find C++ source files
     file(
-        GLOB_RECURSE library_sources
+        GLOB_RECURSE core_library_sources
         LIST_DIRECTORIES false
+        RELATIVE "${_NIAS_CPP_DIR}/src"
         "${_NIAS_CPP_DIR}/src/nias_cpp/*.h" "${_NIAS_CPP_DIR}/src/nias_cpp/*.cpp")
+    list(REMOVE_ITEM core_library_sources ${NIAS_CPP_PYTHON_SOURCES})
+    list(TRANSFORM core_library_sources PREPEND "${_NIAS_CPP_DIR}/src/")
+    list(TRANSFORM NIAS_CPP_PYTHON_SOURCES PREPEND "${_NIAS_CPP_DIR}/src/" OUTPUT_VARIABLE library_sources)
 
-    # add C++ library
+    # add C++ libraries
+    add_library(${core_lib_name} ${core_library_sources})
     add_library(${lib_name} ${library_sources})
 
     # add python bindings module
@@ -22,14 +43,24 @@ macro(NIAS_CPP_ADD_LIBRARY)
     pybind11_add_module(${lib_name}_bindings MODULE ${bindings_sources} ${NIAS_CPP_PYBIND11_NO_EXTRAS})
 
     # specify include directories and link libraries
-    target_include_directories(${lib_name} PUBLIC $<BUILD_INTERFACE:${_NIAS_CPP_DIR}/src>
-                                                  $<INSTALL_INTERFACE:${NIAS_CPP_INCLUDE_INSTALL_DIR}>)
-    target_include_directories(${lib_name} PUBLIC $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}>
-                                                  $<INSTALL_INTERFACE:${NIAS_CPP_INCLUDE_INSTALL_DIR}>)
-    target_link_libraries(${lib_name} PUBLIC pybind11::pybind11 pybind11::embed)
+    target_include_directories(${core_lib_name} PUBLIC $<BUILD_INTERFACE:${_NIAS_CPP_DIR}/src>
+                                                       $<INSTALL_INTERFACE:${NIAS_CPP_INCLUDE_INSTALL_DIR}>)
+    target_include_directories(${core_lib_name} PUBLIC $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}>
+                                                       $<INSTALL_INTERFACE:${NIAS_CPP_INCLUDE_INSTALL_DIR}>)
+    find_package(Threads REQUIRED)
+    target_link_libraries(${core_lib_name} PUBLIC Threads::Threads)
+    # shm_open is in librt for glibc versions before 2.34
+    if(UNIX AND NOT APPLE)
+        find_library(NIAS_CPP_RT_LIBRARY rt)
+        if(NIAS_CPP_RT_LIBRARY)
+            target_link_libraries(${core_lib_name} PRIVATE ${NIAS_CPP_RT_LIBRARY})
+        endif()
+    endif()
+    target_link_libraries(${lib_name} PUBLIC ${core_lib_name} pybind11::pybind11 pybind11::embed)
     target_link_libraries(${bindings_lib_name} PRIVATE ${lib_name})
 
     # aliases
+    add_library(nias_cpp::nias_cpp_core ALIAS nias_cpp_core)
     add_library(nias_cpp::nias_cpp ALIAS nias_cpp)
     add_library(nias_cpp::nias_cpp_bindings ALIAS nias_cpp_bindings)
 endmacro()
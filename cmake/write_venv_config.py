@@ -0,0 +1,39 @@
+import sys
+from pathlib import Path
+
+
+def find_site_packages(venv_path):
+    # check the standard layouts first to avoid the (potentially slow) recursive search
+    candidates = [*venv_path.glob("lib/python*/site-packages"), venv_path / "Lib" / "site-packages"]
+    candidates = [path for path in candidates if path.is_dir()]
+    if not candidates:
+        candidates = list(venv_path.rglob("site-packages"))
+    if len(candidates) != 1:
+        raise RuntimeError(f"Could not find virtualenv module path in {venv_path}")
+    return candidates[0].resolve()
+
+
+def find_version(venv_path):
+    with Path.open(venv_path / "pyvenv.cfg") as file:
+        for line in file:
+            key, _, value = line.partition("=")
+            if key.strip() in ("version_info", "version"):
+                return value.strip()
+    raise RuntimeError(f"Could not find Python version in {venv_path / 'pyvenv.cfg'}")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:  # noqa: PLR2004
+        print("Usage: python write_venv_config.py <venv_dir> <output_file>")
+        sys.exit(1)
+    venv_path = Path(sys.argv[1])
+    output_file = Path(sys.argv[2])
+    content = (
+        "# Generated by write_venv_config.py, do not edit\n"
+        f"site_packages={find_site_packages(venv_path)}\n"
+        f"version={find_version(venv_path)}\n"
+    )
+    # only write if something changed to avoid unnecessary rebuilds
+    if not output_file.exists() or output_file.read_text() != content:
+        output_file.parent.mkdir(parents=True, exist_ok=True)
+        output_file.write_text(content)
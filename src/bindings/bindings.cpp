@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <nias_cpp/indices.h>
+#include <nias_cpp/io/mapped_file.h>
 #include <nias_cpp/type_traits.h>
 #include <pybind11/complex.h>  // IWYU pragma: keep
 #include <pybind11/pybind11.h>
@@ -21,7 +22,20 @@ PYBIND11_MODULE(nias_cpp_bindings, m)
         .def(py::init<>())
         .def(py::init<ssize_t>())
         .def(py::init<const std::vector<ssize_t>>())
-        .def(py::init<const py::slice&>())
+        .def(py::init(
+            [](const py::slice& slice)
+            {
+                // PySlice_Unpack fills in the defaults for omitted values (which are then adjusted to the
+                // sequence length by nias::Indices, exactly as PySlice_AdjustIndices would do)
+                Py_ssize_t start = 0;
+                Py_ssize_t stop = 0;
+                Py_ssize_t step = 0;
+                if (PySlice_Unpack(slice.ptr(), &start, &stop, &step) < 0)
+                {
+                    throw py::error_already_set();
+                }
+                return nias::Indices(nias::SliceData{start, stop, step});
+            }))
         .def(py::init(
             [](const py::list& indices)
             {
@@ -54,6 +68,36 @@ PYBIND11_MODULE(nias_cpp_bindings, m)
     nias::bind_nias_listvectorarray<std::complex<double>>(m, "ComplexDouble");
     nias::bind_nias_listvectorarray<std::complex<long double>>(m, "ComplexLongDouble");
 
+    nias::bind_nias_numpyvectorarray<float>(m, "Float");
+    nias::bind_nias_numpyvectorarray<double>(m, "Double");
+    nias::bind_nias_numpyvectorarray<long double>(m, "LongDouble");
+    nias::bind_nias_numpyvectorarray<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_nias_numpyvectorarray<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_nias_numpyvectorarray<std::complex<long double>>(m, "ComplexLongDouble");
+
+    nias::bind_nias_mappednpyvectorarray<float>(m, "Float");
+    nias::bind_nias_mappednpyvectorarray<double>(m, "Double");
+    nias::bind_nias_mappednpyvectorarray<long double>(m, "LongDouble");
+    nias::bind_nias_mappednpyvectorarray<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_nias_mappednpyvectorarray<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_nias_mappednpyvectorarray<std::complex<long double>>(m, "ComplexLongDouble");
+
+    nias::bind_nias_planarcomplexvectorarray<float>(m, "ComplexFloat");
+    nias::bind_nias_planarcomplexvectorarray<double>(m, "ComplexDouble");
+    nias::bind_nias_planarcomplexvectorarray<long double>(m, "ComplexLongDouble");
+
+    nias::bind_nias_sparsevectorarray<float>(m, "Float");
+    nias::bind_nias_sparsevectorarray<double>(m, "Double");
+    nias::bind_nias_sparsevectorarray<long double>(m, "LongDouble");
+    nias::bind_nias_sparsevectorarray<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_nias_sparsevectorarray<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_nias_sparsevectorarray<std::complex<long double>>(m, "ComplexLongDouble");
+
+    // reconstruction functions used for pickling vector arrays
+    m.def("_vector_array_from_buffer", &nias::py_vector_array_from_buffer);
+    m.def("_open_shared_memory_vector_array", &nias::py_open_shared_memory_vector_array);
+    m.def("unlink_shared_memory", &nias::MappedFile::unlink_shared_memory, py::arg("name"));
+
     nias::bind_function_based_inner_product<float>(m, "Float");
     nias::bind_function_based_inner_product<double>(m, "Double");
     nias::bind_function_based_inner_product<long double>(m, "LongDouble");
@@ -61,7 +105,78 @@ PYBIND11_MODULE(nias_cpp_bindings, m)
     nias::bind_function_based_inner_product<std::complex<double>>(m, "ComplexDouble");
     nias::bind_function_based_inner_product<std::complex<long double>>(m, "ComplexLongDouble");
 
+    nias::bind_weighted_euclidean_inner_product<float>(m, "Float");
+    nias::bind_weighted_euclidean_inner_product<double>(m, "Double");
+    nias::bind_weighted_euclidean_inner_product<long double>(m, "LongDouble");
+    nias::bind_weighted_euclidean_inner_product<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_weighted_euclidean_inner_product<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_weighted_euclidean_inner_product<std::complex<long double>>(m, "ComplexLongDouble");
+
+    nias::bind_operators<float>(m, "Float");
+    nias::bind_operators<double>(m, "Double");
+    nias::bind_operators<long double>(m, "LongDouble");
+    nias::bind_operators<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_operators<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_operators<std::complex<long double>>(m, "ComplexLongDouble");
+    nias::bind_operator_based_inner_product<float>(m, "Float");
+    nias::bind_operator_based_inner_product<double>(m, "Double");
+    nias::bind_operator_based_inner_product<long double>(m, "LongDouble");
+    nias::bind_operator_based_inner_product<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_operator_based_inner_product<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_operator_based_inner_product<std::complex<long double>>(m, "ComplexLongDouble");
+    nias::bind_galerkin_projector<float>(m, "Float");
+    nias::bind_galerkin_projector<double>(m, "Double");
+    nias::bind_galerkin_projector<long double>(m, "LongDouble");
+    nias::bind_galerkin_projector<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_galerkin_projector<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_galerkin_projector<std::complex<long double>>(m, "ComplexLongDouble");
+    nias::bind_gram_cache<float>(m, "Float");
+    nias::bind_gram_cache<double>(m, "Double");
+    nias::bind_gram_cache<long double>(m, "LongDouble");
+    nias::bind_gram_cache<std::complex<float>>(m, "ComplexFloat");
+    nias::bind_gram_cache<std::complex<double>>(m, "ComplexDouble");
+    nias::bind_gram_cache<std::complex<long double>>(m, "ComplexLongDouble");
+
+    nias::bind_krylov_solvers<float>(m);
+    nias::bind_krylov_solvers<double>(m);
+    nias::bind_krylov_solvers<long double>(m);
+    nias::bind_krylov_solvers<std::complex<float>>(m);
+    nias::bind_krylov_solvers<std::complex<double>>(m);
+    nias::bind_krylov_solvers<std::complex<long double>>(m);
+
+    nias::bind_eigensolvers<float>(m);
+    nias::bind_eigensolvers<double>(m);
+    nias::bind_eigensolvers<long double>(m);
+    nias::bind_eigensolvers<std::complex<float>>(m);
+    nias::bind_eigensolvers<std::complex<double>>(m);
+    nias::bind_eigensolvers<std::complex<long double>>(m);
+
+    nias::bind_weak_greedy<float>(m);
+    nias::bind_weak_greedy<double>(m);
+    nias::bind_weak_greedy<long double>(m);
+    nias::bind_weak_greedy<std::complex<float>>(m);
+    nias::bind_weak_greedy<std::complex<double>>(m);
+    nias::bind_weak_greedy<std::complex<long double>>(m);
+
+    nias::bind_deim<float>(m);
+    nias::bind_deim<double>(m);
+    nias::bind_deim<long double>(m);
+    nias::bind_deim<std::complex<float>>(m);
+    nias::bind_deim<std::complex<double>>(m);
+    nias::bind_deim<std::complex<long double>>(m);
+
+    nias::bind_save_vector_array<float>(m);
+    nias::bind_save_vector_array<double>(m);
+    nias::bind_save_vector_array<long double>(m);
+    nias::bind_save_vector_array<std::complex<float>>(m);
+    nias::bind_save_vector_array<std::complex<double>>(m);
+    nias::bind_save_vector_array<std::complex<long double>>(m);
+    m.def("load_vector_array", &nias::py_load_vector_array, py::arg("path"), py::arg("num_threads") = 1);
+
     nias::bind_cpp_gram_schmidt<float>(m, "float");
     nias::bind_cpp_gram_schmidt<double>(m, "double");
     nias::bind_cpp_gram_schmidt<long double>(m, "long_double");
+    nias::bind_cpp_mixed_precision_gram_schmidt<float>(m, "float");
+    nias::bind_cpp_mixed_precision_gram_schmidt<double>(m, "double");
+    nias::bind_cpp_mixed_precision_gram_schmidt<long double>(m, "long_double");
 }
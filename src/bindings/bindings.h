@@ -1,24 +1,49 @@
 #ifndef NIAS_CPP_BINDINGS_H
 #define NIAS_CPP_BINDINGS_H
 
+#include <algorithm>
 #include <complex>
 #include <concepts>
+#include <cstring>
+#include <format>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <nias_cpp/algorithms/deim.h>
+#include <nias_cpp/algorithms/eigensolvers.h>
+#include <nias_cpp/algorithms/gram_cache.h>
 #include <nias_cpp/algorithms/gram_schmidt.h>
+#include <nias_cpp/algorithms/krylov.h>
+#include <nias_cpp/algorithms/mixed_precision_gram_schmidt.h>
+#include <nias_cpp/algorithms/projection.h>
+#include <nias_cpp/algorithms/weak_greedy.h>
 #include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
 #include <nias_cpp/indices.h>
 #include <nias_cpp/inner_products/euclidean.h>
 #include <nias_cpp/inner_products/function_based.h>
+#include <nias_cpp/inner_products/operator_based.h>
+#include <nias_cpp/inner_products/weighted_euclidean.h>
 #include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/operator.h>
 #include <nias_cpp/interfaces/vector.h>
 #include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/io/mapped_file.h>
+#include <nias_cpp/io/vectorarray_file.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/operators/identity.h>
 #include <nias_cpp/type_traits.h>
 #include <nias_cpp/vectorarray/list.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
 #include <nias_cpp/vectorarray/numpy.h>
+#include <nias_cpp/vectorarray/planar_complex.h>
+#include <nias_cpp/vectorarray/sparse.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
@@ -26,6 +51,18 @@ namespace nias
 {
 
 
+/// Additional base class of the trampoline classes, i.e., of all objects which are implemented in Python
+class PythonImplementation
+{
+};
+
+/// Whether \c obj is an object of a Python class derived from one of the bound interfaces
+template <class T>
+[[nodiscard]] bool is_python_implementation(const T& obj)
+{
+    return dynamic_cast<const PythonImplementation*>(&obj) != nullptr;
+}
+
 template <class F>
     requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
 auto bind_nias_vectorinterface(pybind11::module& m, const std::string& name = "VectorInterface")
@@ -33,7 +70,7 @@ auto bind_nias_vectorinterface(pybind11::module& m, const std::string& name = "V
     namespace py = pybind11;
 
     // See https://pybind11.readthedocs.io/en/stable/advanced/classes.html#overriding-virtual-functions-in-python
-    class PyVecInterface : public VectorInterface<F>
+    class PyVecInterface : public VectorInterface<F>, public PythonImplementation
     {
        public:
         using VecInterface = VectorInterface<F>;
@@ -111,6 +148,164 @@ auto bind_nias_vectorinterface(pybind11::module& m, const std::string& name = "V
     return ret;
 }
 
+/**
+ * \brief Moves a std::vector into a one-dimensional numpy array without copying the data
+ *
+ * Ownership of the vector (and thus its buffer) is transferred to a capsule which is used as base
+ * object of the returned array, so the data stays valid as long as the numpy array is alive.
+ */
+template <class F>
+pybind11::array_t<F> as_numpy_array(std::vector<F>&& vec)
+{
+    auto owned_vec = std::make_unique<std::vector<F>>(std::move(vec));
+    const auto size = std::ssize(*owned_vec);
+    const F* data = owned_vec->data();
+    const pybind11::capsule owner(owned_vec.get(),
+                                  [](void* ptr)
+                                  {
+                                      delete static_cast<std::vector<F>*>(ptr);
+                                  });
+    // the capsule is responsible for deleting the vector from now on
+    static_cast<void>(owned_vec.release());
+    return pybind11::array_t<F>(size, data, owner);
+}
+
+/**
+ * \brief Moves the buffer of a ReducedMatrix into a two-dimensional numpy array without copying the data
+ *
+ * \sa as_numpy_array(std::vector<F>&&)
+ */
+template <class F>
+pybind11::array_t<F> as_numpy_array(ReducedMatrix<F>&& matrix)
+{
+    const auto num_rows = matrix.rows();
+    const auto num_cols = matrix.cols();
+    auto owned_vec = std::make_unique<std::vector<F>>(matrix.release());
+    const F* data = owned_vec->data();
+    const pybind11::capsule owner(owned_vec.get(),
+                                  [](void* ptr)
+                                  {
+                                      delete static_cast<std::vector<F>*>(ptr);
+                                  });
+    // the capsule is responsible for deleting the vector from now on
+    static_cast<void>(owned_vec.release());
+    return pybind11::array_t<F>({num_rows, num_cols}, data, owner);
+}
+
+/**
+ * \brief Copies a matrix given as vector of rows into a two-dimensional numpy array
+ *
+ * The number of columns has to be given explicitly since it cannot be deduced if there are no rows.
+ */
+template <class F>
+pybind11::array_t<F> as_numpy_array(const std::vector<std::vector<F>>& matrix, ssize_t num_cols)
+{
+    const auto num_rows = std::ssize(matrix);
+    if (std::ranges::any_of(matrix,
+                            [num_cols](const auto& row)
+                            {
+                                return std::ssize(row) != num_cols;
+                            }))
+    {
+        throw nias::InvalidStateError("Result has wrong size.");
+    }
+    pybind11::array_t<F> ret({num_rows, num_cols});
+    auto ret_mutable = ret.mutable_unchecked();
+    for (ssize_t i = 0; i < num_rows; ++i)
+    {
+        std::ranges::copy(matrix[as_size_t(i)], ret_mutable.mutable_data(i, 0));
+    }
+    return ret;
+}
+
+/**
+ * \brief Copies (a subset of) the vectors of \c array into a new two-dimensional numpy array
+ */
+template <class F>
+pybind11::array_t<F> vector_array_to_numpy(const VectorArrayInterface<F>& array,
+                                           const std::optional<Indices>& indices = std::nullopt)
+{
+    if (indices)
+    {
+        indices->check_valid(array.size());
+    }
+    const auto index_vec = indices ? indices->as_vec(array.size()) : std::vector<ssize_t>{};
+    const ssize_t n = indices ? std::ssize(index_vec) : array.size();
+    pybind11::array_t<F> ret({n, array.dim()});
+    auto ret_mutable = ret.mutable_unchecked();
+    for (ssize_t i = 0; i < n; ++i)
+    {
+        const auto index = indices ? index_vec[as_size_t(i)] : i;
+        for (ssize_t j = 0; j < array.dim(); ++j)
+        {
+            ret_mutable(i, j) = array.get(index, j);
+        }
+    }
+    return ret;
+}
+
+/**
+ * \brief Reconstructs a vector array pickled by reduce_vector_array
+ *
+ * \c data is a buffer containing the entries of \c size vectors of dimension \c dim (one vector after the
+ * other). Writable buffers (e.g., buffers that have been pickled in-band) are used without copying,
+ * read-only buffers are copied since vector arrays have to be writable.
+ */
+inline pybind11::object py_vector_array_from_buffer(const pybind11::object& cls, const pybind11::buffer& data,
+                                                    const pybind11::dtype& dtype, ssize_t size, ssize_t dim)
+{
+    namespace py = pybind11;
+
+    const auto numpy = py::module_::import("numpy");
+    py::object array = numpy.attr("frombuffer")(data, dtype).attr("reshape")(size, dim);
+    if (!array.attr("flags").attr("writeable").cast<bool>())
+    {
+        array = array.attr("copy")();
+    }
+    return cls(array);
+}
+
+/// Reconstructs a vector array stored in shared memory (pickled by the MappedNpyVectorArray bindings)
+inline pybind11::object py_open_shared_memory_vector_array(const pybind11::object& cls,
+                                                           const std::string& name, bool writable)
+{
+    return cls.attr("open_shared_memory")(name, writable);
+}
+
+/// Returns the module which defines the class of \c obj (for the bound classes, this is the bindings module)
+inline pybind11::module_ defining_module(const pybind11::handle& obj)
+{
+    namespace py = pybind11;
+
+    return py::module_::import(py::type::of(obj).attr("__module__").cast<std::string>().c_str());
+}
+
+/**
+ * \brief Implements \c __reduce_ex__ for a vector array \c self whose entries are given by \c array
+ *
+ * The vector array is unpickled as NumpyVectorArray (see py_vector_array_from_buffer). For pickle
+ * protocol 5, the data is wrapped in a \c pickle.PickleBuffer, so it can be transferred out-of-band
+ * (without being copied into the pickle stream). For older protocols, numpy's pickle support is used.
+ */
+template <class F>
+pybind11::tuple reduce_vector_array(const pybind11::object& self, const pybind11::array_t<F>& array,
+                                    int protocol)
+{
+    namespace py = pybind11;
+
+    // the reconstruction function is defined in the bindings module (which also defines the class of self)
+    const auto module = defining_module(self);
+    // copies the data only if it is not stored contiguously
+    py::object data = py::array_t<F, py::array::c_style | py::array::forcecast>::ensure(array);
+    if (protocol >= 5)
+    {
+        data = py::module_::import("pickle").attr("PickleBuffer")(data);
+    }
+    return py::make_tuple(module.attr("_vector_array_from_buffer"),
+                          py::make_tuple(py::type::of<NumpyVectorArray<F>>(), data, py::dtype::of<F>(),
+                                         array.shape(0), array.shape(1)));
+}
+
 template <class F>
     requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
 auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_type_name)
@@ -118,10 +313,12 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
     namespace py = pybind11;
 
     // See https://pybind11.readthedocs.io/en/stable/advanced/classes.html#overriding-virtual-functions-in-python
-    class PyVecArrayInterface : public VectorArrayInterface<F>
+    class PyVecArrayInterface : public VectorArrayInterface<F>, public PythonImplementation
     {
        public:
         using VecArrayInterface = VectorArrayInterface<F>;
+        using RealType = typename VecArrayInterface::RealType;
+        using AmaxType = std::pair<std::vector<ssize_t>, std::vector<RealType>>;
 
         /* Inherit the constructors */
         using VecArrayInterface::VecArrayInterface;
@@ -176,6 +373,7 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
         void append(VecArrayInterface& other, bool remove_from_other = false,
                     const std::optional<Indices>& other_indices = std::nullopt) override
         {
+            this->record_append();
             PYBIND11_OVERRIDE_PURE(void,              /* Return type */
                                    VecArrayInterface, /* Parent class */
                                    append,            /* Name of function in C++ (must match Python name) */
@@ -185,6 +383,7 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
 
         void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
         {
+            this->record_modification();
             PYBIND11_OVERRIDE(void,              /* Return type */
                               VecArrayInterface, /* Parent class */
                               scal,              /* Name of function in C++ (must match Python name) */
@@ -194,6 +393,7 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
 
         void scal(F alpha, const std::optional<Indices>& indices = std::nullopt) override
         {
+            this->record_modification();
             PYBIND11_OVERRIDE(void,              /* Return type */
                               VecArrayInterface, /* Parent class */
                               scal,              /* Name of function in C++ (must match Python name) */
@@ -205,6 +405,7 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
                   const std::optional<Indices>& indices = std::nullopt,
                   const std::optional<Indices>& x_indices = std::nullopt) override
         {
+            this->record_modification();
             PYBIND11_OVERRIDE(void,              /* Return type */
                               VecArrayInterface, /* Parent class */
                               axpy,              /* Name of function in C++ (must match Python name) */
@@ -215,6 +416,7 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
         void axpy(F alpha, const VecArrayInterface& x, const std::optional<Indices>& indices = std::nullopt,
                   const std::optional<Indices>& x_indices = std::nullopt) override
         {
+            this->record_modification();
             PYBIND11_OVERRIDE(void,              /* Return type */
                               VecArrayInterface, /* Parent class */
                               axpy,              /* Name of function in C++ (must match Python name) */
@@ -222,6 +424,57 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
             );
         }
 
+        [[nodiscard]] std::vector<std::vector<F>> inner(
+            const VecArrayInterface& other, const std::optional<Indices>& indices = std::nullopt,
+            const std::optional<Indices>& other_indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE(std::vector<std::vector<F>>,  /* Return type */
+                              VecArrayInterface,            /* Parent class */
+                              inner,                        /* Name of function in C++ */
+                              other, indices, other_indices /* Argument(s) */
+            );
+        }
+
+        [[nodiscard]] std::vector<F> pairwise_inner(
+            const VecArrayInterface& other, const std::optional<Indices>& indices = std::nullopt,
+            const std::optional<Indices>& other_indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE(std::vector<F>,               /* Return type */
+                              VecArrayInterface,            /* Parent class */
+                              pairwise_inner,               /* Name of function in C++ */
+                              other, indices, other_indices /* Argument(s) */
+            );
+        }
+
+        [[nodiscard]] std::vector<RealType> norm2(
+            const std::optional<Indices>& indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE(std::vector<RealType>, /* Return type */
+                              VecArrayInterface,     /* Parent class */
+                              norm2,                 /* Name of function in C++ */
+                              indices                /* Argument(s) */
+            );
+        }
+
+        [[nodiscard]] std::shared_ptr<VecArrayInterface> lincomb(
+            const std::vector<std::vector<F>>& coefficients) const override
+        {
+            PYBIND11_OVERRIDE(std::shared_ptr<VecArrayInterface>, /* Return type */
+                              VecArrayInterface,                  /* Parent class */
+                              lincomb,                            /* Name of function in C++ */
+                              coefficients                        /* Argument(s) */
+            );
+        }
+
+        [[nodiscard]] AmaxType amax(const std::optional<Indices>& indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE(AmaxType,          /* Return type */
+                              VecArrayInterface, /* Parent class */
+                              amax,              /* Name of function in C++ */
+                              indices            /* Argument(s) */
+            );
+        }
+
         void print() const override
         {
             PYBIND11_OVERRIDE(void,              /* Return type */
@@ -240,6 +493,13 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
                  return v.size();
              })
         .def_property_readonly("dim", &VecArrayInterface::dim)
+        .def_property_readonly("version",
+                               [](const VecArrayInterface& self)
+                               {
+                                   const auto version = self.version();
+                                   return py::make_tuple(version.appends, version.deletions,
+                                                         version.modifications);
+                               })
         .def("scalar_zero", &VecArrayInterface::scalar_zero)
         .def("copy", &VecArrayInterface::copy)
         .def("append", &VecArrayInterface::append)
@@ -252,7 +512,90 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
         .def("axpy", py::overload_cast<const std::vector<F>&, const nias::VectorArrayInterface<F>&,
                                        const std::optional<Indices>&, const std::optional<Indices>&>(
                          &VecArrayInterface::axpy))
-        .def("is_compatible_array", &VecArrayInterface::is_compatible_array);
+        .def("is_compatible_array", &VecArrayInterface::is_compatible_array)
+        // Bulk operations (one call from Python per operation, the loops run in C++)
+        .def(
+            "inner",
+            [](const VecArrayInterface& self, const VecArrayInterface& other,
+               const std::optional<Indices>& indices, const std::optional<Indices>& other_indices)
+            {
+                const ssize_t cols = other_indices ? other_indices->size(other.size()) : other.size();
+                return as_numpy_array(self.inner(other, indices, other_indices), cols);
+            },
+            py::arg("other"), py::arg("indices") = py::none(), py::arg("other_indices") = py::none())
+        .def(
+            "pairwise_inner",
+            [](const VecArrayInterface& self, const VecArrayInterface& other,
+               const std::optional<Indices>& indices, const std::optional<Indices>& other_indices)
+            {
+                return as_numpy_array(self.pairwise_inner(other, indices, other_indices));
+            },
+            py::arg("other"), py::arg("indices") = py::none(), py::arg("other_indices") = py::none())
+        .def(
+            "norm",
+            [](const VecArrayInterface& self, const std::optional<Indices>& indices)
+            {
+                return as_numpy_array(self.norm(indices));
+            },
+            py::arg("indices") = py::none())
+        .def(
+            "norm2",
+            [](const VecArrayInterface& self, const std::optional<Indices>& indices)
+            {
+                return as_numpy_array(self.norm2(indices));
+            },
+            py::arg("indices") = py::none())
+        .def(
+            "lincomb",
+            [](const VecArrayInterface& self,
+               const py::array_t<F, py::array::c_style | py::array::forcecast>& coefficients)
+            {
+                // a one-dimensional coefficient array results in a single linear combination
+                if (coefficients.ndim() != 1 && coefficients.ndim() != 2)
+                {
+                    throw InvalidArgumentError("lincomb: coefficients must be one- or two-dimensional");
+                }
+                const auto num_rows = coefficients.ndim() == 1 ? 1 : coefficients.shape(0);
+                const auto num_cols = coefficients.shape(coefficients.ndim() - 1);
+                const F* data = coefficients.data();
+                std::vector<std::vector<F>> coefficients_vec(as_size_t(num_rows));
+                for (ssize_t i = 0; i < num_rows; ++i)
+                {
+                    coefficients_vec[as_size_t(i)].assign(data + (i * num_cols), data + ((i + 1) * num_cols));
+                }
+                return self.lincomb(coefficients_vec);
+            },
+            py::arg("coefficients"))
+        .def(
+            "amax",
+            [](const VecArrayInterface& self, const std::optional<Indices>& indices)
+            {
+                auto [max_indices, max_values] = self.amax(indices);
+                return py::make_tuple(as_numpy_array(std::move(max_indices)),
+                                      as_numpy_array(std::move(max_values)));
+            },
+            py::arg("indices") = py::none())
+        .def(
+            "dofs",
+            [](const VecArrayInterface& self, const std::vector<ssize_t>& dof_indices,
+               const std::optional<Indices>& indices)
+            {
+                return as_numpy_array(self.dofs(dof_indices, indices), std::ssize(dof_indices));
+            },
+            py::arg("dof_indices"), py::arg("indices") = py::none())
+        .def(
+            "to_numpy",
+            [](const VecArrayInterface& self, const std::optional<Indices>& indices)
+            {
+                return vector_array_to_numpy(self, indices);
+            },
+            py::arg("indices") = py::none())
+        .def("__reduce_ex__",
+             [](const py::object& self, int protocol)
+             {
+                 const auto& array = self.cast<const VecArrayInterface&>();
+                 return reduce_vector_array<F>(self, vector_array_to_numpy(array), protocol);
+             });
 
     using ListVecArray = ListVectorArray<F>;
     auto ret =
@@ -271,27 +614,385 @@ auto bind_nias_listvectorarray(pybind11::module& m, const std::string& field_typ
                  py::arg("other"), py::arg("remove_from_other") = false,
                  py::arg("other_indices") = py::none())
             .def("delete", &ListVecArray::delete_vectors, py::arg("indices"))
-            // .def("scal", py::overload_cast<F, const std::optional<Indices>&>(&ListVecArray::scal),
-            //      py::arg("alpha"), py::arg("indices") = py::none())
-            // .def("scal",
-            //      py::overload_cast<const std::vector<F>&, const std::optional<Indices>&>(&ListVecArray::scal),
-            //      py::arg("alpha"), py::arg("indices") = py::none())
-            // .def("axpy",
-            //      py::overload_cast<F, const VecArrayInterface&, const std::optional<Indices>&,
-            //                        const std::optional<Indices>&>(&ListVecArray::axpy),
-            //      py::arg("alpha"), py::arg("x"), py::arg("indices") = py::none(),
-            //      py::arg("x_indices") = py::none())
-            // .def("axpy",
-            //      py::overload_cast<const std::vector<F>&, const VecArrayInterface&,
-            //                        const std::optional<Indices>&, const std::optional<Indices>&>(
-            //          &ListVecArray::axpy),
-            //      py::arg("alpha"), py::arg("x"), py::arg("indices") = py::none(),
-            //      py::arg("x_indices") = py::none())
+            .def("scal", py::overload_cast<F, const std::optional<Indices>&>(&ListVecArray::scal),
+                 py::arg("alpha"), py::arg("indices") = py::none())
+            .def("scal",
+                 py::overload_cast<const std::vector<F>&, const std::optional<Indices>&>(&ListVecArray::scal),
+                 py::arg("alpha"), py::arg("indices") = py::none())
+            .def("axpy",
+                 py::overload_cast<F, const VecArrayInterface&, const std::optional<Indices>&,
+                                   const std::optional<Indices>&>(&ListVecArray::axpy),
+                 py::arg("alpha"), py::arg("x"), py::arg("indices") = py::none(),
+                 py::arg("x_indices") = py::none())
+            .def("axpy",
+                 py::overload_cast<const std::vector<F>&, const VecArrayInterface&,
+                                   const std::optional<Indices>&, const std::optional<Indices>&>(
+                     &ListVecArray::axpy),
+                 py::arg("alpha"), py::arg("x"), py::arg("indices") = py::none(),
+                 py::arg("x_indices") = py::none())
             .def("is_compatible_array", &ListVecArray::is_compatible_array)
             .def("print", &ListVecArray::print);
     return ret;
 }
 
+/**
+ * \brief Binds NumpyVectorArray<F>
+ *
+ * The VectorArrayInterface has to be bound before (see bind_nias_listvectorarray).
+ * A NumpyVectorArray can be constructed from a two-dimensional numpy array with matching dtype without
+ * copying (arrays with a different dtype are rejected instead of being converted), and \c to_numpy
+ * returns the underlying numpy array (without copying unless \c ensure_copy is \c true).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_nias_numpyvectorarray(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using VecArrayInterface = VectorArrayInterface<F>;
+    using NumpyVecArray = NumpyVectorArray<F>;
+    auto ret =
+        py::class_<NumpyVecArray, VecArrayInterface, std::shared_ptr<NumpyVecArray>>(
+            m, (field_type_name + "NumpyVectorArray").c_str())
+            .def(py::init<const py::array_t<F>&>(), py::arg("array").noconvert())
+            .def(py::init<ssize_t, ssize_t>(), py::arg("size"), py::arg("dim"))
+            .def("__len__",
+                 [](const NumpyVecArray& v)
+                 {
+                     return v.size();
+                 })
+            .def_property_readonly("dim", &NumpyVecArray::dim)
+            .def(
+                "to_numpy",
+                [](const NumpyVecArray& self, bool ensure_copy)
+                {
+                    return ensure_copy ? py::array_t<F>(self.array().request()) : self.array();
+                },
+                py::arg("ensure_copy") = false)
+            .def("copy", &NumpyVecArray::copy, py::arg("indices") = py::none())
+            .def("append", &NumpyVecArray::append, py::arg("other"), py::arg("remove_from_other") = false,
+                 py::arg("other_indices") = py::none())
+            .def("delete", &NumpyVecArray::delete_vectors, py::arg("indices"))
+            .def("is_compatible_array", &NumpyVecArray::is_compatible_array)
+            .def("print", &NumpyVecArray::print)
+            .def("__reduce_ex__",
+                 [](const py::object& self, int protocol)
+                 {
+                     return reduce_vector_array<F>(self, self.cast<const NumpyVecArray&>().array(), protocol);
+                 });
+    return ret;
+}
+
+/**
+ * \brief Binds MappedNpyVectorArray<F>
+ *
+ * The VectorArrayInterface has to be bound before (see bind_nias_listvectorarray). Arrays stored in shared
+ * memory (see \c create_shared_memory) are pickled by name, so worker processes (e.g., started by
+ * \c multiprocessing) attach to the same memory instead of receiving a copy. Arrays backed by a file are
+ * pickled by path, all other arrays are pickled like NumpyVectorArrays. Like for the other backends,
+ * \c to_numpy returns a copy, since \c append and \c delete may move the mapped data.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_nias_mappednpyvectorarray(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using VecArrayInterface = VectorArrayInterface<F>;
+    using MappedVecArray = MappedNpyVectorArray<F>;
+    const auto mode = [](bool writable)
+    {
+        return writable ? MappedFileMode::read_write : MappedFileMode::read_only;
+    };
+    auto ret =
+        py::class_<MappedVecArray, VecArrayInterface, std::shared_ptr<MappedVecArray>>(
+            m, (field_type_name + "MappedNpyVectorArray").c_str())
+            .def(py::init<ssize_t, ssize_t>(), py::arg("size"), py::arg("dim"))
+            .def(py::init(
+                     [mode](const std::string& path, bool writable)
+                     {
+                         return std::make_shared<MappedVecArray>(path, mode(writable));
+                     }),
+                 py::arg("path"), py::arg("writable") = false)
+            .def_static(
+                "create",
+                [](const std::string& path, ssize_t size, ssize_t dim, bool fortran_order)
+                {
+                    return MappedVecArray::create(path, size, dim, fortran_order);
+                },
+                py::arg("path"), py::arg("size"), py::arg("dim"), py::arg("fortran_order") = false)
+            .def_static("create_shared_memory", &MappedVecArray::create_shared_memory, py::arg("name"),
+                        py::arg("size"), py::arg("dim"))
+            .def_static(
+                "open_shared_memory",
+                [mode](const std::string& name, bool writable)
+                {
+                    return MappedVecArray::open_shared_memory(name, mode(writable));
+                },
+                py::arg("name"), py::arg("writable") = true)
+            .def("__len__",
+                 [](const MappedVecArray& v)
+                 {
+                     return v.size();
+                 })
+            .def_property_readonly("dim", &MappedVecArray::dim)
+            .def_property_readonly("writable", &MappedVecArray::writable)
+            .def_property_readonly("fortran_order", &MappedVecArray::fortran_order)
+            .def_property_readonly("path",
+                                   [](const MappedVecArray& self)
+                                   {
+                                       return self.path().string();
+                                   })
+            .def_property_readonly("shared_memory_name", &MappedVecArray::shared_memory_name)
+            .def("flush", &MappedVecArray::flush)
+            .def("copy", &MappedVecArray::copy, py::arg("indices") = py::none())
+            .def("append", &MappedVecArray::append, py::arg("other"), py::arg("remove_from_other") = false,
+                 py::arg("other_indices") = py::none())
+            .def("delete", &MappedVecArray::delete_vectors, py::arg("indices"))
+            .def("is_compatible_array", &MappedVecArray::is_compatible_array)
+            .def("__reduce_ex__",
+                 [](const py::object& self, int protocol)
+                 {
+                     const auto& array = self.cast<const MappedVecArray&>();
+                     if (!array.shared_memory_name().empty())
+                     {
+                         const auto args =
+                             py::make_tuple(py::type::of(self), array.shared_memory_name(), array.writable());
+                         return py::make_tuple(defining_module(self).attr("_open_shared_memory_vector_array"),
+                                               args);
+                     }
+                     if (!array.path().empty())
+                     {
+                         return py::make_tuple(py::type::of(self),
+                                               py::make_tuple(array.path().string(), array.writable()));
+                     }
+                     return reduce_vector_array<F>(self, vector_array_to_numpy(array), protocol);
+                 });
+    return ret;
+}
+
+/**
+ * \brief Binds PlanarComplexVectorArray<R>
+ *
+ * The VectorArrayInterface has to be bound before (see bind_nias_listvectorarray). Numpy arrays are split
+ * into real and imaginary parts when an array is created from them and are interleaved again by \c to_numpy,
+ * all other operations work on the separate planes.
+ */
+template <std::floating_point R>
+auto bind_nias_planarcomplexvectorarray(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using F = std::complex<R>;
+    using VecArrayInterface = VectorArrayInterface<F>;
+    using PlanarVecArray = PlanarComplexVectorArray<R>;
+    const auto to_numpy = [](const PlanarVecArray& self)
+    {
+        py::array_t<F> ret({self.size(), self.dim()});
+        self.to_interleaved(ret.mutable_data());
+        return ret;
+    };
+    auto ret =
+        py::class_<PlanarVecArray, VecArrayInterface, std::shared_ptr<PlanarVecArray>>(
+            m, (field_type_name + "PlanarVectorArray").c_str())
+            .def(py::init<ssize_t, ssize_t>(), py::arg("size"), py::arg("dim"))
+            .def(py::init(
+                     [](const py::array_t<F, py::array::c_style | py::array::forcecast>& array)
+                     {
+                         if (array.ndim() != 2)
+                         {
+                             throw InvalidArgumentError("PlanarVectorArray: array must be 2-dimensional");
+                         }
+                         return std::make_shared<PlanarVecArray>(array.data(), array.shape(0),
+                                                                 array.shape(1));
+                     }),
+                 py::arg("array"))
+            .def("__len__",
+                 [](const PlanarVecArray& v)
+                 {
+                     return v.size();
+                 })
+            .def_property_readonly("dim", &PlanarVecArray::dim)
+            .def("to_numpy", to_numpy)
+            .def("copy", &PlanarVecArray::copy, py::arg("indices") = py::none())
+            .def("append", &PlanarVecArray::append, py::arg("other"), py::arg("remove_from_other") = false,
+                 py::arg("other_indices") = py::none())
+            .def("delete", &PlanarVecArray::delete_vectors, py::arg("indices"))
+            .def("is_compatible_array", &PlanarVecArray::is_compatible_array)
+            .def("__reduce_ex__",
+                 [to_numpy](const py::object& self, int protocol)
+                 {
+                     const auto& array = self.cast<const PlanarVecArray&>();
+                     return reduce_vector_array<F>(self, to_numpy(array), protocol);
+                 });
+    return ret;
+}
+
+/// Copies one of the (one-dimensional) \c indptr, \c indices or \c data arrays of a scipy CSR matrix
+template <class T>
+std::vector<T> csr_array_to_vector(
+    const pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>& array)
+{
+    if (array.ndim() != 1)
+    {
+        throw InvalidArgumentError("CSR arrays must be 1-dimensional");
+    }
+    return std::vector<T>(array.data(), array.data() + array.size());
+}
+
+/**
+ * \brief Binds SparseVectorArray<F>
+ *
+ * The VectorArrayInterface has to be bound before (see bind_nias_listvectorarray). Arrays can be created from
+ * (and converted to) the \c indptr, \c indices and \c data arrays of a scipy csr_matrix. Pickled arrays are
+ * reconstructed from these arrays, so they stay sparse.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_nias_sparsevectorarray(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using VecArrayInterface = VectorArrayInterface<F>;
+    using SparseVecArray = SparseVectorArray<F>;
+    using IndexArray = py::array_t<ssize_t, py::array::c_style | py::array::forcecast>;
+    const auto to_csr = [](const SparseVecArray& self)
+    {
+        return py::make_tuple(py::array_t<ssize_t>(std::ssize(self.row_offsets()), self.row_offsets().data()),
+                              py::array_t<ssize_t>(self.nnz(), self.column_indices().data()),
+                              py::array_t<F>(self.nnz(), self.values().data()));
+    };
+    auto ret =
+        py::class_<SparseVecArray, VecArrayInterface, std::shared_ptr<SparseVecArray>>(
+            m, (field_type_name + "SparseVectorArray").c_str())
+            .def(py::init<ssize_t, ssize_t>(), py::arg("size"), py::arg("dim"))
+            .def(py::init(
+                     [](ssize_t dim, const IndexArray& indptr, const IndexArray& indices,
+                        const py::array_t<F, py::array::c_style | py::array::forcecast>& data)
+                     {
+                         return std::make_shared<SparseVecArray>(dim, csr_array_to_vector(indptr),
+                                                                 csr_array_to_vector(indices),
+                                                                 csr_array_to_vector(data));
+                     }),
+                 py::arg("dim"), py::arg("indptr"), py::arg("indices"), py::arg("data"))
+            .def("__len__",
+                 [](const SparseVecArray& v)
+                 {
+                     return v.size();
+                 })
+            .def_property_readonly("dim", &SparseVecArray::dim)
+            .def_property_readonly("nnz",
+                                   [](const SparseVecArray& v)
+                                   {
+                                       return v.nnz();
+                                   })
+            .def("to_csr", to_csr)
+            .def("copy", &SparseVecArray::copy, py::arg("indices") = py::none())
+            .def("append", &SparseVecArray::append, py::arg("other"), py::arg("remove_from_other") = false,
+                 py::arg("other_indices") = py::none())
+            .def("delete", &SparseVecArray::delete_vectors, py::arg("indices"))
+            .def("is_compatible_array", &SparseVecArray::is_compatible_array)
+            .def("add_to",
+                 py::overload_cast<VecArrayInterface&, const std::vector<F>&, const std::optional<Indices>&,
+                                   const std::optional<Indices>&>(&SparseVecArray::add_to, py::const_),
+                 py::arg("y"), py::arg("alpha"), py::arg("y_indices") = py::none(),
+                 py::arg("indices") = py::none())
+            .def("__reduce_ex__",
+                 [to_csr](const py::object& self, int /*protocol*/)
+                 {
+                     const auto& array = self.cast<const SparseVecArray&>();
+                     const auto csr = to_csr(array);
+                     return py::make_tuple(py::type::of(self),
+                                           py::make_tuple(array.dim(), csr[0], csr[1], csr[2]));
+                 });
+    return ret;
+}
+
+/**
+ * \brief Binds save_vector_array for VectorArrays with scalar type F
+ *
+ * All scalar types are bound as overloads of the same Python function. NumpyVectorArrays stored in C order
+ * are written directly from memory without holding the GIL (using up to \c num_threads threads). All other
+ * arrays may be implemented in Python, so their entries are obtained by \c get on the calling thread.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+void bind_save_vector_array(pybind11::module& m)
+{
+    namespace py = pybind11;
+
+    m.def(
+        "save_vector_array",
+        [](const VectorArrayInterface<F>& array, const std::string& path, ssize_t num_threads)
+        {
+            const auto* numpy_array = dynamic_cast<const NumpyVectorArray<F>*>(&array);
+            if (numpy_array != nullptr && (numpy_array->array().flags() & py::array::c_style) != 0)
+            {
+                const auto header = VectorArrayFileHeader::for_scalar_type<F>(array.size(), array.dim());
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                const auto* data = reinterpret_cast<const char*>(numpy_array->array().data());
+                const py::gil_scoped_release release;
+                write_vector_array_file(
+                    path, header,
+                    [data](ssize_t offset, ssize_t count, char* buffer)
+                    {
+                        std::memcpy(buffer, data + offset, as_size_t(count));
+                    },
+                    {.num_threads = num_threads});
+                return;
+            }
+            save_vector_array(array, path, {.num_threads = 1});
+        },
+        py::arg("array"), py::arg("path"), py::arg("num_threads") = 1);
+}
+
+/**
+ * \brief Loads the vector array file \c path into a new NumpyVectorArray
+ *
+ * The scalar type of the returned array is determined by the file. The data is read without holding the GIL.
+ */
+inline pybind11::object py_load_vector_array(const std::string& path, ssize_t num_threads)
+{
+    namespace py = pybind11;
+
+    const auto header = read_vector_array_file_header(path);
+    py::object ret = py::none();
+    const auto load = [&]<class F>(std::type_identity<F> /*scalar_type*/)
+    {
+        if (!ret.is_none() || !header.has_scalar_type<F>())
+        {
+            return;
+        }
+        py::array_t<F> array({header.size, header.dim});
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto* data = reinterpret_cast<char*>(array.mutable_data());
+        {
+            const py::gil_scoped_release release;
+            read_vector_array_file(
+                path, header,
+                [data](ssize_t offset, ssize_t count, const char* buffer)
+                {
+                    std::memcpy(data + offset, buffer, as_size_t(count));
+                },
+                {.num_threads = num_threads});
+        }
+        ret = py::cast(std::make_shared<NumpyVectorArray<F>>(array));
+    };
+    std::apply(
+        [&](auto... scalar_types)
+        {
+            (load(scalar_types), ...);
+        },
+        std::tuple<std::type_identity<float>, std::type_identity<double>, std::type_identity<long double>,
+                   std::type_identity<std::complex<float>>, std::type_identity<std::complex<double>>,
+                   std::type_identity<std::complex<long double>>>{});
+    if (ret.is_none())
+    {
+        throw InvalidArgumentError(std::format("load_vector_array: unsupported scalar type in {}", path));
+    }
+    return ret;
+}
+
 template <class F>
     requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
 auto bind_cpp_gram_schmidt(pybind11::module& m, const std::string& field_type_name)
@@ -305,6 +1006,279 @@ auto bind_cpp_gram_schmidt(pybind11::module& m, const std::string& field_type_na
               gram_schmidt_cpp(vec_array);
               return vec_array.array();
           });
+    m.def((field_type_name + "_gram_schmidt_cpp").c_str(),
+          [](const pybind11::array_t<F>& numpy_array, const InnerProductInterface<F>& inner_product)
+          {
+              auto numpy_array_copy = pybind11::array_t<F>(numpy_array.request());
+              NumpyVectorArray<F> vec_array(numpy_array_copy);
+              gram_schmidt_cpp(vec_array, inner_product);
+              return vec_array.array();
+          });
+}
+
+template <std::floating_point F>
+auto bind_cpp_mixed_precision_gram_schmidt(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+    m.def((field_type_name + "_mixed_precision_gram_schmidt_cpp").c_str(),
+          [](const py::array_t<F>& numpy_array, double tolerance, bool cholesky_qr_correction)
+          {
+              auto numpy_array_copy = py::array_t<F>(numpy_array.request());
+              NumpyVectorArray<F> vec_array(numpy_array_copy);
+              mixed_precision_gram_schmidt<F, float>(
+                  vec_array, {.tolerance = tolerance, .cholesky_qr_correction = cholesky_qr_correction});
+              return vec_array.array();
+          },
+          py::arg("array"), py::arg("tolerance") = 0., py::arg("cholesky_qr_correction") = false);
+}
+
+/**
+ * \brief Binds the Krylov solvers cg, block_cg, minres and gmres for scalar type F
+ *
+ * All scalar types are bound as overloads of the same Python functions. The solutions are written to the
+ * \c solution array (which contains the initial guesses), the result is returned as a dict.
+ */
+/**
+ * \brief Returns \c vec_array or, if \c num_threads is not 1, a copy of it which can be used without the GIL
+ *
+ * Bindings which use more than one thread release the GIL during the computation. Otherwise, worker
+ * threads which call into Python would wait for the GIL while the calling thread holds it and waits for
+ * them. Without the GIL, only vector arrays which do not touch Python objects can be used, which excludes
+ * NumpyVectorArrays (e.g., \c copy creates a numpy array) and arrays implemented in Python. All arrays
+ * except MappedNpyVectorArrays are thus copied to a MappedNpyVectorArray (with the GIL held). Operators and
+ * inner products implemented in Python are rejected (see check_threadable).
+ */
+template <class F>
+std::shared_ptr<VectorArrayInterface<F>> threadable_array(
+    const std::shared_ptr<VectorArrayInterface<F>>& vec_array, ssize_t num_threads)
+{
+    if (num_threads == 1 || dynamic_cast<const MappedNpyVectorArray<F>*>(vec_array.get()) != nullptr)
+    {
+        return vec_array;
+    }
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(0, vec_array->dim());
+    ret->append(*vec_array);
+    return ret;
+}
+
+/// Throws if \c num_threads is not 1 and \c op is implemented in Python (see threadable_array)
+template <class F>
+void check_threadable(const OperatorInterface<F>& op, ssize_t num_threads)
+{
+    if (num_threads != 1 && is_python_implementation(op))
+    {
+        throw InvalidArgumentError("operators implemented in Python require num_threads = 1");
+    }
+}
+
+/**
+ * \brief Throws if \c num_threads is not 1 and \c inner_product is implemented in Python (see
+ * threadable_array)
+ *
+ * The operator of an OperatorBasedInnerProduct is checked as well.
+ */
+template <class F>
+void check_threadable(const InnerProductInterface<F>& inner_product, ssize_t num_threads)
+{
+    if (num_threads != 1 && is_python_implementation(inner_product))
+    {
+        throw InvalidArgumentError("inner products implemented in Python require num_threads = 1");
+    }
+    if (const auto* operator_based = dynamic_cast<const OperatorBasedInnerProduct<F>*>(&inner_product))
+    {
+        check_threadable(operator_based->op(), num_threads);
+    }
+}
+
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+void bind_krylov_solvers(pybind11::module& m)
+{
+    namespace py = pybind11;
+    using Solver = KrylovResult (*)(const OperatorInterface<F>&, const VectorArrayInterface<F>&,
+                                    VectorArrayInterface<F>&, const KrylovOptions&);
+
+    for (const auto& [name, solver] : {std::pair<const char*, Solver>{"cg", &cg<F>},
+                                       {"block_cg", &block_cg<F>},
+                                       {"minres", &minres<F>},
+                                       {"gmres", &gmres<F>}})
+    {
+        m.def(
+            name,
+            [solver](const OperatorInterface<F>& op, const VectorArrayInterface<F>& rhs,
+                     VectorArrayInterface<F>& solution, double tolerance, ssize_t max_iterations,
+                     ssize_t restart)
+            {
+                auto result = solver(
+                    op, rhs, solution,
+                    {.tolerance = tolerance, .max_iterations = max_iterations, .restart = restart});
+                py::dict ret;
+                ret["num_iterations"] = result.num_iterations;
+                ret["residual_norms"] = as_numpy_array(std::move(result.residual_norms));
+                ret["converged"] = result.converged;
+                ret["block_breakdown"] = result.block_breakdown;
+                return ret;
+            },
+            py::arg("op"), py::arg("rhs"), py::arg("solution"), py::arg("tolerance") = 1e-10,
+            py::arg("max_iterations") = 1000, py::arg("restart") = 30);
+    }
+}
+
+/**
+ * \brief Binds the eigensolvers lobpcg and lanczos for scalar type F
+ *
+ * All scalar types are bound as overloads of the same Python functions. \c which is \c "smallest" or
+ * \c "largest", the result is returned as a dict. If \c num_threads is not 1, the GIL is released during
+ * the computation (see threadable_array).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+void bind_eigensolvers(pybind11::module& m)
+{
+    namespace py = pybind11;
+    using Solver = EigensolverResult<F> (*)(const OperatorInterface<F>&, const VectorArrayInterface<F>&,
+                                            const InnerProductInterface<F>&, const EigensolverOptions&);
+
+    for (const auto& [name, solver] :
+         {std::pair<const char*, Solver>{"lobpcg", &lobpcg<F>}, {"lanczos", &lanczos<F>}})
+    {
+        m.def(
+            name,
+            [solver](const OperatorInterface<F>& op,
+                     const std::shared_ptr<VectorArrayInterface<F>>& initial_vectors,
+                     const InnerProductInterface<F>& inner_product, ssize_t num_eigenvalues,
+                     const std::string& which, double tolerance, ssize_t max_iterations, ssize_t krylov_dim,
+                     ssize_t num_threads)
+            {
+                if (which != "smallest" && which != "largest")
+                {
+                    throw InvalidArgumentError("which must be 'smallest' or 'largest'");
+                }
+                check_threadable(op, num_threads);
+                check_threadable(inner_product, num_threads);
+                const auto threadable_initial_vectors = threadable_array(initial_vectors, num_threads);
+                const EigensolverOptions options{
+                    .num_eigenvalues = num_eigenvalues,
+                    .which =
+                        which == "smallest" ? EigenvalueSelection::smallest : EigenvalueSelection::largest,
+                    .tolerance = tolerance,
+                    .max_iterations = max_iterations,
+                    .krylov_dim = krylov_dim,
+                    .num_threads = num_threads};
+                EigensolverResult<F> result;
+                {
+                    std::optional<py::gil_scoped_release> release;
+                    if (num_threads != 1)
+                    {
+                        release.emplace();
+                    }
+                    result = solver(op, *threadable_initial_vectors, inner_product, options);
+                }
+                py::dict ret;
+                ret["eigenvalues"] = as_numpy_array(std::move(result.eigenvalues));
+                ret["eigenvectors"] = result.eigenvectors;
+                ret["residual_norms"] = as_numpy_array(std::move(result.residual_norms));
+                ret["num_iterations"] = result.num_iterations;
+                ret["converged"] = result.converged;
+                return ret;
+            },
+            py::arg("op"), py::arg("initial_vectors"), py::arg("inner_product"),
+            py::arg("num_eigenvalues") = 1, py::arg("which") = "smallest", py::arg("tolerance") = 1e-8,
+            py::arg("max_iterations") = 1000, py::arg("krylov_dim") = 0, py::arg("num_threads") = 1);
+    }
+}
+
+/**
+ * \brief Binds weak_greedy for scalar type F
+ *
+ * All scalar types are bound as overloads of the same Python function. The Python callables
+ * <tt>estimate_error(basis, i)</tt> and <tt>solve(i)</tt> need the GIL, so the errors are estimated in
+ * the calling thread. The report is returned as a dict (with one dict per iteration).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+void bind_weak_greedy(pybind11::module& m)
+{
+    namespace py = pybind11;
+
+    m.def(
+        "weak_greedy",
+        [](VectorArrayInterface<F>& basis, ssize_t training_set_size, const py::function& estimate_error,
+           const py::function& solve, const InnerProductInterface<F>& inner_product, ssize_t max_extensions,
+           double tolerance)
+        {
+            const auto report = weak_greedy(
+                basis, training_set_size,
+                [&](const VectorArrayInterface<F>& current_basis, ssize_t i)
+                {
+                    return estimate_error(py::cast(current_basis, py::return_value_policy::reference), i)
+                        .template cast<double>();
+                },
+                [&](ssize_t i)
+                {
+                    return solve(i).template cast<std::shared_ptr<VectorArrayInterface<F>>>();
+                },
+                inner_product, {.max_extensions = max_extensions, .tolerance = tolerance});
+            py::list iterations;
+            for (const auto& iteration : report.iterations)
+            {
+                py::dict entry;
+                entry["selected_index"] = iteration.selected_index;
+                entry["max_error"] = iteration.max_error;
+                entry["num_appended"] = iteration.num_appended;
+                entry["estimation_milliseconds"] = iteration.estimation_milliseconds;
+                entry["solve_milliseconds"] = iteration.solve_milliseconds;
+                entry["orthonormalization_milliseconds"] = iteration.orthonormalization_milliseconds;
+                iterations.append(entry);
+            }
+            py::dict ret;
+            ret["iterations"] = iterations;
+            ret["max_error"] = report.max_error;
+            ret["converged"] = report.converged;
+            return ret;
+        },
+        py::arg("basis"), py::arg("training_set_size"), py::arg("estimate_error"), py::arg("solve"),
+        py::arg("inner_product"), py::arg("max_extensions") = 100, py::arg("tolerance") = 0.);
+}
+
+/**
+ * \brief Binds deim and qdeim for scalar type F
+ *
+ * All scalar types are bound as overloads of the same Python functions. The result is returned as a dict
+ * with the interpolation dofs (as Indices) and the collateral basis. If \c num_threads is not 1, the GIL is
+ * released during the computation (see threadable_array).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+void bind_deim(pybind11::module& m)
+{
+    namespace py = pybind11;
+
+    for (const auto& [name, qr] : {std::pair{"deim", false}, {"qdeim", true}})
+    {
+        m.def(
+            name,
+            [qr](const std::shared_ptr<VectorArrayInterface<F>>& basis, std::optional<double> tolerance,
+                 ssize_t num_threads)
+            {
+                const DeimOptions options{.tolerance = tolerance, .num_threads = num_threads};
+                const auto threadable_basis = threadable_array(basis, num_threads);
+                DeimResult<F> result;
+                {
+                    std::optional<py::gil_scoped_release> release;
+                    if (num_threads != 1)
+                    {
+                        release.emplace();
+                    }
+                    result = qr ? qdeim(*threadable_basis, options) : deim(*threadable_basis, options);
+                }
+                py::dict ret;
+                ret["interpolation_dofs"] = result.interpolation_dofs;
+                ret["collateral_basis"] = result.collateral_basis;
+                return ret;
+            },
+            py::arg("basis"), py::arg("tolerance") = py::none(), py::arg("num_threads") = 1);
+    }
 }
 
 /**
@@ -312,7 +1286,7 @@ auto bind_cpp_gram_schmidt(pybind11::module& m, const std::string& field_type_na
  *
  * If \c pairwise is \c true, the form is applied to each pair of vectors in the arrays
  * and the result is a 1D array of the same length as the input arrays (which have to
- * have the same size in this case).
+ * have the same size in this case). The result is handed over to numpy without copying.
  * If \c pairwise is \c false, the form is applied to each vector in the first array with each vector
  * of the second array, and the result is a 2D array of shape <tt>(left.size(), right.size())</tt>.
  */
@@ -325,35 +1299,23 @@ pybind11::array_t<F> py_apply_inner_product(const InnerProductInterface<F>& self
 {
     if (pairwise)
     {
-        const auto ret = self.apply_pairwise(left, right, left_indices, right_indices);
-        // TODO: check if the following leads to a dangling pointer (does the array copy ret.data()?)
-        // return pybind11::array(ret.size(), ret.data());
-        // for now, copy the data explicitly
-        pybind11::array_t<F> ret_array({std::ssize(ret)});
-        auto ret_array_mutable = ret_array.mutable_unchecked();
-        for (ssize_t i = 0; i < std::ssize(ret); ++i)
+        auto ret = self.apply_pairwise(left, right, left_indices, right_indices);
+        const ssize_t n = left_indices ? left_indices->size(left.size()) : left.size();
+        if (std::ssize(ret) != n)
         {
-            ret_array_mutable(i) = ret[as_size_t(i)];
+            throw nias::InvalidStateError("Result has wrong size.");
         }
+        return as_numpy_array(std::move(ret));
     }
 
     const auto ret = self.apply(left, right, left_indices, right_indices);
     const ssize_t n = left_indices ? left_indices->size(left.size()) : left.size();
     const ssize_t m = right_indices ? right_indices->size(right.size()) : right.size();
-    if (std::ssize(ret) != n || (n > 0 && std::ssize(ret[0]) != m))
+    if (std::ssize(ret) != n)
     {
         throw nias::InvalidStateError("Result has wrong size.");
     }
-    pybind11::array_t<F> ret_array({n, m});
-    auto ret_array_mutable = ret_array.mutable_unchecked();
-    for (ssize_t i = 0; i < n; ++i)
-    {
-        for (ssize_t j = 0; j < m; ++j)
-        {
-            ret_array_mutable(i, j) = ret[as_size_t(i)][as_size_t(j)];
-        }
-    }
-    return ret_array;
+    return as_numpy_array(ret, m);
 }
 
 template <class F>
@@ -362,7 +1324,7 @@ auto bind_function_based_inner_product(pybind11::module& m, const std::string& f
 {
     namespace py = pybind11;
 
-    class PyInnerProductInterface : public InnerProductInterface<F>
+    class PyInnerProductInterface : public InnerProductInterface<F>, public PythonImplementation
     {
        public:
         using InterfaceType = InnerProductInterface<F>;
@@ -434,6 +1396,345 @@ auto bind_function_based_inner_product(pybind11::module& m, const std::string& f
     return ret;
 }
 
+/**
+ * \brief Binds WeightedEuclideanInnerProduct<F>
+ *
+ * The InnerProductInterface has to be bound before (see bind_function_based_inner_product). The weights are
+ * given as a one-dimensional numpy array.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_weighted_euclidean_inner_product(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using WeightedEuclideanInnerProd = WeightedEuclideanInnerProduct<F>;
+    using RealType = typename WeightedEuclideanInnerProd::RealType;
+    auto ret =
+        py::class_<WeightedEuclideanInnerProd, InnerProductInterface<F>,
+                   std::shared_ptr<WeightedEuclideanInnerProd>>(
+            m, (field_type_name + "WeightedEuclideanInnerProduct").c_str())
+            .def(py::init(
+                     [](const py::array_t<RealType, py::array::c_style | py::array::forcecast>& weights)
+                     {
+                         if (weights.ndim() != 1)
+                         {
+                             throw InvalidArgumentError(
+                                 "WeightedEuclideanInnerProduct: weights must be 1-dimensional");
+                         }
+                         return std::make_shared<WeightedEuclideanInnerProd>(
+                             std::vector<RealType>(weights.data(), weights.data() + weights.size()));
+                     }),
+                 py::arg("weights"))
+            .def("apply",
+                 [](const WeightedEuclideanInnerProd& self, const VectorArrayInterface<F>& left,
+                    const VectorArrayInterface<F>& right, bool pairwise,
+                    const std::optional<Indices>& left_indices, const std::optional<Indices>& right_indices)
+                 {
+                     return py_apply_inner_product<F>(self, left, right, pairwise, left_indices,
+                                                      right_indices);
+                 });
+    return ret;
+}
+
+/**
+ * \brief Binds OperatorInterface<F>, CsrMatrixOperator<F> and IdentityOperator<F>
+ *
+ * Operators can be implemented in Python by deriving from the interface. CsrMatrixOperators are created from
+ * the shape and the \c indptr, \c indices and \c data arrays of a scipy csr_matrix.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_operators(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    class PyOperatorInterface : public OperatorInterface<F>, public PythonImplementation
+    {
+       public:
+        using InterfaceType = OperatorInterface<F>;
+
+        /* Inherit the constructors */
+        using InterfaceType::InterfaceType;
+
+        [[nodiscard]] ssize_t source_dim() const override
+        {
+            PYBIND11_OVERRIDE_PURE(ssize_t,       /* Return type */
+                                   InterfaceType, /* Parent class */
+                                   source_dim,    /* Name of function in C++ */
+            );
+        }
+
+        [[nodiscard]] ssize_t range_dim() const override
+        {
+            PYBIND11_OVERRIDE_PURE(ssize_t,       /* Return type */
+                                   InterfaceType, /* Parent class */
+                                   range_dim,     /* Name of function in C++ */
+            );
+        }
+
+        [[nodiscard]] std::shared_ptr<VectorArrayInterface<F>> apply(
+            const VectorArrayInterface<F>& vec_array,
+            const std::optional<Indices>& indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE_PURE(std::shared_ptr<VectorArrayInterface<F>>, /* Return type */
+                                   InterfaceType,                            /* Parent class */
+                                   apply,                                    /* Name of function in C++ */
+                                   vec_array, indices                        /* Argument(s) */
+            );
+        }
+
+        [[nodiscard]] std::shared_ptr<VectorArrayInterface<F>> apply_adjoint(
+            const VectorArrayInterface<F>& vec_array,
+            const std::optional<Indices>& indices = std::nullopt) const override
+        {
+            PYBIND11_OVERRIDE_PURE(std::shared_ptr<VectorArrayInterface<F>>, /* Return type */
+                                   InterfaceType,                            /* Parent class */
+                                   apply_adjoint,                            /* Name of function in C++ */
+                                   vec_array, indices                        /* Argument(s) */
+            );
+        }
+    };
+
+    using OpInterface = OperatorInterface<F>;
+    py::class_<OpInterface, PyOperatorInterface, std::shared_ptr<OpInterface>>(
+        m, (field_type_name + "OperatorInterface").c_str())
+        .def(py::init<>())
+        .def_property_readonly("source_dim", &OpInterface::source_dim)
+        .def_property_readonly("range_dim", &OpInterface::range_dim)
+        .def("apply", &OpInterface::apply, py::arg("vec_array"), py::arg("indices") = py::none())
+        .def("apply_adjoint", &OpInterface::apply_adjoint, py::arg("vec_array"),
+             py::arg("indices") = py::none())
+        .def("apply2", &OpInterface::apply2, py::arg("left"), py::arg("right"),
+             py::arg("left_indices") = py::none(), py::arg("right_indices") = py::none());
+
+    using CsrMatrixOp = CsrMatrixOperator<F>;
+    using IndexArray = py::array_t<ssize_t, py::array::c_style | py::array::forcecast>;
+    py::class_<CsrMatrixOp, OpInterface, std::shared_ptr<CsrMatrixOp>>(
+        m, (field_type_name + "CsrMatrixOperator").c_str())
+        .def(py::init(
+                 [](const std::pair<ssize_t, ssize_t>& shape, const IndexArray& indptr,
+                    const IndexArray& indices,
+                    const py::array_t<F, py::array::c_style | py::array::forcecast>& data,
+                    ssize_t num_threads)
+                 {
+                     return std::make_shared<CsrMatrixOp>(
+                         shape.first, shape.second, csr_array_to_vector(indptr),
+                         csr_array_to_vector(indices), csr_array_to_vector(data), num_threads);
+                 }),
+             py::arg("shape"), py::arg("indptr"), py::arg("indices"), py::arg("data"),
+             py::arg("num_threads") = 1)
+        .def_property_readonly("nnz", &CsrMatrixOp::nnz)
+        .def_property_readonly("num_threads", &CsrMatrixOp::num_threads);
+
+    using IdentityOp = IdentityOperator<F>;
+    auto ret = py::class_<IdentityOp, OpInterface, std::shared_ptr<IdentityOp>>(
+                   m, (field_type_name + "IdentityOperator").c_str())
+                   .def(py::init<ssize_t>(), py::arg("dim"));
+    return ret;
+}
+
+/**
+ * \brief Binds GalerkinProjector<F> and project_vectors
+ *
+ * The reduced matrices are returned as lists of numpy arrays which take over the buffers (no copies).
+ * If \c num_threads is not 1, the GIL is released during the projection, but not during the conversion to
+ * numpy (see threadable_array). The basis of the projector is then a copy of \c basis unless \c basis is a
+ * MappedNpyVectorArray.
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_galerkin_projector(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    const auto to_numpy = [](std::vector<ReducedMatrix<F>>&& matrices)
+    {
+        py::list ret;
+        for (auto& matrix : matrices)
+        {
+            ret.append(as_numpy_array(std::move(matrix)));
+        }
+        return ret;
+    };
+    m.def(
+        "project_vectors",
+        [to_numpy](const std::shared_ptr<VectorArrayInterface<F>>& left_basis,
+                   const std::vector<std::shared_ptr<VectorArrayInterface<F>>>& vectors, ssize_t num_threads)
+        {
+            const auto threadable_left_basis = threadable_array(left_basis, num_threads);
+            std::vector<std::shared_ptr<const VectorArrayInterface<F>>> threadable_vectors;
+            for (const auto& vec_array : vectors)
+            {
+                threadable_vectors.push_back(threadable_array(vec_array, num_threads));
+            }
+            std::vector<ReducedMatrix<F>> result;
+            {
+                std::optional<py::gil_scoped_release> release;
+                if (num_threads != 1)
+                {
+                    release.emplace();
+                }
+                result =
+                    project_vectors(*threadable_left_basis, threadable_vectors, {.num_threads = num_threads});
+            }
+            return to_numpy(std::move(result));
+        },
+        py::arg("left_basis"), py::arg("vectors"), py::arg("num_threads") = 1);
+
+    using Projector = GalerkinProjector<F>;
+    using OperatorList = std::vector<std::shared_ptr<OperatorInterface<F>>>;
+    auto ret =
+        py::class_<Projector, std::shared_ptr<Projector>>(m, (field_type_name + "GalerkinProjector").c_str())
+            .def(py::init(
+                     [](const OperatorList& operators, const std::shared_ptr<VectorArrayInterface<F>>& basis,
+                        ssize_t num_threads, ssize_t block_size)
+                     {
+                         for (const auto& op : operators)
+                         {
+                             check_threadable(*op, num_threads);
+                         }
+                         auto threadable_basis = threadable_array(basis, num_threads);
+                         // the constructor applies the operators to the basis
+                         std::optional<py::gil_scoped_release> release;
+                         if (num_threads != 1)
+                         {
+                             release.emplace();
+                         }
+                         return std::make_shared<Projector>(
+                             std::vector<std::shared_ptr<const OperatorInterface<F>>>(operators.begin(),
+                                                                                      operators.end()),
+                             std::move(threadable_basis),
+                             ProjectionOptions{.num_threads = num_threads, .block_size = block_size});
+                     }),
+                 py::arg("operators"), py::arg("basis"), py::arg("num_threads") = 1,
+                 py::arg("block_size") = 32)
+            .def_property_readonly("num_operators", &Projector::num_operators)
+            .def(
+                "project",
+                [to_numpy](const Projector& self, const std::shared_ptr<VectorArrayInterface<F>>& left_basis)
+                {
+                    const auto num_threads = self.options().num_threads;
+                    const auto threadable_left_basis =
+                        left_basis ? threadable_array(left_basis, num_threads) : nullptr;
+                    std::vector<ReducedMatrix<F>> result;
+                    {
+                        std::optional<py::gil_scoped_release> release;
+                        if (num_threads != 1)
+                        {
+                            release.emplace();
+                        }
+                        result =
+                            threadable_left_basis ? self.project(*threadable_left_basis) : self.project();
+                    }
+                    return to_numpy(std::move(result));
+                },
+                py::arg("left_basis") = py::none());
+    return ret;
+}
+
+/**
+ * \brief Binds GramCache<F>
+ *
+ * Writes to numpy arrays which share their memory with a vector array are not detected by the cache, call
+ * invalidate after such writes. If \c num_threads is not 1, the GIL is released while the matrix is updated.
+ * The cache has to track the given array, so it cannot be copied as in threadable_array and has to be a
+ * MappedNpyVectorArray in this case. Inner products implemented in Python are rejected (see
+ * check_threadable).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_gram_cache(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using Cache = GramCache<F>;
+    const auto update = [](Cache& self)
+    {
+        std::optional<py::gil_scoped_release> release;
+        if (self.num_threads() != 1)
+        {
+            release.emplace();
+        }
+        self.update();
+    };
+    auto ret =
+        py::class_<Cache, std::shared_ptr<Cache>>(m, (field_type_name + "GramCache").c_str())
+            .def(py::init(
+                     [](std::shared_ptr<VectorArrayInterface<F>> vec_array,
+                        std::shared_ptr<InnerProductInterface<F>> inner_product, ssize_t num_threads)
+                     {
+                         if (num_threads != 1 &&
+                             dynamic_cast<const MappedNpyVectorArray<F>*>(vec_array.get()) == nullptr)
+                         {
+                             throw InvalidArgumentError(
+                                 "GramCache: num_threads != 1 requires a MappedNpyVectorArray");
+                         }
+                         if (inner_product == nullptr)
+                         {
+                             return std::make_shared<Cache>(std::move(vec_array),
+                                                            std::make_shared<EuclideanInnerProduct<F>>(),
+                                                            num_threads);
+                         }
+                         check_threadable(*inner_product, num_threads);
+                         return std::make_shared<Cache>(std::move(vec_array), std::move(inner_product),
+                                                        num_threads);
+                     }),
+                 py::arg("vec_array"), py::arg("inner_product") = py::none(), py::arg("num_threads") = 1)
+            .def(
+                "gram_matrix",
+                [update](Cache& self)
+                {
+                    update(self);
+                    const auto& matrix = self.gram_matrix();
+                    return as_numpy_array(matrix, std::ssize(matrix));
+                })
+            .def("update", update)
+            .def(
+                "delete_vectors",
+                [update](Cache& self, const std::optional<Indices>& indices)
+                {
+                    update(self);
+                    self.delete_vectors(indices);
+                },
+                py::arg("indices"))
+            .def("invalidate", &Cache::invalidate)
+            .def_property_readonly("num_threads", &Cache::num_threads)
+            .def_property_readonly("num_full_updates", &Cache::num_full_updates)
+            .def_property_readonly("num_incremental_updates", &Cache::num_incremental_updates);
+    return ret;
+}
+
+/**
+ * \brief Binds OperatorBasedInnerProduct<F>
+ *
+ * The InnerProductInterface and the OperatorInterface have to be bound before (see
+ * bind_function_based_inner_product and bind_operators).
+ */
+template <class F>
+    requires std::floating_point<F> || std::is_same_v<F, std::complex<typename F::value_type>>
+auto bind_operator_based_inner_product(pybind11::module& m, const std::string& field_type_name)
+{
+    namespace py = pybind11;
+
+    using OperatorBasedInnerProd = OperatorBasedInnerProduct<F>;
+    auto ret =
+        py::class_<OperatorBasedInnerProd, InnerProductInterface<F>, std::shared_ptr<OperatorBasedInnerProd>>(
+            m, (field_type_name + "OperatorBasedInnerProduct").c_str())
+            .def(py::init<std::shared_ptr<const OperatorInterface<F>>>(), py::arg("operator"))
+            .def("cache_right_array", &OperatorBasedInnerProd::cache_right_array, py::arg("right"))
+            .def("clear_cache", &OperatorBasedInnerProd::clear_cache)
+            .def("apply",
+                 [](const OperatorBasedInnerProd& self, const VectorArrayInterface<F>& left,
+                    const VectorArrayInterface<F>& right, bool pairwise,
+                    const std::optional<Indices>& left_indices, const std::optional<Indices>& right_indices)
+                 {
+                     return py_apply_inner_product<F>(self, left, right, pairwise, left_indices,
+                                                      right_indices);
+                 });
+    return ret;
+}
+
 
 }  // namespace nias
 
@@ -0,0 +1,279 @@
+#ifndef NIAS_CPP_ALGORITHMS_DEIM_H
+#define NIAS_CPP_ALGORITHMS_DEIM_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/// Options for deim and qdeim
+struct DeimOptions
+{
+    /**
+     * \brief Relative tolerance for detecting linearly dependent basis vectors
+     *
+     * deim skips a basis vector if the largest absolute entry of its interpolation residual is at most
+     * \c tolerance times its norm. qdeim throws if the norm of the next pivot is at most \c tolerance times
+     * the norm of the first pivot. Defaults to 100 times the machine epsilon of the real type.
+     */
+    std::optional<double> tolerance = std::nullopt;
+    /**
+     * \brief Number of threads (0 means all hardware threads)
+     *
+     * If more than one thread is used, the vector arrays have to support concurrent calls of \c dofs and
+     * \c axpy on different copies without the GIL. This is the case for the C++ implementations in nias-cpp
+     * except NumpyVectorArray (whose copies are numpy arrays), but not for implementations in Python.
+     */
+    ssize_t num_threads = 1;
+};
+
+/// Result of deim and qdeim
+template <floating_point_or_complex F>
+struct DeimResult
+{
+    /// Selected entries, in the order in which they have been selected
+    Indices interpolation_dofs;
+    /// Basis of the interpolation space (one vector per interpolation dof)
+    std::shared_ptr<VectorArrayInterface<F>> collateral_basis;
+};
+
+/// Tolerance given in the options or the default tolerance for the scalar type F
+template <floating_point_or_complex F>
+[[nodiscard]] real_type_t<F> deim_tolerance(const DeimOptions& options)
+{
+    using RealType = real_type_t<F>;
+    const auto ret = options.tolerance ? RealType(*options.tolerance)
+                                       : std::numeric_limits<RealType>::epsilon() * RealType(100);
+    if (!(ret >= 0))
+    {
+        throw InvalidArgumentError("deim: tolerance must be non-negative");
+    }
+    return ret;
+}
+
+/// Returns the indices <tt>first, ..., last - 1</tt>
+inline std::vector<ssize_t> index_range(ssize_t first, ssize_t last)
+{
+    std::vector<ssize_t> ret(as_size_t(std::max(last - first, ssize_t(0))));
+    std::iota(ret.begin(), ret.end(), first);
+    return ret;
+}
+
+/**
+ * \brief Discrete empirical interpolation method (DEIM)
+ *
+ * Selects one interpolation dof per basis vector: the position of the largest absolute entry of the
+ * residual of the interpolation of the vector at the previously selected dofs. The residuals are computed
+ * by Gaussian elimination on a copy of \c basis, so only bulk VectorArray operations (\c amax, \c axpy) and
+ * one \c dofs call per step are used. The copy is split into blocks of vectors which are updated by up to
+ * \c num_threads threads (each thread only touches its own block).
+ *
+ * Basis vectors whose residual is (numerically) zero, i.e., which are linearly dependent on the previous
+ * ones, are skipped and not part of the collateral basis.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] DeimResult<F> deim(const VectorArrayInterface<F>& basis, const DeimOptions& options = {})
+{
+    const auto num_threads = effective_num_threads(options.num_threads);
+    const auto tolerance = deim_tolerance<F>(options);
+    if (basis.dim() == 0)
+    {
+        throw InvalidArgumentError("deim: basis vectors must not be empty");
+    }
+    const auto size = basis.size();
+    const auto norms = basis.norm();
+    const ssize_t block_size = std::max(ssize_t(1), (size + num_threads - 1) / num_threads);
+    const ssize_t num_blocks = (size + block_size - 1) / block_size;
+    std::vector<std::shared_ptr<VectorArrayInterface<F>>> residuals;
+    for (ssize_t block = 0; block < num_blocks; ++block)
+    {
+        residuals.push_back(
+            basis.copy(index_range(block * block_size, std::min((block + 1) * block_size, size))));
+    }
+    std::vector<ssize_t> dofs;
+    std::vector<ssize_t> selected;
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        const auto pivot_block = i / block_size;
+        const auto pivot_index = i % block_size;
+        const auto [positions, values] = residuals[as_size_t(pivot_block)]->amax(pivot_index);
+        if (!(values[0] > tolerance * norms[as_size_t(i)]))
+        {
+            continue;
+        }
+        const auto dof = positions[0];
+        dofs.push_back(dof);
+        selected.push_back(i);
+        const auto pivot = residuals[as_size_t(pivot_block)]->copy(pivot_index);
+        const F pivot_value = pivot->get(0, dof);
+        // eliminate the entry at dof from all following residuals
+        parallel_for(
+            pivot_block, num_blocks,
+            [&](ssize_t block)
+            {
+                auto& residual = *residuals[as_size_t(block)];
+                const auto indices = index_range(block == pivot_block ? pivot_index + 1 : 0, residual.size());
+                if (indices.empty())
+                {
+                    return;
+                }
+                const auto entries = residual.dofs({dof}, indices);
+                std::vector<F> alpha;
+                alpha.reserve(entries.size());
+                for (const auto& row : entries)
+                {
+                    alpha.push_back(-row[0] / pivot_value);
+                }
+                residual.axpy(alpha, *pivot, indices);
+            },
+            num_threads);
+    }
+    return {.interpolation_dofs = Indices(dofs), .collateral_basis = basis.copy(selected)};
+}
+
+/**
+ * \brief Q-DEIM: interpolation dofs from a QR decomposition with column pivoting of the transposed basis
+ *
+ * The interpolation dofs are the first <tt>basis.size()</tt> column pivots of the matrix whose rows are
+ * the basis vectors, which gives better error bounds than deim. The entries of \c basis are copied once
+ * (dof-wise, using \c dofs), afterwards each step projects all remaining columns and selects the one with
+ * the largest norm in a single pass over contiguous memory. The dofs are split into blocks which are
+ * processed by up to \c num_threads threads. The collateral basis is a copy of \c basis.
+ *
+ * \throws InvalidArgumentError if the basis vectors are (numerically) linearly dependent
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] DeimResult<F> qdeim(const VectorArrayInterface<F>& basis, const DeimOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    constexpr ssize_t dofs_per_block = 256;
+    const auto num_threads = effective_num_threads(options.num_threads);
+    const auto tolerance = deim_tolerance<F>(options);
+    const auto size = basis.size();
+    const auto dim = basis.dim();
+    if (size > dim)
+    {
+        throw InvalidArgumentError("qdeim: basis has more vectors than entries");
+    }
+    const auto m = as_size_t(size);
+    const ssize_t num_dof_blocks = (dim + dofs_per_block - 1) / dofs_per_block;
+    // the entries of all basis vectors at dof j are stored contiguously, starting at columns[j * m]
+    std::vector<F> columns(m * as_size_t(dim));
+    std::vector<bool> is_selected(as_size_t(dim), false);
+    // largest squared norm (and its dof) of the unselected columns in each block
+    std::vector<std::pair<RealType, ssize_t>> block_maxima(as_size_t(num_dof_blocks));
+    std::vector<F> q(m);
+    const auto process_block = [&](ssize_t block, bool project)
+    {
+        const auto first = block * dofs_per_block;
+        const auto last = std::min(first + dofs_per_block, dim);
+        auto& block_max = block_maxima[as_size_t(block)];
+        block_max = {RealType(-1), -1};
+        for (ssize_t j = first; j < last; ++j)
+        {
+            if (is_selected[as_size_t(j)])
+            {
+                continue;
+            }
+            auto* column = columns.data() + (as_size_t(j) * m);
+            if (project)
+            {
+                F projection(0);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    projection += conj_if_complex(q[i]) * column[i];
+                }
+                for (size_t i = 0; i < m; ++i)
+                {
+                    column[i] -= projection * q[i];
+                }
+            }
+            RealType norm2(0);
+            for (size_t i = 0; i < m; ++i)
+            {
+                norm2 += std::norm(column[i]);
+            }
+            if (norm2 > block_max.first)
+            {
+                block_max = {norm2, j};
+            }
+        }
+    };
+    parallel_for(
+        0, num_dof_blocks,
+        [&](ssize_t block)
+        {
+            const auto first = block * dofs_per_block;
+            const auto dof_indices = index_range(first, std::min(first + dofs_per_block, dim));
+            const auto entries = basis.dofs(dof_indices);
+            for (size_t i = 0; i < m; ++i)
+            {
+                for (size_t j = 0; j < dof_indices.size(); ++j)
+                {
+                    columns[(as_size_t(dof_indices[j]) * m) + i] = entries[i][j];
+                }
+            }
+            process_block(block, false);
+        },
+        num_threads);
+    std::vector<ssize_t> dofs;
+    RealType first_pivot_norm(0);
+    for (ssize_t k = 0; k < size; ++k)
+    {
+        // (the first block with the largest norm wins, so the result does not depend on the threads)
+        const auto [max_norm2, dof] = *std::ranges::max_element(block_maxima,
+                                                                [](const auto& a, const auto& b)
+                                                                {
+                                                                    return a.first < b.first;
+                                                                });
+        const auto pivot_norm = std::sqrt(std::max(max_norm2, RealType(0)));
+        if (k == 0)
+        {
+            first_pivot_norm = pivot_norm;
+        }
+        if (!(pivot_norm > 0) || (k > 0 && !(pivot_norm > tolerance * first_pivot_norm)))
+        {
+            throw InvalidArgumentError("qdeim: the basis vectors are linearly dependent");
+        }
+        dofs.push_back(dof);
+        is_selected[as_size_t(dof)] = true;
+        const auto* pivot_column = columns.data() + (as_size_t(dof) * m);
+        for (size_t i = 0; i < m; ++i)
+        {
+            q[i] = pivot_column[i] / pivot_norm;
+        }
+        if (k + 1 < size)
+        {
+            parallel_for(
+                0, num_dof_blocks,
+                [&](ssize_t block)
+                {
+                    process_block(block, true);
+                },
+                num_threads);
+        }
+    }
+    return {.interpolation_dofs = Indices(dofs), .collateral_basis = basis.copy()};
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_DEIM_H
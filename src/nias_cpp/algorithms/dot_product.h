@@ -43,6 +43,9 @@ F dot_product(const VectorInterface<F>& lhs, const VectorInterface<F>& rhs)
 
 /**
  * \brief Component-wise Euclidean dot product of two vector arrays
+ *
+ * Delegates to \c pairwise_inner, so vector arrays can provide an optimized implementation (e.g., one
+ * accumulating in a higher precision than the entries are stored in).
 */
 template <floating_point_or_complex F>
 std::vector<F> dot_product(const VectorArrayInterface<F>& lhs, const VectorArrayInterface<F>& rhs,
@@ -57,22 +60,7 @@ std::vector<F> dot_product(const VectorArrayInterface<F>& lhs, const VectorArray
     {
         throw std::invalid_argument("lhs and rhs must have the same size and dimension");
     }
-    std::vector<F> ret(as_size_t(lhs.size()), F(0.));
-    for (ssize_t i = 0; i < lhs.size(); ++i)
-    {
-        for (ssize_t k = 0; k < lhs.dim(); ++k)
-        {
-            if constexpr (complex<F>)
-            {
-                ret[as_size_t(i)] += std::conj(lhs.get(i, k)) * rhs.get(i, k);
-            }
-            else
-            {
-                ret[as_size_t(i)] += lhs.get(i, k) * rhs.get(i, k);
-            }
-        }
-    }
-    return ret;
+    return lhs.pairwise_inner(rhs);
 }
 
 
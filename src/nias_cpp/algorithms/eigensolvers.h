@@ -0,0 +1,494 @@
+#ifndef NIAS_CPP_ALGORITHMS_EIGENSOLVERS_H
+#define NIAS_CPP_ALGORITHMS_EIGENSOLVERS_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \file
+ * \brief Eigensolvers for a few extreme eigenpairs of self-adjoint operators
+ *
+ * The operator \c A has to be self-adjoint with respect to the given inner product, i.e.,
+ * <tt>(u, A v) = (A u, v)</tt> (e.g., a symmetric matrix with the Euclidean inner product, or
+ * <tt>M^{-1} K</tt> for symmetric \c K with the inner product given by \c M). The computed eigenvectors are
+ * orthonormal with respect to the inner product.
+ *
+ * Both solvers use Rayleigh-Ritz steps: the Gram matrix <tt>(v_i, A v_j)</tt> of a basis of the search space
+ * is computed by (blocks of) InnerProductInterface::apply calls (parallel_gram_matrix) and its eigenpairs are
+ * computed by the dense Jacobi method (hermitian_eigenpairs). The bases are orthonormalized by
+ * orthonormalize. parallel_gram_matrix and orthonormalize are defined in gram_schmidt_cpp.h.
+ */
+
+/// Which eigenvalues the eigensolvers compute
+enum class EigenvalueSelection
+{
+    smallest,
+    largest
+};
+
+/// Options for the eigensolvers lobpcg and lanczos
+struct EigensolverOptions
+{
+    ssize_t num_eigenvalues = 1;
+    EigenvalueSelection which = EigenvalueSelection::smallest;
+    /**
+     * \brief An eigenpair has converged if its residual norm is at most this fraction of the largest
+     * absolute value of the computed eigenvalues
+     */
+    double tolerance = 1e-8;
+    /// Maximal number of iterations (lobpcg) or restarts (lanczos)
+    ssize_t max_iterations = 1000;
+    /// Maximal dimension of the Krylov space in lanczos, 0 means <tt>max(2 * num_eigenvalues + 1, 20)</tt>
+    ssize_t krylov_dim = 0;
+    /**
+     * \brief Number of threads used for the Gram matrices (0 means all hardware threads)
+     *
+     * If more than one thread is used, the inner product and the vector arrays have to support concurrent
+     * calls of their const methods without the GIL. This is the case for the C++ implementations in
+     * nias-cpp except NumpyVectorArray (which creates numpy arrays), but not for implementations in Python.
+     */
+    ssize_t num_threads = 1;
+};
+
+/// Result of the eigensolvers
+template <floating_point_or_complex F>
+struct EigensolverResult
+{
+    /// The computed eigenvalues, in ascending order for \c smallest and in descending order for \c largest
+    std::vector<real_type_t<F>> eigenvalues;
+    std::shared_ptr<VectorArrayInterface<F>> eigenvectors;
+    /// Residual norms (relative to the largest absolute value of the eigenvalues)
+    std::vector<double> residual_norms;
+    ssize_t num_iterations = 0;
+    bool converged = false;
+};
+
+/**
+ * \brief Eigenvalues (in ascending order) and eigenvectors of a small dense Hermitian matrix (given as a
+ * vector of rows) computed by the cyclic Jacobi method
+ *
+ * The i-th entry of the returned eigenvectors is the (normalized) eigenvector for the i-th eigenvalue, so
+ * the eigenvectors can directly be used as coefficients for VectorArrayInterface::lincomb.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::pair<std::vector<real_type_t<F>>, std::vector<std::vector<F>>> hermitian_eigenpairs(
+    std::vector<std::vector<F>> a)
+{
+    using RealType = real_type_t<F>;
+    constexpr ssize_t max_sweeps = 100;
+    const auto n = a.size();
+    // v[k][i] is entry k of the i-th eigenvector
+    std::vector<std::vector<F>> v(n, std::vector<F>(n, F(0)));
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i][i] = F(1);
+    }
+    for (ssize_t sweep = 0; sweep < max_sweeps; ++sweep)
+    {
+        RealType off_diagonal(0);
+        RealType total(0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                (i == j ? total : off_diagonal) += RealType(std::norm(a[i][j]));
+            }
+        }
+        total += off_diagonal;
+        const auto epsilon = std::numeric_limits<RealType>::epsilon();
+        if (!(off_diagonal > epsilon * epsilon * total))
+        {
+            break;
+        }
+        for (size_t p = 0; p < n; ++p)
+        {
+            for (size_t q = p + 1; q < n; ++q)
+            {
+                const RealType b = std::abs(a[p][q]);
+                if (b == 0)
+                {
+                    continue;
+                }
+                // unitary rotation J with J_pp = J_qq = c, J_pq = s u, J_qp = -s conj(u) such that
+                // (J^H A J)_pq = 0
+                const F u = a[p][q] / b;
+                const RealType tau = (std::real(a[q][q]) - std::real(a[p][p])) / (2 * b);
+                const RealType t = (tau >= 0 ? RealType(1) : RealType(-1)) /
+                                   (std::abs(tau) + std::sqrt(1 + (tau * tau)));
+                const RealType c = 1 / std::sqrt(1 + (t * t));
+                const RealType s = t * c;
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const F a_kp = a[k][p];
+                    a[k][p] = (c * a_kp) - (s * conj_if_complex(u) * a[k][q]);
+                    a[k][q] = (s * u * a_kp) + (c * a[k][q]);
+                    const F v_kp = v[k][p];
+                    v[k][p] = (c * v_kp) - (s * conj_if_complex(u) * v[k][q]);
+                    v[k][q] = (s * u * v_kp) + (c * v[k][q]);
+                }
+                for (size_t k = 0; k < n; ++k)
+                {
+                    const F a_pk = a[p][k];
+                    a[p][k] = (c * a_pk) - (s * u * a[q][k]);
+                    a[q][k] = (s * conj_if_complex(u) * a_pk) + (c * a[q][k]);
+                }
+                a[p][q] = F(0);
+                a[q][p] = F(0);
+            }
+        }
+    }
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::ranges::sort(order,
+                      [&](size_t i, size_t j)
+                      {
+                          return std::real(a[i][i]) < std::real(a[j][j]);
+                      });
+    std::pair<std::vector<RealType>, std::vector<std::vector<F>>> ret;
+    for (const auto i : order)
+    {
+        ret.first.push_back(std::real(a[i][i]));
+        auto& eigenvector = ret.second.emplace_back(n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            eigenvector[k] = v[k][i];
+        }
+    }
+    return ret;
+}
+
+/// Checks the arguments of the eigensolvers (\c name is used in error messages)
+template <floating_point_or_complex F>
+void check_eigensolver_arguments(const std::string& name, const OperatorInterface<F>& op,
+                                 const VectorArrayInterface<F>& initial_vectors,
+                                 const EigensolverOptions& options)
+{
+    if (op.source_dim() != op.range_dim() || initial_vectors.dim() != op.source_dim())
+    {
+        throw InvalidArgumentError(name + ": operator must be square and match the initial vectors");
+    }
+    if (options.num_eigenvalues <= 0 || options.num_eigenvalues > op.source_dim() || options.tolerance < 0 ||
+        options.max_iterations < 0 || options.krylov_dim < 0)
+    {
+        throw InvalidArgumentError(name + ": invalid options");
+    }
+    static_cast<void>(effective_num_threads(options.num_threads));
+}
+
+/**
+ * \brief The \c count wanted eigenpairs of a Rayleigh-Ritz step (see hermitian_eigenpairs), in ascending
+ * order for \c smallest and in descending order for \c largest
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::pair<std::vector<real_type_t<F>>, std::vector<std::vector<F>>> wanted_ritz_pairs(
+    std::pair<std::vector<real_type_t<F>>, std::vector<std::vector<F>>> eigenpairs, ssize_t count,
+    EigenvalueSelection which)
+{
+    auto& [values, vectors] = eigenpairs;
+    if (which == EigenvalueSelection::largest)
+    {
+        std::ranges::reverse(values);
+        std::ranges::reverse(vectors);
+    }
+    values.resize(as_size_t(count));
+    vectors.resize(as_size_t(count));
+    return eigenpairs;
+}
+
+/// Largest absolute value of the first \c count \c values (or 1 if they are all zero)
+template <std::floating_point RealType>
+[[nodiscard]] double eigenvalue_scale(const std::vector<RealType>& values, ssize_t count)
+{
+    double ret = 0.;
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        ret = std::max(ret, double(std::abs(values[as_size_t(i)])));
+    }
+    return ret > 0 ? ret : 1.;
+}
+
+/// Hermitian part <tt>(H + H^H) / 2</tt> of the square matrix \c h
+template <floating_point_or_complex F>
+[[nodiscard]] std::vector<std::vector<F>> hermitian_part(const std::vector<std::vector<F>>& h)
+{
+    auto ret = h;
+    for (size_t i = 0; i < h.size(); ++i)
+    {
+        for (size_t j = 0; j < h.size(); ++j)
+        {
+            ret[i][j] = (h[i][j] + conj_if_complex(h[j][i])) / real_type_t<F>(2);
+        }
+    }
+    return ret;
+}
+
+/**
+ * \brief Locally optimal block preconditioned conjugate gradient method (without preconditioner)
+ *
+ * Computes the \c num_eigenvalues smallest or largest eigenvalues and eigenvectors of \c op, starting with
+ * the vectors \c initial_guess (at least \c num_eigenvalues linearly independent vectors, the block size is
+ * the number of these vectors). In each iteration, the Rayleigh-Ritz step uses the space spanned by the
+ * current approximations, the residuals of the unconverged approximations (soft locking) and the previous
+ * search directions. The operator is only applied to the new search directions.
+ */
+template <floating_point_or_complex F>
+EigensolverResult<F> lobpcg(const OperatorInterface<F>& op, const VectorArrayInterface<F>& initial_guess,
+                            const InnerProductInterface<F>& inner_product,
+                            const EigensolverOptions& options = {})
+{
+    using VectorArrayType = VectorArrayInterface<F>;
+    check_eigensolver_arguments("lobpcg", op, initial_guess, options);
+    const auto num_eigenvalues = options.num_eigenvalues;
+    const auto block_size = initial_guess.size();
+    const auto num_threads = options.num_threads;
+    auto x = initial_guess.copy();
+    orthonormalize<F>(inner_product, nullptr, *x, num_threads);
+    if (x->size() < std::max(num_eigenvalues, block_size))
+    {
+        throw InvalidArgumentError("lobpcg: initial vectors must be linearly independent and at least "
+                                   "num_eigenvalues many");
+    }
+    auto ax = op.apply(*x);
+    auto [theta, coefficients] = wanted_ritz_pairs(
+        hermitian_eigenpairs(hermitian_part(parallel_gram_matrix(inner_product, *x, *ax, num_threads))),
+        block_size, options.which);
+    x = x->lincomb(coefficients);
+    ax = ax->lincomb(coefficients);
+    std::shared_ptr<VectorArrayType> directions;
+    EigensolverResult<F> result;
+    while (true)
+    {
+        // residuals A x - theta x
+        const auto residual = x->copy();
+        std::vector<F> scaling;
+        for (const auto value : theta)
+        {
+            scaling.push_back(F(-value));
+        }
+        residual->scal(scaling);
+        residual->axpy(F(1), *ax);
+        const auto residual_norms2 = inner_product.apply_pairwise(*residual, *residual);
+        const double scale = eigenvalue_scale(theta, num_eigenvalues);
+        std::vector<ssize_t> active;
+        result.residual_norms.clear();
+        for (ssize_t i = 0; i < block_size; ++i)
+        {
+            const double residual_norm = std::sqrt(double(std::real(residual_norms2[as_size_t(i)]))) / scale;
+            if (i < num_eigenvalues)
+            {
+                result.residual_norms.push_back(residual_norm);
+            }
+            if (!(residual_norm <= options.tolerance))
+            {
+                active.push_back(i);
+            }
+        }
+        result.converged = active.empty() || active.front() >= num_eigenvalues;
+        if (result.converged || result.num_iterations >= options.max_iterations)
+        {
+            break;
+        }
+        ++result.num_iterations;
+        // new search directions: residuals and previous directions, orthonormalized against x
+        auto search_space = residual->copy(Indices(active));
+        if (directions != nullptr)
+        {
+            search_space->append(*directions);
+        }
+        orthonormalize(inner_product, x.get(), *search_space, num_threads);
+        if (search_space->size() == 0)
+        {
+            break;
+        }
+        const auto a_search_space = op.apply(*search_space);
+        const auto basis = x->copy();
+        basis->append(*search_space);
+        const auto a_basis = ax->copy();
+        a_basis->append(*a_search_space);
+        std::tie(theta, coefficients) = wanted_ritz_pairs(
+            hermitian_eigenpairs(
+                hermitian_part(parallel_gram_matrix(inner_product, *basis, *a_basis, num_threads))),
+            block_size, options.which);
+        x = basis->lincomb(coefficients);
+        ax = a_basis->lincomb(coefficients);
+        // the next directions are the parts of the new approximations in the search space
+        std::vector<std::vector<F>> direction_coefficients;
+        for (const auto& c : coefficients)
+        {
+            direction_coefficients.emplace_back(c.begin() + block_size, c.end());
+        }
+        directions = search_space->lincomb(direction_coefficients);
+    }
+    result.eigenvalues.assign(theta.begin(), theta.begin() + num_eigenvalues);
+    std::vector<ssize_t> wanted(as_size_t(num_eigenvalues));
+    std::iota(wanted.begin(), wanted.end(), ssize_t(0));
+    result.eigenvectors = x->copy(Indices(wanted));
+    return result;
+}
+
+/**
+ * \brief Thick-restart Lanczos method
+ *
+ * Computes the \c num_eigenvalues smallest or largest eigenvalues and eigenvectors of \c op, starting with
+ * the first vector of \c initial_vector. The Krylov basis is extended up to \c krylov_dim vectors (with full
+ * reorthogonalization by block projections), then the Rayleigh-Ritz step is performed and, if the wanted
+ * Ritz pairs have not converged yet, the method is restarted with the best Ritz vectors (about half of the
+ * basis) and the last Krylov vector (Wu and Simon), so the projected matrix stays available without
+ * applying the operator to the Ritz vectors again.
+ *
+ * \throws InvalidStateError if the Krylov space becomes invariant before it contains \c num_eigenvalues
+ * vectors.
+ */
+template <floating_point_or_complex F>
+EigensolverResult<F> lanczos(const OperatorInterface<F>& op, const VectorArrayInterface<F>& initial_vector,
+                             const InnerProductInterface<F>& inner_product,
+                             const EigensolverOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    check_eigensolver_arguments("lanczos", op, initial_vector, options);
+    const auto num_eigenvalues = options.num_eigenvalues;
+    const auto num_threads = options.num_threads;
+    const auto max_dim = options.krylov_dim > 0
+                             ? options.krylov_dim
+                             : std::min(op.source_dim(), std::max(2 * num_eigenvalues + 1, ssize_t(20)));
+    if (initial_vector.size() == 0 || max_dim > op.source_dim() ||
+        (max_dim <= num_eigenvalues && max_dim < op.source_dim()))
+    {
+        throw InvalidArgumentError("lanczos: invalid initial vector or Krylov space dimension");
+    }
+    const auto norm = [&](const VectorArrayInterface<F>& vec_array)
+    {
+        return std::sqrt(std::real(inner_product.apply_pairwise(vec_array, vec_array, Indices{0}).at(0)));
+    };
+    auto basis = initial_vector.copy(Indices{0});
+    const RealType initial_norm = norm(*basis);
+    if (!(initial_norm > 0))
+    {
+        throw InvalidArgumentError("lanczos: initial vector must not be zero");
+    }
+    basis->scal(F(1 / initial_norm));
+    // upper triangle of the projected matrix (the lower triangle is given by symmetry)
+    std::vector<std::vector<F>> projected(as_size_t(max_dim), std::vector<F>(as_size_t(max_dim), F(0)));
+    ssize_t start = 0;
+    EigensolverResult<F> result;
+    while (true)
+    {
+        ssize_t dim = max_dim;
+        RealType beta(0);
+        for (ssize_t j = start; j < max_dim; ++j)
+        {
+            // w = A v_j (as a copy of v_j, so all basis vectors have the same type)
+            auto w = basis->copy(Indices{j});
+            w->scal(F(0));
+            w->axpy(F(1), *op.apply(*basis, Indices{j}));
+            const RealType image_norm = norm(*w);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                const auto gram = parallel_gram_matrix(inner_product, *basis, *w, num_threads);
+                std::vector<std::vector<F>> coefficients(1);
+                for (size_t i = 0; i < gram.size(); ++i)
+                {
+                    coefficients[0].push_back(gram[i][0]);
+                    projected[i][as_size_t(j)] += gram[i][0];
+                }
+                w->axpy(F(-1), *basis->lincomb(coefficients));
+            }
+            beta = norm(*w);
+            if (!(beta > 100 * std::numeric_limits<RealType>::epsilon() * image_norm))
+            {
+                // the Krylov space is invariant, so the Ritz pairs are exact
+                dim = j + 1;
+                beta = RealType(0);
+                break;
+            }
+            w->scal(F(1 / beta));
+            basis->append(*w);
+        }
+        if (dim < num_eigenvalues)
+        {
+            throw InvalidStateError("lanczos: Krylov space is invariant and too small");
+        }
+        std::vector<std::vector<F>> h(as_size_t(dim), std::vector<F>(as_size_t(dim)));
+        for (size_t i = 0; i < h.size(); ++i)
+        {
+            for (size_t j = i; j < h.size(); ++j)
+            {
+                h[i][j] = projected[i][j];
+                h[j][i] = conj_if_complex(projected[i][j]);
+            }
+        }
+        const auto num_kept = std::clamp((num_eigenvalues + max_dim) / 2, num_eigenvalues,
+                                         std::max(num_eigenvalues, max_dim - 1));
+        auto [theta, ritz_vectors] = wanted_ritz_pairs(hermitian_eigenpairs(hermitian_part(h)),
+                                                       std::min(num_kept, dim), options.which);
+        // the residual norm of a Ritz pair is beta times the absolute value of the last entry of the vector
+        const double scale = eigenvalue_scale(theta, num_eigenvalues);
+        result.residual_norms.clear();
+        for (ssize_t i = 0; i < num_eigenvalues; ++i)
+        {
+            const auto last_entry = ritz_vectors[as_size_t(i)].back();
+            result.residual_norms.push_back(double(beta * std::abs(last_entry)) / scale);
+        }
+        ++result.num_iterations;
+        result.converged = std::ranges::all_of(result.residual_norms,
+                                               [&](double residual_norm)
+                                               {
+                                                   return residual_norm <= options.tolerance;
+                                               });
+        // the coefficients refer to the first dim basis vectors (the basis may contain one more vector)
+        for (auto& coefficients : ritz_vectors)
+        {
+            coefficients.resize(as_size_t(basis->size()), F(0));
+        }
+        if (result.converged || result.num_iterations >= options.max_iterations)
+        {
+            result.eigenvalues.assign(theta.begin(), theta.begin() + num_eigenvalues);
+            ritz_vectors.resize(as_size_t(num_eigenvalues));
+            result.eigenvectors = basis->lincomb(ritz_vectors);
+            break;
+        }
+        // thick restart: A Y = Y Theta + beta v e^T S, so the new projected matrix is diagonal in the first
+        // num_kept rows and columns, the next column is computed by the projections of A v
+        const auto next = basis->copy(Indices{dim});
+        basis = basis->lincomb(ritz_vectors);
+        basis->append(*next);
+        for (auto& row : projected)
+        {
+            std::ranges::fill(row, F(0));
+        }
+        for (size_t i = 0; i < theta.size(); ++i)
+        {
+            projected[i][i] = F(theta[i]);
+        }
+        start = std::ssize(theta);
+    }
+    return result;
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_EIGENSOLVERS_H
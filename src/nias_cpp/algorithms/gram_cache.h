@@ -0,0 +1,210 @@
+#ifndef NIAS_CPP_ALGORITHMS_GRAM_CACHE_H
+#define NIAS_CPP_ALGORITHMS_GRAM_CACHE_H
+
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Gram matrix <tt>inner_product.apply(U, U)</tt> of a vector array \c U which is kept up to date
+ * incrementally
+ *
+ * The cache compares the version (see VectorArrayInterface::version) and the size of \c U with the ones at
+ * the last update. If vectors have only been appended, just the columns of the new vectors are computed
+ * (<tt>O(n k dim)</tt> for \c k new vectors instead of <tt>O(n^2 dim)</tt>), the new rows are their
+ * conjugates, so the inner product has to be Hermitian. Vectors deleted through delete_vectors are
+ * removed from the matrix without computing anything. All other changes of \c U (modifications and
+ * deletions which do not go through the cache) lead to a full recomputation.
+ *
+ * Changes through non-const accessors (e.g., the non-const \c vector or \c mutable_data) are counted by
+ * the array when the accessor is called, not when the data is written. Writes through references or
+ * pointers which have been obtained before the last update are thus not detected, and calling such an
+ * accessor without writing still leads to a full recomputation. Changes which bypass the VectorArray
+ * interface (e.g., writes to a numpy array which shares its memory with a NumpyVectorArray) cannot be
+ * detected either. Call invalidate after such changes. The cache is not thread-safe.
+ */
+template <floating_point_or_complex F>
+class GramCache
+{
+   public:
+    using VectorArrayType = VectorArrayInterface<F>;
+    using InnerProductType = InnerProductInterface<F>;
+
+    explicit GramCache(
+        std::shared_ptr<VectorArrayType> vec_array,
+        std::shared_ptr<const InnerProductType> inner_product = std::make_shared<EuclideanInnerProduct<F>>(),
+        ssize_t num_threads = 1)
+        : vec_array_(std::move(vec_array))
+        , inner_product_(std::move(inner_product))
+        , num_threads_(num_threads)
+    {
+        if (vec_array_ == nullptr || inner_product_ == nullptr)
+        {
+            throw InvalidArgumentError("GramCache: vector array and inner product must not be null");
+        }
+        static_cast<void>(effective_num_threads(num_threads_));
+    }
+
+    [[nodiscard]] const VectorArrayType& vec_array() const
+    {
+        return *vec_array_;
+    }
+
+    [[nodiscard]] const InnerProductType& inner_product() const
+    {
+        return *inner_product_;
+    }
+
+    [[nodiscard]] ssize_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    /// Updates the cache if the array has changed and returns the Gram matrix (as a vector of rows)
+    [[nodiscard]] const std::vector<std::vector<F>>& gram_matrix()
+    {
+        update();
+        return gram_;
+    }
+
+    /// Brings the cached matrix up to date with the array
+    void update()
+    {
+        const auto version = vec_array_->version();
+        const auto size = vec_array_->size();
+        const auto cached_size = std::ssize(gram_);
+        if (valid_ && version == version_ && size == cached_size)
+        {
+            return;
+        }
+        if (!valid_ || version.deletions != version_.deletions ||
+            version.modifications != version_.modifications || size < cached_size)
+        {
+            gram_ = parallel_gram_matrix(*inner_product_, *vec_array_, *vec_array_, num_threads_);
+            ++num_full_updates_;
+        }
+        else if (size > cached_size)
+        {
+            extend(cached_size, size);
+            ++num_incremental_updates_;
+        }
+        version_ = version;
+        valid_ = true;
+    }
+
+    /**
+     * \brief Deletes the vectors with the given indices from the array and the corresponding rows and
+     * columns from the cached matrix
+     *
+     * Like VectorArrayInterface::delete_vectors, \c std::nullopt deletes all vectors.
+     */
+    void delete_vectors(const std::optional<Indices>& indices)
+    {
+        update();
+        const auto size = vec_array_->size();
+        std::vector<bool> keep(as_size_t(size), indices.has_value());
+        if (indices)
+        {
+            indices->check_valid(size);
+            for (const auto index : indices->as_vec(size))
+            {
+                keep[as_size_t(index)] = false;
+            }
+        }
+        vec_array_->delete_vectors(indices);
+        std::vector<std::vector<F>> remaining;
+        for (size_t i = 0; i < keep.size(); ++i)
+        {
+            if (!keep[i])
+            {
+                continue;
+            }
+            auto& row = remaining.emplace_back();
+            for (size_t j = 0; j < keep.size(); ++j)
+            {
+                if (keep[j])
+                {
+                    row.push_back(gram_[i][j]);
+                }
+            }
+        }
+        gram_ = std::move(remaining);
+        version_ = vec_array_->version();
+    }
+
+    /// Discards the cached matrix, the next update recomputes it from scratch
+    void invalidate()
+    {
+        valid_ = false;
+        gram_.clear();
+    }
+
+    /// Number of updates which recomputed the whole matrix
+    [[nodiscard]] ssize_t num_full_updates() const
+    {
+        return num_full_updates_;
+    }
+
+    /// Number of updates which only computed the entries of appended vectors
+    [[nodiscard]] ssize_t num_incremental_updates() const
+    {
+        return num_incremental_updates_;
+    }
+
+   private:
+    // appends the rows and columns of the vectors old_size, ..., new_size - 1
+    void extend(ssize_t old_size, ssize_t new_size)
+    {
+        std::vector<ssize_t> new_indices(as_size_t(new_size - old_size));
+        std::iota(new_indices.begin(), new_indices.end(), old_size);
+        // columns[i][j] = (u_i, u_{old_size + j})
+        const auto columns = parallel_gram_matrix(*inner_product_, *vec_array_, *vec_array_, num_threads_,
+                                                  Indices(new_indices));
+        for (size_t i = 0; i < as_size_t(old_size); ++i)
+        {
+            gram_[i].insert(gram_[i].end(), columns[i].begin(), columns[i].end());
+        }
+        for (size_t i = as_size_t(old_size); i < as_size_t(new_size); ++i)
+        {
+            auto& row = gram_.emplace_back(as_size_t(new_size));
+            for (size_t j = 0; j < as_size_t(old_size); ++j)
+            {
+                row[j] = conj_if_complex(columns[j][i - as_size_t(old_size)]);
+            }
+            std::ranges::copy(columns[i], row.begin() + old_size);
+        }
+    }
+
+    std::shared_ptr<VectorArrayType> vec_array_;
+    std::shared_ptr<const InnerProductType> inner_product_;
+    ssize_t num_threads_;
+    std::vector<std::vector<F>> gram_;
+    VectorArrayVersion version_;
+    bool valid_ = false;
+    ssize_t num_full_updates_ = 0;
+    ssize_t num_incremental_updates_ = 0;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_GRAM_CACHE_H
@@ -1,19 +1,18 @@
 #ifndef NIAS_CPP_ALGORITHMS_GRAM_SCHMIDT_H
 #define NIAS_CPP_ALGORITHMS_GRAM_SCHMIDT_H
 
-#include <limits>
 #include <memory>
-#include <vector>
 
-#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>  // IWYU pragma: export
 #include <nias_cpp/concepts.h>
 #include <nias_cpp/inner_products/euclidean.h>
 #include <nias_cpp/interfaces/inner_products.h>
 #include <nias_cpp/interfaces/vectorarray.h>
-#include <nias_cpp/interpreter.h>
+#include <nias_cpp/python_bridge.h>
 #include <nias_cpp/type_traits.h>
 #include <nias_cpp/vectorarray/list.h>
 #include <pybind11/cast.h>
+#include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
@@ -29,6 +28,12 @@ namespace nias
  * resulting orthogonalized vectors are stored in a new ListVectorArray, the
  * original array is not modified.
  *
+ * The function acquires the GIL itself, so it can be called from any thread. If it is called from
+ * several threads, the thread which holds the GIL (after ensure_interpreter_and_venv_are_active, the
+ * thread which started the interpreter) must not wait for them without releasing the GIL, e.g., by
+ * creating the PythonExecutor or using <tt>pybind11::gil_scoped_release</tt>. Otherwise, the calls
+ * deadlock.
+ *
  * \returns A new ListVectorArray containing the orthogonalized vectors.
  */
 template <floating_point_or_complex F, class... Args>
@@ -37,19 +42,15 @@ std::shared_ptr<ListVectorArray<F>> gram_schmidt(
     const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>(),
     Args&&... additional_python_args)
 {
-    ensure_interpreter_and_venv_are_active();
-
-    // import nias_cpp_bindings module
+    // get the classes we need from the Python nias module (resolved only once)
     namespace py = pybind11;
-    const py::module_ nias_cpp_module = py::module::import("nias_cpp_bindings");
-
-    // get the classes we need from the Python nias module
-    const py::module_ nias_cpp_vectorarray = py::module::import("nias.bindings.nias_cpp.vectorarray");
-    auto NiasVecArrayImpl = nias_cpp_vectorarray.attr("NiasCppVectorArrayImpl");
-    auto NiasVecArray = nias_cpp_vectorarray.attr("NiasCppVectorArray");
-    auto NiasInnerProductWrapper =
-        py::module::import("nias.bindings.nias_cpp.product").attr("NiasCppInnerProduct");
-    auto NiasGramSchmidt = py::module::import("nias.linalg.gram_schmidt").attr("gram_schmidt");
+    const auto& bridge = PythonBridge::instance();
+    // this function may be called from any thread (e.g., from the PythonExecutor), see above
+    const py::gil_scoped_acquire gil;
+    const auto& NiasVecArrayImpl = bridge.nias_vector_array_impl();
+    const auto& NiasVecArray = bridge.nias_vector_array();
+    const auto& NiasInnerProductWrapper = bridge.nias_inner_product();
+    const auto& NiasGramSchmidt = bridge.nias_gram_schmidt();
 
     // create a Python VectorArray
     using namespace pybind11::literals;  // for the _a literal
@@ -70,26 +71,22 @@ std::shared_ptr<ListVectorArray<F>> gram_schmidt(
  *
  * Performs Gram-Schmidt orthogonalization on a ListVectorArray by calling the
  * Gram-Schmidt orthogonalization algorithm from the NiAS Python module. Directly
- * modifies the input ListVectorArray in-place.
+ * modifies the input ListVectorArray in-place. See gram_schmidt for calls from several threads.
  */
 template <floating_point_or_complex F, class... Args>
 void gram_schmidt_in_place(ListVectorArray<F>& vec_array,
                            const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>(),
                            Args&&... additional_python_args)
 {
-    ensure_interpreter_and_venv_are_active();
-
-    // import nias_cpp module
+    // get the classes we need from the Python nias module (resolved only once)
     namespace py = pybind11;
-    const py::module_ nias_cpp_module = py::module::import("nias_cpp_bindings");
-
-    // get the classes we need from the Python nias module
-    const py::module_ nias_cpp_vectorarray = py::module::import("nias.bindings.nias_cpp.vectorarray");
-    auto NiasVecArrayImpl = nias_cpp_vectorarray.attr("NiasCppVectorArrayImpl");
-    auto NiasVecArray = nias_cpp_vectorarray.attr("NiasCppVectorArray");
-    auto NiasCppInnerProduct =
-        py::module::import("nias.bindings.nias_cpp.product").attr("NiasCppInnerProduct");
-    auto NiasGramSchmidt = py::module::import("nias.linalg.gram_schmidt").attr("gram_schmidt");
+    const auto& bridge = PythonBridge::instance();
+    // this function may be called from any thread (e.g., from the PythonExecutor), see above
+    const py::gil_scoped_acquire gil;
+    const auto& NiasVecArrayImpl = bridge.nias_vector_array_impl();
+    const auto& NiasVecArray = bridge.nias_vector_array();
+    const auto& NiasCppInnerProduct = bridge.nias_inner_product();
+    const auto& NiasGramSchmidt = bridge.nias_gram_schmidt();
 
     // create a Python VectorArray
     using namespace pybind11::literals;  // for the _a literal
@@ -102,48 +99,6 @@ void gram_schmidt_in_place(ListVectorArray<F>& vec_array,
                     std::forward<Args>(additional_python_args)...);
 }
 
-/**
- * \brief Simple C++ implementation of the Gram-Schmidt orthogonalization algorithm
- */
-template <floating_point_or_complex F>
-void gram_schmidt_cpp(VectorArrayInterface<F>& vec_array,
-                      const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>())
-{
-    constexpr F atol = std::numeric_limits<F>::epsilon() * F(10);
-    std::vector<bool> remove(as_size_t(vec_array.size()), false);
-    for (ssize_t i = 0; i < vec_array.size(); ++i)
-    {
-        for (ssize_t j = 0; j < i; j++)
-        {
-            if (remove[as_size_t(j)])
-            {
-                continue;
-            }
-            F projection = inner_product.apply_pairwise(vec_array, vec_array, {i}, {j}).at(0) /
-                           inner_product.apply_pairwise(vec_array, vec_array, {j}, {j}).at(0);
-            vec_array.axpy(-projection, vec_array, {i}, {j});
-        }
-        const auto norm2 = inner_product.apply_pairwise(vec_array, vec_array, {i}, {i}).at(0);
-        if (norm2 < atol)
-        {
-            remove[as_size_t(i)] = true;
-        }
-        else
-        {
-            vec_array.scal(F(1.) / std::sqrt(norm2), {i});
-        }
-    }
-    std::vector<ssize_t> indices_to_remove;
-    for (ssize_t i = 0; i < vec_array.size(); ++i)
-    {
-        if (remove[as_size_t(i)])
-        {
-            indices_to_remove.push_back(i);
-        }
-    }
-    vec_array.delete_vectors(indices_to_remove);
-}
-
 
 }  // namespace nias
 
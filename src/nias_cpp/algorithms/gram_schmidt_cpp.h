@@ -0,0 +1,147 @@
+#ifndef NIAS_CPP_ALGORITHMS_GRAM_SCHMIDT_CPP_H
+#define NIAS_CPP_ALGORITHMS_GRAM_SCHMIDT_CPP_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Simple C++ implementation of the Gram-Schmidt orthogonalization algorithm
+ *
+ * Vectors whose squared norm drops below 10 times the machine epsilon during the orthogonalization are
+ * removed.
+ */
+template <floating_point_or_complex F>
+void gram_schmidt_cpp(VectorArrayInterface<F>& vec_array,
+                      const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>())
+{
+    using RealType = real_type_t<F>;
+    constexpr RealType atol = std::numeric_limits<RealType>::epsilon() * RealType(10);
+    std::vector<bool> remove(as_size_t(vec_array.size()), false);
+    for (ssize_t i = 0; i < vec_array.size(); ++i)
+    {
+        for (ssize_t j = 0; j < i; j++)
+        {
+            if (remove[as_size_t(j)])
+            {
+                continue;
+            }
+            F projection = inner_product.apply_pairwise(vec_array, vec_array, {j}, {i}).at(0) /
+                           inner_product.apply_pairwise(vec_array, vec_array, {j}, {j}).at(0);
+            vec_array.axpy(-projection, vec_array, {i}, {j});
+        }
+        const RealType norm2 = std::real(inner_product.apply_pairwise(vec_array, vec_array, {i}, {i}).at(0));
+        if (norm2 < atol)
+        {
+            remove[as_size_t(i)] = true;
+        }
+        else
+        {
+            vec_array.scal(F(1 / std::sqrt(norm2)), {i});
+        }
+    }
+    std::vector<ssize_t> indices_to_remove;
+    for (ssize_t i = 0; i < vec_array.size(); ++i)
+    {
+        if (remove[as_size_t(i)])
+        {
+            indices_to_remove.push_back(i);
+        }
+    }
+    vec_array.delete_vectors(indices_to_remove);
+}
+
+/**
+ * \brief Gram matrix <tt>inner_product.apply(left, right, std::nullopt, right_indices)</tt> computed by
+ * \c num_threads threads
+ *
+ * The rows of the Gram matrix are split into blocks which are computed by separate \c apply calls.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::vector<std::vector<F>> parallel_gram_matrix(
+    const InnerProductInterface<F>& inner_product, const VectorArrayInterface<F>& left,
+    const VectorArrayInterface<F>& right, ssize_t num_threads,
+    const std::optional<Indices>& right_indices = std::nullopt)
+{
+    constexpr ssize_t rows_per_block = 4;
+    const auto num_rows = left.size();
+    if (effective_num_threads(num_threads) == 1 || num_rows <= rows_per_block)
+    {
+        return inner_product.apply(left, right, std::nullopt, right_indices);
+    }
+    std::vector<std::vector<F>> ret(as_size_t(num_rows));
+    parallel_for(
+        0, (num_rows + rows_per_block - 1) / rows_per_block,
+        [&](ssize_t block)
+        {
+            const auto first_row = block * rows_per_block;
+            std::vector<ssize_t> rows(as_size_t(std::min(rows_per_block, num_rows - first_row)));
+            std::iota(rows.begin(), rows.end(), first_row);
+            auto block_rows = inner_product.apply(left, right, Indices(rows), right_indices);
+            std::ranges::move(block_rows, ret.begin() + first_row);
+        },
+        num_threads);
+    return ret;
+}
+
+/**
+ * \brief Orthonormalizes \c vec_array with respect to \c inner_product, first against the orthonormal
+ * vectors \c basis (if given) and then among itself
+ *
+ * Uses two passes (block projection against \c basis, normalization and gram_schmidt_cpp), vectors in the
+ * span of the previous vectors are removed.
+ */
+template <floating_point_or_complex F>
+void orthonormalize(const InnerProductInterface<F>& inner_product, const VectorArrayInterface<F>* basis,
+                    VectorArrayInterface<F>& vec_array, ssize_t num_threads)
+{
+    for (int pass = 0; pass < 2 && vec_array.size() > 0; ++pass)
+    {
+        if (basis != nullptr && basis->size() > 0)
+        {
+            const auto gram = parallel_gram_matrix(inner_product, *basis, vec_array, num_threads);
+            std::vector<std::vector<F>> coefficients(as_size_t(vec_array.size()),
+                                                     std::vector<F>(as_size_t(basis->size())));
+            for (size_t i = 0; i < gram.size(); ++i)
+            {
+                for (size_t j = 0; j < coefficients.size(); ++j)
+                {
+                    coefficients[j][i] = gram[i][j];
+                }
+            }
+            vec_array.axpy(F(-1), *basis->lincomb(coefficients));
+        }
+        // normalize first, so the (absolute) removal tolerance of gram_schmidt_cpp becomes a relative one
+        const auto norms2 = inner_product.apply_pairwise(vec_array, vec_array);
+        std::vector<F> scaling;
+        for (const auto& norm2 : norms2)
+        {
+            const auto norm = std::sqrt(std::real(norm2));
+            scaling.push_back(norm > 0 ? F(1 / norm) : F(1));
+        }
+        vec_array.scal(scaling);
+        gram_schmidt_cpp(vec_array, inner_product);
+    }
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_GRAM_SCHMIDT_CPP_H
@@ -0,0 +1,620 @@
+#ifndef NIAS_CPP_ALGORITHMS_KRYLOV_H
+#define NIAS_CPP_ALGORITHMS_KRYLOV_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \file
+ * \brief Krylov solvers for <tt>A X = B</tt> with many right-hand sides
+ *
+ * All solvers work on whole vector arrays: in each iteration, the operator is applied once to the search
+ * directions of all right-hand sides that have not converged yet (see OperatorInterface::apply), and the
+ * scalar products and updates are computed by one \c pairwise_inner, \c axpy or \c lincomb call per step
+ * instead of one call per right-hand side. cg, minres and gmres use separate Krylov spaces (and scalars)
+ * for each right-hand side, block_cg uses the common block Krylov space of all right-hand sides.
+ *
+ * There are no block variants of minres and gmres: block Lanczos and block Arnoldi processes need
+ * deflation of (numerically) linearly dependent basis vectors, and the small projected problems become
+ * banded or block Hessenberg least squares problems. Since the multi-RHS variants already do all vector
+ * operations in bulk, they are used for indefinite and non-Hermitian operators instead.
+ *
+ * The solution array contains the initial guesses and is overwritten with the approximate solutions.
+ */
+
+/// Options for the Krylov solvers cg, block_cg, minres and gmres
+struct KrylovOptions
+{
+    /// A right-hand side has converged if its residual norm is at most this fraction of its norm
+    double tolerance = 1e-10;
+    /// Maximal number of iterations (i.e., of operator applications to the unconverged search directions)
+    ssize_t max_iterations = 1000;
+    /// Number of GMRES iterations between restarts
+    ssize_t restart = 30;
+};
+
+/// Result of the Krylov solvers
+struct KrylovResult
+{
+    ssize_t num_iterations = 0;
+    /// Residual norms (relative to the norms of the right-hand sides) as estimated by the solver
+    std::vector<double> residual_norms;
+    /// Whether all right-hand sides have converged
+    bool converged = false;
+    /// Whether block_cg continued with cg since its search directions became linearly dependent
+    bool block_breakdown = false;
+};
+
+/**
+ * \brief Solves <tt>A X = B</tt> for small dense matrices (given as vectors of rows) by a Cholesky
+ * factorization of the Hermitian matrix \c A
+ *
+ * Returns \c std::nullopt if \c A is not (numerically) positive definite, i.e., if a pivot is not larger
+ * than \c relative_tolerance times the largest diagonal entry.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::optional<std::vector<std::vector<F>>> solve_hermitian_positive_definite(
+    const std::vector<std::vector<F>>& a, const std::vector<std::vector<F>>& b, double relative_tolerance)
+{
+    using RealType = real_type_t<F>;
+    const auto size = a.size();
+    RealType max_diagonal(0);
+    for (size_t i = 0; i < size; ++i)
+    {
+        max_diagonal = std::max(max_diagonal, RealType(std::abs(a[i][i])));
+    }
+    // lower triangular factor L with A = L L^H
+    std::vector<std::vector<F>> l(size, std::vector<F>(size, F(0)));
+    for (size_t j = 0; j < size; ++j)
+    {
+        RealType pivot = std::real(a[j][j]);
+        for (size_t k = 0; k < j; ++k)
+        {
+            pivot -= RealType(std::norm(l[j][k]));
+        }
+        if (!(pivot > relative_tolerance * max_diagonal))
+        {
+            return std::nullopt;
+        }
+        l[j][j] = F(std::sqrt(pivot));
+        for (size_t i = j + 1; i < size; ++i)
+        {
+            F value = a[i][j];
+            for (size_t k = 0; k < j; ++k)
+            {
+                value -= l[i][k] * conj_if_complex(l[j][k]);
+            }
+            l[i][j] = value / l[j][j];
+        }
+    }
+    auto x = b;
+    const size_t num_columns = size == 0 ? 0 : b[0].size();
+    for (size_t col = 0; col < num_columns; ++col)
+    {
+        // forward substitution with L, then backward substitution with L^H
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t k = 0; k < i; ++k)
+            {
+                x[i][col] -= l[i][k] * x[k][col];
+            }
+            x[i][col] /= l[i][i];
+        }
+        for (size_t i = size; i-- > 0;)
+        {
+            for (size_t k = i + 1; k < size; ++k)
+            {
+                x[i][col] -= conj_if_complex(l[k][i]) * x[k][col];
+            }
+            x[i][col] /= l[i][i];
+        }
+    }
+    return x;
+}
+
+/// Checks the arguments of the Krylov solvers (\c name is used in error messages)
+template <floating_point_or_complex F>
+void check_krylov_arguments(const std::string& name, const OperatorInterface<F>& op,
+                            const VectorArrayInterface<F>& rhs, const VectorArrayInterface<F>& solution,
+                            const KrylovOptions& options)
+{
+    if (op.source_dim() != op.range_dim())
+    {
+        throw InvalidArgumentError(name + ": operator must be square");
+    }
+    if (rhs.dim() != op.range_dim() || solution.dim() != op.source_dim() || solution.size() != rhs.size())
+    {
+        throw InvalidArgumentError(name + ": right-hand sides and solutions do not match the operator");
+    }
+    if (options.tolerance < 0 || options.max_iterations < 0 || options.restart <= 0)
+    {
+        throw InvalidArgumentError(name + ": invalid options");
+    }
+}
+
+/// Norms of the right-hand sides (zero right-hand sides use absolute tolerances instead of relative ones)
+template <floating_point_or_complex F>
+[[nodiscard]] std::vector<double> krylov_scales(const VectorArrayInterface<F>& rhs)
+{
+    std::vector<double> ret;
+    for (const auto norm : rhs.norm())
+    {
+        ret.push_back(norm > 0 ? double(norm) : 1.);
+    }
+    return ret;
+}
+
+/**
+ * \brief Stores the relative residual norms in \c result and returns the indices of the right-hand sides
+ * that have not converged
+ *
+ * \c residual_norms[i] is the (absolute) residual norm of right-hand side \c i.
+ */
+template <std::floating_point RealType>
+[[nodiscard]] std::vector<ssize_t> unconverged_indices(const std::vector<RealType>& residual_norms,
+                                                       const std::vector<double>& scales,
+                                                       const KrylovOptions& options, KrylovResult& result)
+{
+    std::vector<ssize_t> ret;
+    result.residual_norms.resize(residual_norms.size());
+    for (size_t i = 0; i < residual_norms.size(); ++i)
+    {
+        result.residual_norms[i] = double(residual_norms[i]) / scales[i];
+        // (the negated comparison also keeps right-hand sides with NaN residuals)
+        if (!(result.residual_norms[i] <= options.tolerance))
+        {
+            ret.push_back(as_ssize_t(i));
+        }
+    }
+    return ret;
+}
+
+/// Square roots of the squared norms \c norms2 (as doubles by default)
+template <std::floating_point ResultType = double, std::floating_point RealType>
+[[nodiscard]] std::vector<ResultType> sqrt_of(const std::vector<RealType>& norms2)
+{
+    std::vector<ResultType> ret;
+    for (const auto value : norms2)
+    {
+        ret.push_back(std::sqrt(ResultType(value)));
+    }
+    return ret;
+}
+
+/**
+ * \brief Conjugate gradient method for Hermitian positive definite operators
+ *
+ * Each right-hand side is solved by its own CG iteration, but all of them are advanced together: per
+ * iteration, the operator is applied once to the search directions of all unconverged right-hand sides.
+ *
+ * \throws InvalidStateError if the operator turns out not to be positive definite.
+ */
+template <floating_point_or_complex F>
+KrylovResult cg(const OperatorInterface<F>& op, const VectorArrayInterface<F>& rhs,
+                VectorArrayInterface<F>& solution, const KrylovOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    check_krylov_arguments("cg", op, rhs, solution, options);
+    const auto scales = krylov_scales(rhs);
+    KrylovResult result;
+    const auto residual = rhs.copy();
+    residual->axpy(F(-1), *op.apply(solution));
+    const auto directions = residual->copy();
+    auto residual_norms2 = residual->norm2();
+    auto active = unconverged_indices(sqrt_of(residual_norms2), scales, options, result);
+    while (!active.empty() && result.num_iterations < options.max_iterations)
+    {
+        const Indices active_indices(active);
+        const auto image = op.apply(*directions, active_indices);
+        const auto curvatures = directions->pairwise_inner(*image, active_indices);
+        std::vector<F> alpha(active.size());
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            const RealType curvature = std::real(curvatures[i]);
+            if (!(curvature > 0))
+            {
+                throw InvalidStateError("cg: operator is not positive definite");
+            }
+            alpha[i] = F(residual_norms2[as_size_t(active[i])] / curvature);
+        }
+        solution.axpy(alpha, *directions, active_indices, active_indices);
+        std::ranges::transform(alpha, alpha.begin(), std::negate<>());
+        residual->axpy(alpha, *image, active_indices);
+        const auto new_residual_norms2 = residual->norm2(active_indices);
+        std::vector<F> beta(active.size());
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            auto& residual_norm2 = residual_norms2[as_size_t(active[i])];
+            beta[i] = F(new_residual_norms2[i] / residual_norm2);
+            residual_norm2 = new_residual_norms2[i];
+        }
+        directions->scal(beta, active_indices);
+        directions->axpy(F(1), *residual, active_indices, active_indices);
+        ++result.num_iterations;
+        active = unconverged_indices(sqrt_of(residual_norms2), scales, options, result);
+    }
+    result.converged = active.empty();
+    return result;
+}
+
+/**
+ * \brief Block conjugate gradient method for Hermitian positive definite operators
+ *
+ * Searches the solutions for all right-hand sides in the common block Krylov space (O'Leary's block CG),
+ * which usually needs fewer iterations than cg if the right-hand sides are related. Each iteration applies
+ * the operator to all search directions and computes two Gram matrices (\c inner) and three linear
+ * combinations (\c lincomb).
+ *
+ * If the search directions become (numerically) linearly dependent, e.g., because some right-hand sides
+ * converge much earlier than others, the remaining iterations are done by cg (\c block_breakdown is set
+ * in the result).
+ */
+template <floating_point_or_complex F>
+KrylovResult block_cg(const OperatorInterface<F>& op, const VectorArrayInterface<F>& rhs,
+                      VectorArrayInterface<F>& solution, const KrylovOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    check_krylov_arguments("block_cg", op, rhs, solution, options);
+    constexpr double breakdown_tolerance = 100 * std::numeric_limits<RealType>::epsilon();
+    const auto scales = krylov_scales(rhs);
+    // the coefficients of lincomb are the transposed coefficient matrices
+    const auto transposed = [](const std::vector<std::vector<F>>& matrix)
+    {
+        std::vector<std::vector<F>> ret(matrix.empty() ? 0 : matrix[0].size(), std::vector<F>(matrix.size()));
+        for (size_t i = 0; i < matrix.size(); ++i)
+        {
+            for (size_t j = 0; j < matrix[i].size(); ++j)
+            {
+                ret[j][i] = matrix[i][j];
+            }
+        }
+        return ret;
+    };
+    const auto diagonal_norms = [](const std::vector<std::vector<F>>& gram)
+    {
+        std::vector<double> ret;
+        for (size_t i = 0; i < gram.size(); ++i)
+        {
+            ret.push_back(std::sqrt(std::max(double(std::real(gram[i][i])), 0.)));
+        }
+        return ret;
+    };
+    KrylovResult result;
+    const auto residual = rhs.copy();
+    residual->axpy(F(-1), *op.apply(solution));
+    auto directions = residual->copy();
+    auto residual_gram = residual->inner(*residual);
+    auto active = unconverged_indices(diagonal_norms(residual_gram), scales, options, result);
+    while (!active.empty() && result.num_iterations < options.max_iterations)
+    {
+        const auto image = op.apply(*directions);
+        const auto alpha = solve_hermitian_positive_definite(directions->inner(*image), residual_gram,
+                                                             breakdown_tolerance);
+        if (!alpha)
+        {
+            result.block_breakdown = true;
+            break;
+        }
+        solution.axpy(F(1), *directions->lincomb(transposed(*alpha)));
+        residual->axpy(F(-1), *image->lincomb(transposed(*alpha)));
+        auto new_residual_gram = residual->inner(*residual);
+        ++result.num_iterations;
+        active = unconverged_indices(diagonal_norms(new_residual_gram), scales, options, result);
+        if (active.empty())
+        {
+            break;
+        }
+        const auto beta =
+            solve_hermitian_positive_definite(residual_gram, new_residual_gram, breakdown_tolerance);
+        if (!beta)
+        {
+            result.block_breakdown = true;
+            break;
+        }
+        const auto new_directions = directions->lincomb(transposed(*beta));
+        new_directions->axpy(F(1), *residual);
+        directions = new_directions;
+        residual_gram = std::move(new_residual_gram);
+    }
+    if (result.block_breakdown)
+    {
+        auto cg_options = options;
+        cg_options.max_iterations = options.max_iterations - result.num_iterations;
+        const auto cg_result = cg(op, rhs, solution, cg_options);
+        result.num_iterations += cg_result.num_iterations;
+        result.residual_norms = cg_result.residual_norms;
+        result.converged = cg_result.converged;
+        return result;
+    }
+    result.converged = active.empty();
+    return result;
+}
+
+/**
+ * \brief MINRES method for Hermitian (possibly indefinite) operators
+ *
+ * Each right-hand side is solved by its own Lanczos process (following Paige and Saunders), but all of
+ * them are advanced together: per iteration, the operator is applied once to the Lanczos vectors of all
+ * unconverged right-hand sides, and the recurrences are bulk \c axpy and \c pairwise_inner calls.
+ */
+template <floating_point_or_complex F>
+KrylovResult minres(const OperatorInterface<F>& op, const VectorArrayInterface<F>& rhs,
+                    VectorArrayInterface<F>& solution, const KrylovOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    check_krylov_arguments("minres", op, rhs, solution, options);
+    const auto scales = krylov_scales(rhs);
+    const auto size = as_size_t(rhs.size());
+    KrylovResult result;
+    auto r2 = rhs.copy();
+    r2->axpy(F(-1), *op.apply(solution));
+    auto r1 = r2->copy();
+    auto y = r2->copy();
+    const auto v = r2->copy();
+    auto w = r2->copy();
+    w->scal(F(0));
+    auto w1 = w->copy();
+    auto w2 = w->copy();
+    // scalars of the Lanczos process and of the QR factorization of the tridiagonal matrices
+    auto beta = sqrt_of<RealType>(r2->norm2());
+    auto phibar = beta;
+    std::vector<RealType> old_beta(size, RealType(0));
+    std::vector<RealType> dbar(size, RealType(0));
+    std::vector<RealType> epsilon(size, RealType(0));
+    std::vector<RealType> cs(size, RealType(-1));
+    std::vector<RealType> sn(size, RealType(0));
+    auto active = unconverged_indices(phibar, scales, options, result);
+    while (!active.empty() && result.num_iterations < options.max_iterations)
+    {
+        const Indices active_indices(active);
+        const auto num_active = active.size();
+        std::vector<F> coefficients(num_active);
+        // v = r2 / beta
+        for (size_t i = 0; i < num_active; ++i)
+        {
+            coefficients[i] = F(1 / beta[as_size_t(active[i])]);
+        }
+        v->scal(F(0), active_indices);
+        v->axpy(coefficients, *r2, active_indices, active_indices);
+        // y = A v - (beta / old_beta) r1 - (alpha / beta) r2
+        y->scal(F(0), active_indices);
+        y->axpy(F(1), *op.apply(*v, active_indices), active_indices);
+        if (result.num_iterations > 0)
+        {
+            for (size_t i = 0; i < num_active; ++i)
+            {
+                const auto j = as_size_t(active[i]);
+                coefficients[i] = F(-beta[j] / old_beta[j]);
+            }
+            y->axpy(coefficients, *r1, active_indices, active_indices);
+        }
+        const auto alpha = v->pairwise_inner(*y, active_indices, active_indices);
+        for (size_t i = 0; i < num_active; ++i)
+        {
+            coefficients[i] = F(-std::real(alpha[i]) / beta[as_size_t(active[i])]);
+        }
+        y->axpy(coefficients, *r2, active_indices, active_indices);
+        std::swap(r1, r2);
+        std::swap(r2, y);
+        const auto new_beta = sqrt_of<RealType>(r2->norm2(active_indices));
+        // apply the previous rotation and compute the next one, w = (v - epsilon w1 - delta w2) / gamma
+        std::vector<F> v_coefficients(num_active);
+        std::vector<F> w1_coefficients(num_active);
+        std::vector<F> w2_coefficients(num_active);
+        std::vector<F> phi(num_active);
+        for (size_t i = 0; i < num_active; ++i)
+        {
+            const auto j = as_size_t(active[i]);
+            const RealType alpha_j = std::real(alpha[i]);
+            old_beta[j] = beta[j];
+            beta[j] = new_beta[i];
+            const RealType old_epsilon = epsilon[j];
+            const RealType delta = (cs[j] * dbar[j]) + (sn[j] * alpha_j);
+            const RealType gbar = (sn[j] * dbar[j]) - (cs[j] * alpha_j);
+            epsilon[j] = sn[j] * beta[j];
+            dbar[j] = -cs[j] * beta[j];
+            const RealType gamma =
+                std::max(std::hypot(gbar, beta[j]), std::numeric_limits<RealType>::min());
+            cs[j] = gbar / gamma;
+            sn[j] = beta[j] / gamma;
+            phi[i] = F(cs[j] * phibar[j]);
+            phibar[j] *= sn[j];
+            v_coefficients[i] = F(1 / gamma);
+            w1_coefficients[i] = F(-old_epsilon / gamma);
+            w2_coefficients[i] = F(-delta / gamma);
+        }
+        // the new w is stored in the array of w1, which is not needed anymore
+        const auto new_w = w1;
+        new_w->scal(F(0), active_indices);
+        new_w->axpy(v_coefficients, *v, active_indices, active_indices);
+        new_w->axpy(w1_coefficients, *w2, active_indices, active_indices);
+        new_w->axpy(w2_coefficients, *w, active_indices, active_indices);
+        w1 = w2;
+        w2 = w;
+        w = new_w;
+        solution.axpy(phi, *w, active_indices, active_indices);
+        ++result.num_iterations;
+        active = unconverged_indices(phibar, scales, options, result);
+    }
+    result.converged = active.empty();
+    return result;
+}
+
+/**
+ * \brief Restarted GMRES method for general operators
+ *
+ * Each right-hand side is solved by its own Arnoldi process, but all of them are advanced together: the
+ * \c j-th Arnoldi vectors of all right-hand sides are stored in one array, so per iteration, the operator
+ * is applied once and the modified Gram-Schmidt orthogonalization consists of one \c pairwise_inner and
+ * one \c axpy per previous Arnoldi vector. The small least squares problems are solved by Givens
+ * rotations. The residuals are recomputed at each restart.
+ */
+template <floating_point_or_complex F>
+KrylovResult gmres(const OperatorInterface<F>& op, const VectorArrayInterface<F>& rhs,
+                   VectorArrayInterface<F>& solution, const KrylovOptions& options = {})
+{
+    using RealType = real_type_t<F>;
+    check_krylov_arguments("gmres", op, rhs, solution, options);
+    const auto scales = krylov_scales(rhs);
+    const auto restart = as_size_t(options.restart);
+    KrylovResult result;
+    std::vector<ssize_t> active(as_size_t(rhs.size()));
+    std::iota(active.begin(), active.end(), ssize_t(0));
+    std::vector<RealType> all_residual_norms(active.size(), RealType(0));
+    while (true)
+    {
+        // the residuals of the unconverged right-hand sides are the first Arnoldi vectors (before scaling)
+        const auto previous = active;
+        const auto residual = rhs.copy(Indices(previous));
+        residual->axpy(F(-1), *op.apply(solution, Indices(previous)));
+        const auto residual_norms = sqrt_of<RealType>(residual->norm2());
+        for (size_t i = 0; i < previous.size(); ++i)
+        {
+            all_residual_norms[as_size_t(previous[i])] = residual_norms[i];
+        }
+        active = unconverged_indices(all_residual_norms, scales, options, result);
+        if (active.empty() || result.num_iterations >= options.max_iterations)
+        {
+            break;
+        }
+        // positions of the right-hand sides that are still unconverged in previous
+        std::vector<ssize_t> positions;
+        for (const auto index : active)
+        {
+            positions.push_back(std::ranges::find(previous, index) - previous.begin());
+        }
+        const Indices cycle_indices(active);
+        std::vector<std::shared_ptr<VectorArrayInterface<F>>> basis{residual->copy(Indices(positions))};
+        const auto num_rhs = active.size();
+        std::vector<F> scaling(num_rhs);
+        // per right-hand side: Hessenberg matrix (by columns), Givens rotations and right-hand side g
+        std::vector<std::vector<std::vector<F>>> hessenberg(num_rhs);
+        std::vector<std::vector<RealType>> givens_c(num_rhs);
+        std::vector<std::vector<F>> givens_s(num_rhs);
+        std::vector<std::vector<F>> g(num_rhs);
+        for (size_t i = 0; i < num_rhs; ++i)
+        {
+            const auto norm = residual_norms[as_size_t(positions[i])];
+            scaling[i] = F(1 / norm);
+            g[i].push_back(F(norm));
+        }
+        basis[0]->scal(scaling);
+        // positions (in the arrays of the current cycle) of the right-hand sides that are still iterated
+        std::vector<ssize_t> running(num_rhs);
+        std::iota(running.begin(), running.end(), ssize_t(0));
+        std::vector<size_t> num_steps(num_rhs, 0);
+        for (size_t j = 0; j < restart && !running.empty() && result.num_iterations < options.max_iterations;
+             ++j)
+        {
+            const Indices running_indices(running);
+            const auto w = op.apply(*basis[j], running_indices);
+            std::vector<std::vector<F>> h(running.size());
+            for (size_t k = 0; k <= j; ++k)
+            {
+                auto coefficients = basis[k]->pairwise_inner(*w, running_indices);
+                for (size_t i = 0; i < running.size(); ++i)
+                {
+                    h[i].push_back(coefficients[i]);
+                    coefficients[i] = -coefficients[i];
+                }
+                w->axpy(coefficients, *basis[k], std::nullopt, running_indices);
+            }
+            const auto norms = w->norm();
+            auto next = basis[j]->copy();
+            std::vector<F> inverse_norms(running.size());
+            std::vector<ssize_t> still_running;
+            for (size_t i = 0; i < running.size(); ++i)
+            {
+                const auto r = as_size_t(running[i]);
+                h[i].push_back(F(norms[i]));
+                inverse_norms[i] = norms[i] > 0 ? F(1 / norms[i]) : F(0);
+                // apply the previous rotations to the new column and compute a new rotation
+                auto& column = h[i];
+                for (size_t k = 0; k < j; ++k)
+                {
+                    const F upper = column[k];
+                    column[k] = (givens_c[r][k] * upper) + (givens_s[r][k] * column[k + 1]);
+                    column[k + 1] =
+                        (-conj_if_complex(givens_s[r][k]) * upper) + (givens_c[r][k] * column[k + 1]);
+                }
+                const F a = column[j];
+                const F b = column[j + 1];
+                const RealType abs_a = std::abs(a);
+                const RealType radius = std::hypot(abs_a, RealType(std::abs(b)));
+                RealType c(0);
+                F s(1);
+                F rotated = b;
+                if (abs_a > 0)
+                {
+                    c = abs_a / radius;
+                    s = (a / abs_a) * conj_if_complex(b) / radius;
+                    rotated = (a / abs_a) * radius;
+                }
+                column[j] = rotated;
+                column[j + 1] = F(0);
+                givens_c[r].push_back(c);
+                givens_s[r].push_back(s);
+                g[r].push_back(-conj_if_complex(s) * g[r][j]);
+                g[r][j] *= c;
+                hessenberg[r].push_back(std::move(column));
+                num_steps[r] = j + 1;
+                const double estimate = std::abs(g[r][j + 1]) / scales[as_size_t(active[r])];
+                if (estimate > options.tolerance && norms[i] > 0)
+                {
+                    still_running.push_back(running[i]);
+                }
+            }
+            next->scal(F(0), running_indices);
+            next->axpy(inverse_norms, *w, running_indices);
+            basis.push_back(next);
+            running = std::move(still_running);
+            ++result.num_iterations;
+        }
+        // solve the triangular systems and update the solutions
+        std::vector<std::vector<F>> y(basis.size(), std::vector<F>(num_rhs, F(0)));
+        for (size_t r = 0; r < num_rhs; ++r)
+        {
+            for (size_t k = num_steps[r]; k-- > 0;)
+            {
+                F value = g[r][k];
+                for (size_t l = k + 1; l < num_steps[r]; ++l)
+                {
+                    value -= hessenberg[r][l][k] * y[l][r];
+                }
+                y[k][r] = value / hessenberg[r][k][k];
+            }
+        }
+        for (size_t k = 0; k + 1 < basis.size(); ++k)
+        {
+            solution.axpy(y[k], *basis[k], cycle_indices);
+        }
+    }
+    result.converged = active.empty();
+    return result;
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_KRYLOV_H
@@ -0,0 +1,277 @@
+#ifndef NIAS_CPP_ALGORITHMS_MIXED_PRECISION_GRAM_SCHMIDT_H
+#define NIAS_CPP_ALGORITHMS_MIXED_PRECISION_GRAM_SCHMIDT_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/reduced_precision.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/reduced_precision.h>
+
+namespace nias
+{
+
+
+/// Options for mixed_precision_gram_schmidt
+struct MixedPrecisionGramSchmidtOptions
+{
+    /**
+     * \brief Tolerated loss of orthogonality
+     *
+     * A vector is reorthogonalized in full precision if the estimated inner products of the vector with the
+     * previous basis vectors exceed this tolerance, and removed if they still exceed it after two
+     * reorthogonalizations. 0 means 100 times the machine epsilon of \c F.
+     */
+    double tolerance = 0.;
+    /**
+     * \brief Vectors whose norm drops below this fraction of their original norm are removed
+     *
+     * 0 means 10 times the machine epsilon of \c F.
+     */
+    double removal_tolerance = 0.;
+    /**
+     * \brief Whether the loss of orthogonality of the result is measured
+     *
+     * If enabled, the Gram matrix of the result is computed and, if the loss of orthogonality exceeds the
+     * tolerance, the result is corrected by a Cholesky-QR step (see cholesky_qr).
+     */
+    bool cholesky_qr_correction = false;
+};
+
+/// Statistics reported by mixed_precision_gram_schmidt
+struct MixedPrecisionGramSchmidtReport
+{
+    ssize_t num_low_precision_passes = 0;
+    /// Number of reorthogonalizations in full precision (at most two per vector)
+    ssize_t num_high_precision_passes = 0;
+    ssize_t num_removed_vectors = 0;
+    /// Largest estimated loss of orthogonality of a single vector after its last pass
+    double estimated_loss_of_orthogonality = 0.;
+    /// Loss of orthogonality of the result before the Cholesky-QR correction (if it has been measured)
+    std::optional<double> measured_loss_of_orthogonality;
+    bool cholesky_qr_applied = false;
+};
+
+/// Largest entry of <tt>gram</tt> minus the identity (in absolute value)
+template <std::floating_point F>
+[[nodiscard]] F loss_of_orthogonality(const std::vector<std::vector<F>>& gram)
+{
+    F ret(0);
+    for (size_t i = 0; i < gram.size(); ++i)
+    {
+        for (size_t j = 0; j < gram[i].size(); ++j)
+        {
+            ret = std::max(ret, std::abs(gram[i][j] - F(i == j ? 1 : 0)));
+        }
+    }
+    return ret;
+}
+
+/**
+ * \brief Loss of orthogonality of \c vec_array, i.e., the largest entry of the Gram matrix minus the
+ * identity (in absolute value)
+ */
+template <std::floating_point F>
+[[nodiscard]] F loss_of_orthogonality(const VectorArrayInterface<F>& vec_array)
+{
+    return loss_of_orthogonality(vec_array.inner(vec_array));
+}
+
+/**
+ * \brief Orthonormalizes \c vec_array in place by a Cholesky-QR step
+ *
+ * Computes the Cholesky factorization <tt>G = R^T R</tt> of the Gram matrix \c G of the vectors and replaces
+ * the vectors by <tt>Q R^{-1}</tt>. The factorization is computed in double precision (at least). This is
+ * cheap compared to Gram-Schmidt if the vectors are almost orthonormal, which is what it is used for.
+ *
+ * \param gram: The Gram matrix of the vectors (<tt>vec_array.inner(vec_array)</tt>).
+ * \throws InvalidStateError if the Gram matrix is not (numerically) positive definite.
+ */
+template <std::floating_point F>
+void cholesky_qr(VectorArrayInterface<F>& vec_array, const std::vector<std::vector<F>>& gram)
+{
+    using HighPrecisionType = std::conditional_t<(sizeof(F) < sizeof(double)), double, F>;
+    const auto size = as_size_t(vec_array.size());
+    // upper triangular Cholesky factor
+    std::vector<std::vector<HighPrecisionType>> r(size, std::vector<HighPrecisionType>(size, 0));
+    for (size_t j = 0; j < size; ++j)
+    {
+        for (size_t i = 0; i <= j; ++i)
+        {
+            auto value = HighPrecisionType(gram[i][j]);
+            for (size_t k = 0; k < i; ++k)
+            {
+                value -= r[k][i] * r[k][j];
+            }
+            if (i < j)
+            {
+                r[i][j] = value / r[i][i];
+            }
+            else if (value > 0)
+            {
+                r[j][j] = std::sqrt(value);
+            }
+            else
+            {
+                throw InvalidStateError("cholesky_qr: Gram matrix is not positive definite");
+            }
+        }
+    }
+    // coefficients[j] is the j-th column of R^{-1}, computed by back substitution
+    std::vector<std::vector<F>> coefficients(size, std::vector<F>(size, F(0)));
+    for (size_t j = 0; j < size; ++j)
+    {
+        std::vector<HighPrecisionType> column(j + 1, 0);
+        column[j] = 1 / r[j][j];
+        for (size_t i = j; i-- > 0;)
+        {
+            HighPrecisionType value = 0;
+            for (size_t k = i + 1; k <= j; ++k)
+            {
+                value -= r[i][k] * column[k];
+            }
+            column[i] = value / r[i][i];
+        }
+        std::ranges::transform(column, coefficients[j].begin(),
+                               [](HighPrecisionType value)
+                               {
+                                   return F(value);
+                               });
+    }
+    const auto orthonormalized = vec_array.lincomb(coefficients);
+    vec_array.delete_vectors(std::nullopt);
+    vec_array.append(*orthonormalized);
+}
+
+/// Orthonormalizes \c vec_array in place by a Cholesky-QR step (computing the Gram matrix first)
+template <std::floating_point F>
+void cholesky_qr(VectorArrayInterface<F>& vec_array)
+{
+    cholesky_qr(vec_array, vec_array.inner(vec_array));
+}
+
+/**
+ * \brief Mixed-precision Gram-Schmidt orthonormalization (in place)
+ *
+ * The basis is stored twice: in \c vec_array (in precision \c F) and in a ReducedPrecisionVectorArray
+ * with storage type \c S. For each vector, the coefficients of the projection onto the previous basis
+ * vectors are first computed from the low precision copies (classical Gram-Schmidt, reading \c S instead of
+ * \c F, accumulated in double precision at least). The projection is subtracted in precision \c F.
+ *
+ * The coefficients computed this way have an error of about <tt>(eps_S + delta) * |v|</tt>, where \c eps_S
+ * is the machine epsilon of \c S, \c v is the vector before the projection and \c delta is the sum of the
+ * estimated losses of orthogonality of the previous basis vectors, weighted by the coefficients relative to
+ * <tt>|v|</tt> (the estimated loss of each basis vector is stored). The loss of orthogonality of the new
+ * basis vector is thus estimated by <tt>(eps_S + delta) * |v| / |v - Pv|</tt>. Only if this exceeds the
+ * tolerance, the vector is reorthogonalized using the full precision basis (at most twice, with \c eps_S
+ * replaced by the machine epsilon of \c F). With the default tolerance, every vector is thus
+ * reorthogonalized once, i.e., compared to classical Gram-Schmidt with reorthogonalization in precision
+ * \c F, the first of the two passes reads \c S instead of \c F. With a tolerance above \c eps_S, the full
+ * precision basis is only read for vectors with heavy cancellation. Linearly dependent vectors are removed
+ * as in gram_schmidt_cpp. Vectors whose estimated loss still exceeds the tolerance after the second
+ * reorthogonalization are numerically dependent on the previous ones and are removed as well.
+ *
+ * Only the Euclidean inner product is supported. For <tt>F = float</tt> and the default <tt>S = float</tt>,
+ * the low precision copy is exact, but its inner products are accumulated in double precision.
+ *
+ * \note The full precision reorthogonalization and the measurement of the loss of orthogonality use the
+ * inner products of \c vec_array, so their accuracy depends on its implementation.
+ */
+template <std::floating_point F, storage_scalar S = float>
+MixedPrecisionGramSchmidtReport mixed_precision_gram_schmidt(
+    VectorArrayInterface<F>& vec_array, const MixedPrecisionGramSchmidtOptions& options = {})
+{
+    if (options.tolerance < 0 || options.removal_tolerance < 0)
+    {
+        throw InvalidArgumentError("mixed_precision_gram_schmidt: tolerances must be non-negative");
+    }
+    constexpr double epsilon = std::numeric_limits<F>::epsilon();
+    const double tolerance = options.tolerance > 0 ? options.tolerance : 100 * epsilon;
+    const double removal_tolerance = options.removal_tolerance > 0 ? options.removal_tolerance : 10 * epsilon;
+
+    MixedPrecisionGramSchmidtReport report;
+    ReducedPrecisionVectorArray<F, S> low_precision_basis(0, vec_array.dim());
+    ReducedPrecisionVectorArray<F, S> low_precision_vector(0, vec_array.dim());
+    std::vector<ssize_t> basis_indices;
+    std::vector<ssize_t> indices_to_remove;
+    // estimated loss of orthogonality (inner products with the previous basis vectors) of each basis vector
+    std::vector<double> basis_losses;
+    for (ssize_t i = 0; i < vec_array.size(); ++i)
+    {
+        // coefficients[k][0] is the inner product of the k-th basis vector with the i-th vector, returns the
+        // error of the inner products of the result with the basis caused by the non-orthogonal basis
+        const auto subtract_projection = [&](const std::vector<std::vector<F>>& coefficients)
+        {
+            double error = 0.;
+            for (size_t k = 0; k < basis_indices.size(); ++k)
+            {
+                vec_array.axpy(-coefficients[k][0], vec_array, {i}, {basis_indices[k]});
+                error += std::abs(double(coefficients[k][0])) * basis_losses[k];
+            }
+            return error;
+        };
+        const double initial_norm = vec_array.norm({i}).at(0);
+        const double removal_norm = removal_tolerance * initial_norm;
+        double norm = initial_norm;
+        double loss = 0.;
+        if (!basis_indices.empty() && initial_norm > 0)
+        {
+            low_precision_vector.delete_vectors(std::nullopt);
+            low_precision_vector.append(vec_array, false, Indices{i});
+            double error = subtract_projection(low_precision_basis.inner(low_precision_vector));
+            ++report.num_low_precision_passes;
+            double previous_norm = norm;
+            norm = vec_array.norm({i}).at(0);
+            loss = ((storage_epsilon<S>() * previous_norm) + error) / norm;
+            for (int pass = 0; pass < 2 && loss > tolerance && norm > removal_norm; ++pass)
+            {
+                error = subtract_projection(vec_array.inner(vec_array, Indices(basis_indices), Indices{i}));
+                ++report.num_high_precision_passes;
+                previous_norm = norm;
+                norm = vec_array.norm({i}).at(0);
+                loss = ((epsilon * previous_norm) + error) / norm;
+            }
+        }
+        // (the negated comparisons also remove vectors containing NaNs)
+        if (!(norm > removal_norm) || !(loss <= tolerance))
+        {
+            indices_to_remove.push_back(i);
+            continue;
+        }
+        basis_losses.push_back(loss);
+        report.estimated_loss_of_orthogonality = std::max(report.estimated_loss_of_orthogonality, loss);
+        vec_array.scal(F(1) / F(norm), {i});
+        low_precision_basis.append(vec_array, false, Indices{i});
+        basis_indices.push_back(i);
+    }
+    vec_array.delete_vectors(indices_to_remove);
+    report.num_removed_vectors = as_ssize_t(indices_to_remove.size());
+
+    if (options.cholesky_qr_correction && vec_array.size() > 0)
+    {
+        const auto gram = vec_array.inner(vec_array);
+        const double measured_loss = loss_of_orthogonality(gram);
+        report.measured_loss_of_orthogonality = measured_loss;
+        if (measured_loss > tolerance)
+        {
+            cholesky_qr(vec_array, gram);
+            report.cholesky_qr_applied = true;
+        }
+    }
+    return report;
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_MIXED_PRECISION_GRAM_SCHMIDT_H
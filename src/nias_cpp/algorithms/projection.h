@@ -0,0 +1,274 @@
+#ifndef NIAS_CPP_ALGORITHMS_PROJECTION_H
+#define NIAS_CPP_ALGORITHMS_PROJECTION_H
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Dense matrix whose entries are stored contiguously in row-major order
+ *
+ * Used for the (small) results of projections. The buffer can be moved out (see release) to hand it over
+ * to other libraries (e.g., numpy) without copying.
+ */
+template <floating_point_or_complex F>
+class ReducedMatrix
+{
+   public:
+    ReducedMatrix() = default;
+
+    ReducedMatrix(ssize_t rows, ssize_t cols)
+        : rows_(rows)
+        , cols_(cols)
+        , data_(as_size_t(rows) * as_size_t(cols), F(0))
+    {
+    }
+
+    [[nodiscard]] ssize_t rows() const
+    {
+        return rows_;
+    }
+
+    [[nodiscard]] ssize_t cols() const
+    {
+        return cols_;
+    }
+
+    [[nodiscard]] F& operator()(ssize_t i, ssize_t j)
+    {
+        return data_[(as_size_t(i) * as_size_t(cols_)) + as_size_t(j)];
+    }
+
+    [[nodiscard]] const F& operator()(ssize_t i, ssize_t j) const
+    {
+        return data_[(as_size_t(i) * as_size_t(cols_)) + as_size_t(j)];
+    }
+
+    /// Pointer to the first entry of row \c i
+    [[nodiscard]] F* row(ssize_t i)
+    {
+        return data_.data() + (as_size_t(i) * as_size_t(cols_));
+    }
+
+    [[nodiscard]] F* data()
+    {
+        return data_.data();
+    }
+
+    [[nodiscard]] const F* data() const
+    {
+        return data_.data();
+    }
+
+    /// Moves the buffer out of the matrix, which is empty (0x0) afterwards
+    [[nodiscard]] std::vector<F> release()
+    {
+        rows_ = 0;
+        cols_ = 0;
+        return std::exchange(data_, {});
+    }
+
+   private:
+    ssize_t rows_ = 0;
+    ssize_t cols_ = 0;
+    std::vector<F> data_;
+};
+
+/// Options for GalerkinProjector and project_vectors
+struct ProjectionOptions
+{
+    /// Number of threads (0 means all hardware threads)
+    ssize_t num_threads = 1;
+    /// Number of basis vectors which are passed to a single apply (or inner) call
+    ssize_t block_size = 32;
+};
+
+/**
+ * \brief Projects a list of operators <tt>A_k</tt> onto a (right) basis \c V
+ *
+ * All products <tt>A_k V</tt> are computed once by the constructor and then reused for all left bases, so
+ * projecting onto several test spaces (e.g., Galerkin and Petrov-Galerkin projections or error estimators)
+ * only requires the inner products <tt>W^H (A_k V)</tt>. The basis vectors are split into blocks of
+ * \c block_size vectors, and all (operator, block) pairs are processed by up to \c num_threads threads, both
+ * for the operator applications and for the inner products. The operators and the vector arrays thus have
+ * to support concurrent const calls without the GIL if \c num_threads is not 1, which excludes
+ * NumpyVectorArrays and implementations in Python.
+ *
+ * The basis must not be modified while the projector is in use.
+ */
+template <floating_point_or_complex F>
+class GalerkinProjector
+{
+   public:
+    using OperatorType = OperatorInterface<F>;
+    using VectorArrayType = VectorArrayInterface<F>;
+
+    GalerkinProjector(std::vector<std::shared_ptr<const OperatorType>> operators,
+                      std::shared_ptr<const VectorArrayType> basis, const ProjectionOptions& options = {})
+        : operators_(std::move(operators))
+        , basis_(std::move(basis))
+        , options_(options)
+    {
+        if (basis_ == nullptr || options_.block_size <= 0)
+        {
+            throw InvalidArgumentError("GalerkinProjector: basis must not be null and block_size positive");
+        }
+        static_cast<void>(effective_num_threads(options_.num_threads));
+        for (const auto& op : operators_)
+        {
+            if (op == nullptr || op->source_dim() != basis_->dim())
+            {
+                throw InvalidArgumentError("GalerkinProjector: operator source dimension must match basis");
+            }
+        }
+        images_.resize(operators_.size(),
+                       std::vector<std::shared_ptr<const VectorArrayType>>(as_size_t(num_blocks())));
+        for_each_block(
+            [this](size_t k, ssize_t block)
+            {
+                images_[k][as_size_t(block)] = operators_[k]->apply(*basis_, block_indices(block));
+            });
+    }
+
+    [[nodiscard]] ssize_t num_operators() const
+    {
+        return std::ssize(operators_);
+    }
+
+    [[nodiscard]] const VectorArrayType& basis() const
+    {
+        return *basis_;
+    }
+
+    [[nodiscard]] const ProjectionOptions& options() const
+    {
+        return options_;
+    }
+
+    /**
+     * \brief Returns the matrices <tt>W^H A_k V</tt> (one per operator) for the left basis <tt>W</tt>
+     *
+     * Each matrix has <tt>left_basis.size()</tt> rows and <tt>basis().size()</tt> columns.
+     */
+    [[nodiscard]] std::vector<ReducedMatrix<F>> project(const VectorArrayType& left_basis) const
+    {
+        for (const auto& op : operators_)
+        {
+            if (op->range_dim() != left_basis.dim())
+            {
+                throw InvalidArgumentError("GalerkinProjector: operator range dimension must match basis");
+            }
+        }
+        std::vector<ReducedMatrix<F>> ret(operators_.size(),
+                                          ReducedMatrix<F>(left_basis.size(), basis_->size()));
+        for_each_block(
+            [&](size_t k, ssize_t block)
+            {
+                // each block fills its own columns
+                const auto block_matrix = left_basis.inner(*images_[k][as_size_t(block)]);
+                const auto first = block * options_.block_size;
+                for (size_t i = 0; i < block_matrix.size(); ++i)
+                {
+                    std::ranges::copy(block_matrix[i], ret[k].row(as_ssize_t(i)) + first);
+                }
+            });
+        return ret;
+    }
+
+    /// Galerkin projection: returns the matrices <tt>V^H A_k V</tt>
+    [[nodiscard]] std::vector<ReducedMatrix<F>> project() const
+    {
+        return project(*basis_);
+    }
+
+   private:
+    [[nodiscard]] ssize_t num_blocks() const
+    {
+        return (basis_->size() + options_.block_size - 1) / options_.block_size;
+    }
+
+    [[nodiscard]] Indices block_indices(ssize_t block) const
+    {
+        const auto first = block * options_.block_size;
+        std::vector<ssize_t> ret(as_size_t(std::min(options_.block_size, basis_->size() - first)));
+        std::iota(ret.begin(), ret.end(), first);
+        return ret;
+    }
+
+    // calls func(k, block) for all operators k and all blocks of basis vectors
+    template <class Func>
+    void for_each_block(Func&& func) const
+    {
+        const auto blocks = num_blocks();
+        parallel_for(
+            0, num_operators() * blocks,
+            [&](ssize_t task)
+            {
+                func(as_size_t(task / blocks), task % blocks);
+            },
+            options_.num_threads);
+    }
+
+    std::vector<std::shared_ptr<const OperatorType>> operators_;
+    std::shared_ptr<const VectorArrayType> basis_;
+    ProjectionOptions options_;
+    // images_[k][block] = A_k applied to the basis vectors of the block
+    std::vector<std::vector<std::shared_ptr<const VectorArrayType>>> images_;
+};
+
+/**
+ * \brief Projects vector arrays (e.g., the affine components of a right-hand side) onto a basis
+ *
+ * Returns the matrices <tt>W^H f_k</tt>, each with <tt>left_basis.size()</tt> rows and <tt>f_k.size()</tt>
+ * columns. The arrays are processed by up to \c num_threads threads.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::vector<ReducedMatrix<F>> project_vectors(
+    const VectorArrayInterface<F>& left_basis,
+    const std::vector<std::shared_ptr<const VectorArrayInterface<F>>>& vectors,
+    const ProjectionOptions& options = {})
+{
+    std::vector<ReducedMatrix<F>> ret(vectors.size());
+    for (const auto& f : vectors)
+    {
+        if (f == nullptr || f->dim() != left_basis.dim())
+        {
+            throw InvalidArgumentError("project_vectors: dimensions of vectors and basis do not match");
+        }
+    }
+    parallel_for(
+        0, std::ssize(vectors),
+        [&](ssize_t k)
+        {
+            const auto& f = *vectors[as_size_t(k)];
+            auto& matrix = ret[as_size_t(k)];
+            matrix = ReducedMatrix<F>(left_basis.size(), f.size());
+            const auto inner = left_basis.inner(f);
+            for (size_t i = 0; i < inner.size(); ++i)
+            {
+                std::ranges::copy(inner[i], matrix.row(as_ssize_t(i)));
+            }
+        },
+        options.num_threads);
+    return ret;
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_PROJECTION_H
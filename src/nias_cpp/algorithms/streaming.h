@@ -0,0 +1,323 @@
+#ifndef NIAS_CPP_ALGORITHMS_STREAMING_H
+#define NIAS_CPP_ALGORITHMS_STREAMING_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <format>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/// Options for the out-of-core algorithms streaming_gram_matrix and streaming_gram_schmidt
+struct StreamingOptions
+{
+    /// Maximal number of bytes used by the tiles held in memory at the same time
+    ssize_t memory_budget = ssize_t(256) << 20;
+    /// Number of vectors per tile (0 means the largest tile size that fits into the memory budget)
+    ssize_t tile_size = 0;
+    /// Whether the next tile is loaded on a background thread while the current tile is processed
+    bool prefetch = true;
+};
+
+/// Statistics reported by the out-of-core algorithms
+struct StreamingReport
+{
+    ssize_t tile_size = 0;
+    /// Maximal number of bytes used by tiles at the same time (never larger than the memory budget)
+    ssize_t peak_memory = 0;
+    ssize_t num_tile_loads = 0;
+};
+
+/**
+ * \brief Loads tiles (ranges of consecutive vectors) of a VectorArray into memory
+ *
+ * Tiles are obtained by <tt>array.copy(Slice(begin, end))</tt>, so arrays stored on disk (e.g., a
+ * MappedNpyVectorArray) are read sequentially in large chunks. The memory held by all tiles that are
+ * alive at the same time is tracked and may not exceed the memory budget. The tile size is chosen such
+ * that \c max_tiles_in_memory tiles fit into the budget.
+ *
+ * \note With prefetching enabled, tiles are loaded on a background thread, so \c array.copy has to be
+ * safe to call from another thread (while the calling thread only reads other vectors of the array). This
+ * is not the case for arrays whose data is managed by Python (e.g., NumpyVectorArray), disable
+ * prefetching for those.
+ */
+template <floating_point_or_complex F>
+class TileStream
+{
+    using VectorArrayType = VectorArrayInterface<F>;
+
+   public:
+    TileStream(const VectorArrayType& array, const StreamingOptions& options, ssize_t max_tiles_in_memory)
+        : array_(array)
+        , memory_budget_(options.memory_budget)
+        , prefetch_(options.prefetch)
+        , bytes_per_vector_(std::max(ssize_t(1), array.dim() * as_ssize_t(sizeof(F))))
+    {
+        if (options.tile_size < 0)
+        {
+            throw InvalidArgumentError("TileStream: tile_size must be non-negative");
+        }
+        const auto max_tile_size = memory_budget_ / (max_tiles_in_memory * bytes_per_vector_);
+        if (max_tile_size < 1)
+        {
+            throw InvalidArgumentError(
+                std::format("TileStream: memory budget of {} bytes is too small (at least {} bytes needed)",
+                            memory_budget_, max_tiles_in_memory * bytes_per_vector_));
+        }
+        if (options.tile_size > max_tile_size)
+        {
+            throw InvalidArgumentError(
+                std::format("TileStream: {} tiles of {} vectors do not fit into the memory budget ({} bytes)",
+                            max_tiles_in_memory, options.tile_size, memory_budget_));
+        }
+        tile_size_ = options.tile_size == 0 ? max_tile_size : options.tile_size;
+        report_.tile_size = tile_size_;
+    }
+
+    [[nodiscard]] ssize_t tile_size() const
+    {
+        return tile_size_;
+    }
+
+    [[nodiscard]] StreamingReport report() const
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        return report_;
+    }
+
+    /// Load the vectors <tt>[begin, end)</tt> (the returned array owns its memory)
+    [[nodiscard]] std::shared_ptr<VectorArrayType> load(ssize_t begin, ssize_t end)
+    {
+        const auto bytes = (end - begin) * bytes_per_vector_;
+        acquire(bytes);
+        try
+        {
+            const auto tile = array_.copy(Slice(begin, end));
+            const std::lock_guard<std::mutex> lock(mutex_);
+            ++report_.num_tile_loads;
+            return track(tile, bytes, false);
+        }
+        catch (...)
+        {
+            release(bytes);
+            throw;
+        }
+    }
+
+    /// Account for a tile-sized array that has been computed from tiles (e.g., a linear combination)
+    [[nodiscard]] std::shared_ptr<VectorArrayType> track(const std::shared_ptr<VectorArrayType>& array)
+    {
+        return track(array, array->size() * bytes_per_vector_, true);
+    }
+
+    /**
+     * \brief Calls <tt>func(tile_begin, tile)</tt> for the tiles covering the vectors <tt>[begin, end)</tt>
+     *
+     * If prefetching is enabled, the next tile is loaded in the background while \c func is running.
+     */
+    template <class Func>
+    void for_each_tile(ssize_t begin, ssize_t end, Func&& func)
+    {
+        const auto policy = prefetch_ ? std::launch::async : std::launch::deferred;
+        const auto load_tile = [this, end](ssize_t tile_begin)
+        {
+            return load(tile_begin, std::min(end, tile_begin + tile_size_));
+        };
+        std::future<std::shared_ptr<VectorArrayType>> next_tile;
+        if (begin < end)
+        {
+            next_tile = std::async(policy, load_tile, begin);
+        }
+        for (ssize_t tile_begin = begin; tile_begin < end; tile_begin += tile_size_)
+        {
+            const auto tile = next_tile.get();
+            if (tile_begin + tile_size_ < end)
+            {
+                next_tile = std::async(policy, load_tile, tile_begin + tile_size_);
+            }
+            func(tile_begin, *tile);
+        }
+    }
+
+   private:
+    void acquire(ssize_t bytes)
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (memory_in_use_ + bytes > memory_budget_)
+        {
+            throw InvalidStateError(
+                std::format("TileStream: memory budget of {} bytes exceeded", memory_budget_));
+        }
+        memory_in_use_ += bytes;
+        report_.peak_memory = std::max(report_.peak_memory, memory_in_use_);
+    }
+
+    void release(ssize_t bytes)
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        memory_in_use_ -= bytes;
+    }
+
+    // returns a shared_ptr to the same array which releases the memory once the last copy is destroyed
+    std::shared_ptr<VectorArrayType> track(const std::shared_ptr<VectorArrayType>& array, ssize_t bytes,
+                                           bool needs_acquire)
+    {
+        if (needs_acquire)
+        {
+            acquire(bytes);
+        }
+        return {array.get(), [this, array, bytes](VectorArrayType* /*ptr*/)
+                {
+                    release(bytes);
+                }};
+    }
+
+    const VectorArrayType& array_;
+    ssize_t memory_budget_;
+    bool prefetch_;
+    ssize_t bytes_per_vector_;
+    ssize_t tile_size_ = 0;
+    ssize_t memory_in_use_ = 0;
+    StreamingReport report_;
+    mutable std::mutex mutex_;
+};
+
+/**
+ * \brief Computes the Gram matrix of \c array tile by tile
+ *
+ * Only the tiles on and above the diagonal are computed (using Hermitian symmetry for the remaining
+ * ones). At most four tiles are held in memory at the same time (the current left and right tiles and the
+ * tiles prefetched for both), so the tile size is limited by a quarter of the memory budget. The result
+ * itself (<tt>size() x size()</tt> scalars) is not counted.
+ *
+ * \param report: If not nullptr, statistics (tile size, peak memory, number of loaded tiles) are stored here.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::vector<std::vector<F>> streaming_gram_matrix(
+    const VectorArrayInterface<F>& array,
+    const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>(),
+    const StreamingOptions& options = {}, StreamingReport* report = nullptr)
+{
+    TileStream<F> stream(array, options, 4);
+    const auto size = array.size();
+    std::vector<std::vector<F>> ret(as_size_t(size), std::vector<F>(as_size_t(size)));
+    stream.for_each_tile(
+        0, size,
+        [&](ssize_t left_begin, const VectorArrayInterface<F>& left)
+        {
+            const auto compute_tile = [&](ssize_t right_begin, const VectorArrayInterface<F>& right)
+            {
+                const auto tile = inner_product.apply(left, right);
+                for (ssize_t i = 0; i < left.size(); ++i)
+                {
+                    for (ssize_t j = 0; j < right.size(); ++j)
+                    {
+                        const auto value = tile[as_size_t(i)][as_size_t(j)];
+                        ret[as_size_t(left_begin + i)][as_size_t(right_begin + j)] = value;
+                        ret[as_size_t(right_begin + j)][as_size_t(left_begin + i)] = conj_if_complex(value);
+                    }
+                }
+            };
+            compute_tile(left_begin, left);
+            stream.for_each_tile(left_begin + left.size(), size, compute_tile);
+        });
+    if (report != nullptr)
+    {
+        *report = stream.report();
+    }
+    return ret;
+}
+
+/**
+ * \brief Orthonormalizes \c array in place, streaming through it tile by tile
+ *
+ * Block Gram-Schmidt: each tile is loaded into memory, the basis computed so far is projected out
+ * (streaming through the basis tiles twice, to compensate for cancellation) and the tile is orthonormalized
+ * using gram_schmidt_cpp. Since the vectors of each tile are normalized when they are loaded, vectors are
+ * removed if their norm drops below <tt>sqrt(10 eps)</tt> times their original norm (gram_schmidt_cpp on its
+ * own uses an absolute tolerance, which depends on the scaling of the vectors). At most four tiles
+ * are held in memory at the same time (the current tile, the current and the prefetched basis tile and the
+ * update computed from the basis tile).
+ *
+ * \param report: If not nullptr, statistics (tile size, peak memory, number of loaded tiles) are stored here.
+ */
+template <floating_point_or_complex F>
+void streaming_gram_schmidt(VectorArrayInterface<F>& array,
+                            const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>(),
+                            const StreamingOptions& options = {}, StreamingReport* report = nullptr)
+{
+    TileStream<F> stream(array, options, 4);
+    const auto size = array.size();
+    ssize_t num_basis_vectors = 0;
+    for (ssize_t tile_begin = 0; tile_begin < size; tile_begin += stream.tile_size())
+    {
+        const auto tile = stream.load(tile_begin, std::min(size, tile_begin + stream.tile_size()));
+        // normalize first, so the (absolute) removal tolerance of gram_schmidt_cpp becomes a relative one
+        const auto norms2 = inner_product.apply_pairwise(*tile, *tile);
+        std::vector<F> scaling;
+        for (const auto& norm2 : norms2)
+        {
+            const auto norm = std::sqrt(std::real(norm2));
+            scaling.push_back(norm > 0 ? F(1 / norm) : F(1));
+        }
+        tile->scal(scaling);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            stream.for_each_tile(0, num_basis_vectors,
+                                 [&](ssize_t /*basis_begin*/, const VectorArrayInterface<F>& basis)
+                                 {
+                                     // coefficients[i][k] = (basis_k, tile_i)
+                                     const auto products = inner_product.apply(basis, *tile);
+                                     std::vector<std::vector<F>> coefficients(
+                                         as_size_t(tile->size()), std::vector<F>(as_size_t(basis.size())));
+                                     for (ssize_t k = 0; k < basis.size(); ++k)
+                                     {
+                                         for (ssize_t i = 0; i < tile->size(); ++i)
+                                         {
+                                             coefficients[as_size_t(i)][as_size_t(k)] =
+                                                 products[as_size_t(k)][as_size_t(i)];
+                                         }
+                                     }
+                                     const auto projection = stream.track(basis.lincomb(coefficients));
+                                     tile->axpy(F(-1), *projection);
+                                 });
+        }
+        gram_schmidt_cpp(*tile, inner_product);
+        // Store the new basis vectors directly behind the existing ones. This never overwrites vectors
+        // that have not been processed yet since tiles can only shrink.
+        for (ssize_t i = 0; i < tile->size(); ++i)
+        {
+            for (ssize_t j = 0; j < array.dim(); ++j)
+            {
+                array.set(num_basis_vectors + i, j, tile->get(i, j));
+            }
+        }
+        num_basis_vectors += tile->size();
+    }
+    array.delete_vectors(Slice(num_basis_vectors, size));
+    if (report != nullptr)
+    {
+        *report = stream.report();
+    }
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_STREAMING_H
@@ -0,0 +1,158 @@
+#ifndef NIAS_CPP_ALGORITHMS_WEAK_GREEDY_H
+#define NIAS_CPP_ALGORITHMS_WEAK_GREEDY_H
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/// Options for weak_greedy
+struct WeakGreedyOptions
+{
+    /// Maximal number of basis extensions
+    ssize_t max_extensions = 100;
+    /// The algorithm stops once the largest estimated error is at most this value
+    double tolerance = 0.;
+    /**
+     * \brief Number of threads used for the error estimation (0 means all hardware threads)
+     *
+     * If more than one thread is used, the error estimator is called concurrently (with the same basis).
+     */
+    ssize_t num_threads = 1;
+};
+
+/// Statistics of one iteration (error estimation and, unless the algorithm stops, basis extension)
+struct WeakGreedyIteration
+{
+    /// Training set index with the largest estimated error
+    ssize_t selected_index = -1;
+    double max_error = 0.;
+    /// Number of vectors appended to the basis (after removing linearly dependent vectors)
+    ssize_t num_appended = 0;
+    double estimation_milliseconds = 0.;
+    double solve_milliseconds = 0.;
+    double orthonormalization_milliseconds = 0.;
+};
+
+/// Statistics reported by weak_greedy
+struct WeakGreedyReport
+{
+    /**
+     * \brief One entry per error estimation
+     *
+     * The extension statistics of the last entry are zero if the tolerance or the maximal number of
+     * extensions has been reached.
+     */
+    std::vector<WeakGreedyIteration> iterations;
+    /// Largest estimated error for the final basis
+    double max_error = std::numeric_limits<double>::infinity();
+    /// Whether the tolerance has been reached
+    bool converged = false;
+};
+
+/**
+ * \brief Weak greedy basis generation
+ *
+ * In each iteration, the error of the reduced model with the current basis is estimated for all
+ * <tt>training_set_size</tt> training parameters by <tt>estimate_error(basis, i)</tt> (which returns a
+ * \c double), distributed dynamically over \c num_threads threads. If the largest estimated error is above
+ * the tolerance, <tt>solve(i)</tt> computes the snapshot(s) for the training parameter \c i with the largest
+ * error (as a <tt>std::shared_ptr</tt> to a VectorArray). Only the new vectors are orthonormalized against
+ * the (orthonormal) basis (see orthonormalize) and then appended to \c basis.
+ *
+ * \c basis is extended in place, so it may already contain orthonormal vectors, and the arrays returned by
+ * \c solve have to be appendable to it (e.g., ListVectorArrays if \c basis is a ListVectorArray).
+ * \c estimate_error must not modify the basis and, if \c num_threads is not 1, must be safe to call
+ * concurrently. \c solve is always called in the calling thread.
+ */
+template <floating_point_or_complex F, class ErrorEstimator, class Solver>
+WeakGreedyReport weak_greedy(VectorArrayInterface<F>& basis, ssize_t training_set_size,
+                             ErrorEstimator&& estimate_error, Solver&& solve,
+                             const InnerProductInterface<F>& inner_product = EuclideanInnerProduct<F>(),
+                             const WeakGreedyOptions& options = {})
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    if (training_set_size <= 0 || options.max_extensions < 0 || options.tolerance < 0)
+    {
+        throw InvalidArgumentError("weak_greedy: invalid training set size or options");
+    }
+    const auto elapsed_since = [](std::chrono::steady_clock::time_point start)
+    {
+        return milliseconds(std::chrono::steady_clock::now() - start).count();
+    };
+    const VectorArrayInterface<F>& const_basis = basis;
+    WeakGreedyReport report;
+    ssize_t num_extensions = 0;
+    std::vector<double> errors(as_size_t(training_set_size));
+    while (true)
+    {
+        auto& iteration = report.iterations.emplace_back();
+        auto start = std::chrono::steady_clock::now();
+        parallel_for(
+            0, training_set_size,
+            [&](ssize_t i)
+            {
+                errors[as_size_t(i)] = double(estimate_error(const_basis, i));
+            },
+            options.num_threads);
+        iteration.estimation_milliseconds = elapsed_since(start);
+        // (the first NaN is selected, so broken estimators do not go unnoticed)
+        iteration.selected_index = 0;
+        for (ssize_t i = 1; i < training_set_size && !std::isnan(errors[as_size_t(iteration.selected_index)]);
+             ++i)
+        {
+            if (!(errors[as_size_t(i)] <= errors[as_size_t(iteration.selected_index)]))
+            {
+                iteration.selected_index = i;
+            }
+        }
+        iteration.max_error = errors[as_size_t(iteration.selected_index)];
+        report.max_error = iteration.max_error;
+        if (iteration.max_error <= options.tolerance)
+        {
+            report.converged = true;
+            break;
+        }
+        if (num_extensions >= options.max_extensions)
+        {
+            break;
+        }
+        start = std::chrono::steady_clock::now();
+        const std::shared_ptr<VectorArrayInterface<F>> snapshots = solve(iteration.selected_index);
+        iteration.solve_milliseconds = elapsed_since(start);
+        start = std::chrono::steady_clock::now();
+        const auto new_vectors = snapshots->copy();
+        orthonormalize(inner_product, &const_basis, *new_vectors, 1);
+        basis.append(*new_vectors);
+        iteration.num_appended = new_vectors->size();
+        iteration.orthonormalization_milliseconds = elapsed_since(start);
+        ++num_extensions;
+        if (iteration.num_appended == 0)
+        {
+            // the snapshots are already contained in the basis, further iterations would select them again
+            break;
+        }
+    }
+    return report;
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_ALGORITHMS_WEAK_GREEDY_H
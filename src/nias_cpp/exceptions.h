@@ -60,6 +60,12 @@ class NotImplementedError : public ErrorInNiasCpp
     using ErrorInNiasCpp::ErrorInNiasCpp;
 };
 
+class IOError : public ErrorInNiasCpp
+{
+   public:
+    using ErrorInNiasCpp::ErrorInNiasCpp;
+};
+
 
 }  // namespace nias
 
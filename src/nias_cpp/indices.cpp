@@ -3,6 +3,7 @@
 #include <array>
 #include <functional>
 #include <initializer_list>
+#include <optional>
 #include <set>
 #include <utility>
 #include <variant>
@@ -11,7 +12,6 @@
 #include <nias_cpp/checked_integer_cast.h>
 #include <nias_cpp/exceptions.h>
 #include <nias_cpp/type_traits.h>
-#include <pybind11/pytypes.h>
 
 namespace nias
 {
@@ -36,9 +36,14 @@ Indices::Indices(const std::set<ssize_t>& indices)
 {
 }
 
-Indices::Indices(const pybind11::slice& slice)
-    : indices_(new ValueType(slice))
+Indices::Indices(const SliceData& slice)
+    : indices_(nullptr)
 {
+    if (slice.step == 0)
+    {
+        throw InvalidArgumentError("Slice step cannot be zero");
+    }
+    indices_ = new ValueType(slice);
 }
 
 Indices::Indices(std::initializer_list<ssize_t> indices)
@@ -125,21 +130,10 @@ void Indices::for_each(const std::function<void(ssize_t)>& func, ssize_t length)
     }
     else
     {
-        auto [start, stop, step, slicelength] = compute(length);
-        if (step > 0)
-        {
-            for (ssize_t i = start; i < stop; i += step)
-            {
-                func(i);
-            }
-        }
-        else
+        const auto [start, stop, step, slicelength] = compute(length);
+        for (ssize_t i = 0; i < slicelength; ++i)
         {
-            // TODO: check if this is correct
-            for (ssize_t i = start; i >= stop; i += step)
-            {
-                func(i);
-            }
+            func(start + (i * step));
         }
     }
 }
@@ -156,22 +150,10 @@ std::vector<ssize_t> Indices::as_vec(ssize_t length) const
         return indices;
     }
     const auto [start, stop, step, slicelength] = compute(length);
-    std::vector<ssize_t> indices;
-    indices.reserve(as_size_t(slicelength));
-    if (step > 0)
-    {
-        for (ssize_t i = start; i < stop; i += step)
-        {
-            indices.push_back(i);
-        }
-    }
-    else
+    std::vector<ssize_t> indices(as_size_t(slicelength));
+    for (ssize_t i = 0; i < slicelength; ++i)
     {
-        // TODO: check if this is correct
-        for (ssize_t i = start; i >= stop; i += step)
-        {
-            indices.push_back(i);
-        }
+        indices[as_size_t(i)] = start + (i * step);
     }
     return indices;
 }
@@ -188,15 +170,45 @@ std::array<ssize_t, 4> Indices::compute(ssize_t length) const
     {
         throw InvalidStateError("compute can only be called if indices_ holds a slice");
     }
-    ssize_t start = 0;
-    ssize_t stop = 0;
-    ssize_t step = 0;
-    ssize_t slicelength = 0;
-    // slice.compute calls PySlice_GetIndicesEx (from the Python C-API) which in turn calls PySlice_Unpack and then PySlice_AdjustIndices, see
+    // This mirrors PySlice_Unpack and PySlice_AdjustIndices from the Python C-API, see
     // https://github.com/python/cpython/blob/main/Objects/sliceobject.c
-    // length is the length of the sequence which the slice is applied to, and slicelength is the length of the resulting slice (number of indices in the slice)
-    // PySlice_AdjustIndices adjust start and stop indices automatically to fit within the bounds of the sequence (depending on the sign of step)
-    std::get<pybind11::slice>(*indices_).compute(length, &start, &stop, &step, &slicelength);
+    // length is the length of the sequence which the slice is applied to, and slicelength is the length of
+    // the resulting slice (number of indices in the slice). Start and stop indices are adjusted to fit within
+    // the bounds of the sequence (depending on the sign of step), so slices never go out of range.
+    const auto& slice = std::get<SliceData>(*indices_);
+    const ssize_t step = slice.step.value_or(1);
+    const auto adjust = [length, step](std::optional<ssize_t> index, ssize_t default_index)
+    {
+        if (!index)
+        {
+            return default_index;
+        }
+        ssize_t ret = *index;
+        if (ret < 0)
+        {
+            ret += length;
+            if (ret < 0)
+            {
+                ret = (step < 0) ? -1 : 0;
+            }
+        }
+        else if (ret >= length)
+        {
+            ret = (step < 0) ? length - 1 : length;
+        }
+        return ret;
+    };
+    const ssize_t start = adjust(slice.start, (step < 0) ? length - 1 : 0);
+    const ssize_t stop = adjust(slice.stop, (step < 0) ? -1 : length);
+    ssize_t slicelength = 0;
+    if (step < 0 && stop < start)
+    {
+        slicelength = ((start - stop - 1) / (-step)) + 1;
+    }
+    else if (step > 0 && start < stop)
+    {
+        slicelength = ((stop - start - 1) / step) + 1;
+    }
     return {start, stop, step, slicelength};
 }
 
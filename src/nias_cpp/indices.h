@@ -4,23 +4,38 @@
 #include <array>
 #include <functional>
 #include <initializer_list>
+#include <numeric>
 #include <optional>
 #include <set>
 #include <variant>
 #include <vector>
 
+#include <nias_cpp/checked_integer_cast.h>
 #include <nias_cpp/type_traits.h>
-#include <pybind11/pytypes.h>
 
-#include "nias_cpp_export.h"
+#include "nias_cpp_core_export.h"
 
 namespace nias
 {
 
 
-class NIAS_CPP_EXPORT Indices
+/**
+ * \brief Python-style slice <tt>start:stop:step</tt>
+ *
+ * Empty values have the same meaning as omitted values in Python, i.e., they are replaced by the
+ * respective end of the sequence (depending on the sign of \c step) once the length of the sequence
+ * the slice is applied to is known.
+ */
+struct SliceData
 {
-    using ValueType = std::variant<std::vector<ssize_t>, pybind11::slice>;
+    std::optional<ssize_t> start;
+    std::optional<ssize_t> stop;
+    std::optional<ssize_t> step;
+};
+
+class NIAS_CPP_CORE_EXPORT Indices
+{
+    using ValueType = std::variant<std::vector<ssize_t>, SliceData>;
 
    public:
     /// The default constructor initializes indices_ to an empty vector
@@ -35,8 +50,8 @@ class NIAS_CPP_EXPORT Indices
     /// Construct from a set of indices
     explicit(false) Indices(const std::set<ssize_t>& indices);
 
-    /// Construct from a Python slice
-    explicit(false) Indices(const pybind11::slice& slice);
+    /// Construct from a slice (throws if the step is zero)
+    explicit(false) Indices(const SliceData& slice);
 
     /// Construct from a list of indices
     Indices(std::initializer_list<ssize_t> indices);
@@ -92,7 +107,7 @@ class NIAS_CPP_EXPORT Indices
     [[nodiscard]] std::set<ssize_t> unique_indices(ssize_t length) const;
 
    private:
-    // compute start, stop, step, and slicelength for a slice
+    // compute start, stop, step, and slicelength for a slice (same semantics as Python's slice.indices)
     [[nodiscard]] std::array<ssize_t, 4> compute(ssize_t length) const;
 
     // a valid index i for a sequence of length n in Python fulfills  -n <= i <= n-1
@@ -110,18 +125,33 @@ class NIAS_CPP_EXPORT Indices
     ValueType* indices_;
 };
 
-// Convenience class to not have to write Indices(pybind11::slice(start, stop, step)) when creating a slice
+// Convenience class to not have to write Indices(SliceData{start, stop, step}) when creating a slice
 // TODO: Drop this class?
-class NIAS_CPP_EXPORT Slice : public Indices
+class NIAS_CPP_CORE_EXPORT Slice : public Indices
 {
    public:
     Slice(std::optional<ssize_t> start, std::optional<ssize_t> stop,
           std::optional<ssize_t> step = std::nullopt)
-        : Indices(pybind11::slice(start, stop, step))
+        : Indices(SliceData{start, stop, step})
     {
     }
 };
 
+/**
+ * \brief Returns the (validated) indices as a vector (all indices in [0, length) for std::nullopt)
+ */
+[[nodiscard]] inline std::vector<ssize_t> index_vector(const std::optional<Indices>& indices, ssize_t length)
+{
+    if (!indices)
+    {
+        std::vector<ssize_t> ret(as_size_t(length));
+        std::iota(ret.begin(), ret.end(), ssize_t(0));
+        return ret;
+    }
+    indices->check_valid(length);
+    return indices->as_vec(length);
+}
+
 
 }  // namespace nias
 
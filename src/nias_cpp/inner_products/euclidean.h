@@ -1,13 +1,19 @@
 #ifndef NIAS_CPP_INNER_PRODUCTS_EUCLIDEAN_H
 #define NIAS_CPP_INNER_PRODUCTS_EUCLIDEAN_H
 
+#include <complex>
+#include <optional>
+#include <vector>
+
 #include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/checked_integer_cast.h>
 #include <nias_cpp/concepts.h>
 #include <nias_cpp/exceptions.h>
 #include <nias_cpp/indices.h>
 #include <nias_cpp/inner_products/function_based.h>
 #include <nias_cpp/interfaces/inner_products.h>
 #include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
 
 namespace nias
 {
@@ -20,24 +26,29 @@ class EuclideanInnerProduct : public InnerProductInterface<F>
     using InterfaceType = InnerProductInterface<F>;
     using typename InterfaceType::ScalarType;
 
+    // Both methods delegate to the vector array, which may provide an optimized implementation.
+    // If only the right array prefers computing the inner products (e.g., a sparse array, see
+    // VectorArrayInterface::prefers_computing_inner_products), the conjugated products are computed by it.
     [[nodiscard]] std::vector<std::vector<F>> apply(
         const VectorArrayInterface<ScalarType>& left, const VectorArrayInterface<ScalarType>& right,
         const std::optional<Indices>& left_indices = std::nullopt,
         const std::optional<Indices>& right_indices = std::nullopt) const override
     {
-        if (left_indices || right_indices)
-        {
-            return apply(left[left_indices], right[right_indices], std::nullopt, std::nullopt);
-        }
-        std::vector<std::vector<F>> ret(as_size_t(left.size()), std::vector<F>(as_size_t(right.size())));
-        for (ssize_t i = 0; i < left.size(); ++i)
+        if (!left.prefers_computing_inner_products() && right.prefers_computing_inner_products())
         {
-            for (ssize_t j = 0; j < right.size(); ++j)
+            const auto transposed = right.inner(left, right_indices, left_indices);
+            const auto num_left = as_size_t(left_indices ? left_indices->size(left.size()) : left.size());
+            std::vector<std::vector<F>> ret(num_left, std::vector<F>(transposed.size()));
+            for (size_t i = 0; i < transposed.size(); ++i)
             {
-                ret[as_size_t(i)][as_size_t(j)] = dot_product(left, right, {i}, {j})[0];
+                for (size_t j = 0; j < num_left; ++j)
+                {
+                    ret[j][i] = conj_if_complex(transposed[i][j]);
+                }
             }
+            return ret;
         }
-        return ret;
+        return left.inner(right, left_indices, right_indices);
     }
 
     [[nodiscard]] std::vector<F> apply_pairwise(
@@ -45,7 +56,16 @@ class EuclideanInnerProduct : public InnerProductInterface<F>
         const std::optional<Indices>& left_indices = std::nullopt,
         const std::optional<Indices>& right_indices = std::nullopt) const override
     {
-        return dot_product(left, right, left_indices, right_indices);
+        if (!left.prefers_computing_inner_products() && right.prefers_computing_inner_products())
+        {
+            auto ret = right.pairwise_inner(left, right_indices, left_indices);
+            for (auto& value : ret)
+            {
+                value = conj_if_complex(value);
+            }
+            return ret;
+        }
+        return left.pairwise_inner(right, left_indices, right_indices);
     }
 };
 
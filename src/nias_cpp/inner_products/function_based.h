@@ -1,9 +1,12 @@
 #ifndef NIAS_CPP_INNER_PRODUCTS_FUNCTION_BASED_H
 #define NIAS_CPP_INNER_PRODUCTS_FUNCTION_BASED_H
 
+#include <algorithm>
 #include <functional>
+#include <numeric>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <nias_cpp/algorithms/dot_product.h>
 #include <nias_cpp/checked_integer_cast.h>
@@ -12,12 +15,29 @@
 #include <nias_cpp/indices.h>
 #include <nias_cpp/interfaces/inner_products.h>
 #include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
 #include <nias_cpp/type_traits.h>
 
 namespace nias
 {
 
 
+/**
+ * \brief Inner product defined by a user-supplied function
+ *
+ * The inner product can either be given by a function operating on a single pair of vectors
+ * or by a block function which computes the inner products of a block of left vectors with a
+ * block of right vectors at once (useful if evaluating the inner product has a significant setup
+ * cost that can be amortized over several vectors).
+ *
+ * In both cases, \c apply splits the result matrix into tiles of (at most) <tt>tile_size x tile_size</tt>
+ * entries which are distributed over \c num_threads threads. If \c left and \c right are the same
+ * array (and the same indices are used), only the tiles in the upper triangle are computed and the
+ * remaining entries are obtained from the Hermitian symmetry of the inner product.
+ *
+ * \note With <tt>num_threads != 1</tt>, the inner product function is called concurrently from
+ * several threads, so it (and the vectors it accesses) has to be thread-safe.
+ */
 template <floating_point_or_complex F>
 class VectorFunctionBasedInnerProduct : public InnerProductInterface<F>
 {
@@ -25,12 +45,53 @@ class VectorFunctionBasedInnerProduct : public InnerProductInterface<F>
     using InterfaceType = InnerProductInterface<F>;
     using ThisType = VectorFunctionBasedInnerProduct<F>;
     using typename InterfaceType::ScalarType;
+    using VectorFunctionType =
+        std::function<ScalarType(const VectorInterface<ScalarType>&, const VectorInterface<ScalarType>&)>;
+    using BlockFunctionType = std::function<std::vector<std::vector<ScalarType>>(
+        const VectorArrayInterface<ScalarType>&, const VectorArrayInterface<ScalarType>&)>;
 
-    explicit VectorFunctionBasedInnerProduct(
-        std::function<ScalarType(const VectorInterface<ScalarType>&, const VectorInterface<ScalarType>&)>
-            inner_product_function)
+    static constexpr ssize_t default_tile_size = 32;
+
+    /**
+     * \brief Construct from a function computing the inner product of two vectors
+     *
+     * \param num_threads: Number of threads used in apply and apply_pairwise (0 means all hardware threads).
+     * \param tile_size: Number of rows/columns of the tiles the result is split into.
+     */
+    explicit VectorFunctionBasedInnerProduct(VectorFunctionType inner_product_function,
+                                             ssize_t num_threads = 1,
+                                             ssize_t tile_size = default_tile_size)
         : inner_product_function_(std::move(inner_product_function))
+        , num_threads_(num_threads)
+        , tile_size_(tile_size)
+    {
+        check_parameters();
+    }
+
+    /**
+     * \brief Construct from a block function
+     *
+     * The block function is called with a (view of a) block of left vectors and a block of right vectors
+     * and has to return the <tt>(left_block.size() x right_block.size())</tt> matrix of inner products.
+     *
+     * \note This is a named constructor (instead of a constructor overload) since generic lambdas
+     * could not be unambiguously converted to either of the two function types.
+     */
+    [[nodiscard]] static ThisType from_block_function(BlockFunctionType block_function,
+                                                      ssize_t num_threads = 1,
+                                                      ssize_t tile_size = default_tile_size)
+    {
+        return ThisType(std::move(block_function), num_threads, tile_size);
+    }
+
+    [[nodiscard]] ssize_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    [[nodiscard]] ssize_t tile_size() const
     {
+        return tile_size_;
     }
 
     [[nodiscard]] std::vector<std::vector<F>> apply(
@@ -40,17 +101,10 @@ class VectorFunctionBasedInnerProduct : public InnerProductInterface<F>
     {
         if (left_indices || right_indices)
         {
-            return apply(left[left_indices], right[right_indices], std::nullopt, std::nullopt);
+            const bool symmetric = &left == &right && same_indices(left, left_indices, right_indices);
+            return apply_tiled(left[left_indices], right[right_indices], symmetric);
         }
-        std::vector<std::vector<F>> ret(as_size_t(left.size()), std::vector<F>(as_size_t(right.size())));
-        for (ssize_t i = 0; i < left.size(); ++i)
-        {
-            for (ssize_t j = 0; j < right.size(); ++j)
-            {
-                ret[as_size_t(i)][as_size_t(j)] = inner_product_function_(left.vector(i), right.vector(j));
-            }
-        }
-        return ret;
+        return apply_tiled(left, right, &left == &right);
     }
 
     [[nodiscard]] std::vector<F> apply_pairwise(
@@ -67,16 +121,163 @@ class VectorFunctionBasedInnerProduct : public InnerProductInterface<F>
             throw InvalidArgumentError("Vector arrays must have the same size for pairwise application.");
         }
         std::vector<F> ret(as_size_t(left.size()));
-        for (ssize_t i = 0; i < left.size(); ++i)
+        const auto num_tiles = num_blocks(left.size());
+        parallel_for(
+            0, num_tiles,
+            [&](ssize_t tile)
+            {
+                const auto [begin, end] = block_range(tile, left.size());
+                for (ssize_t i = begin; i < end; ++i)
+                {
+                    ret[as_size_t(i)] = evaluate_pair(left, right, i, i);
+                }
+            },
+            num_threads_);
+        return ret;
+    }
+
+   private:
+    VectorFunctionBasedInnerProduct(BlockFunctionType block_function, ssize_t num_threads, ssize_t tile_size)
+        : block_function_(std::move(block_function))
+        , num_threads_(num_threads)
+        , tile_size_(tile_size)
+    {
+        check_parameters();
+    }
+
+    void check_parameters() const
+    {
+        if (tile_size_ <= 0)
+        {
+            throw InvalidArgumentError("VectorFunctionBasedInnerProduct: tile_size must be positive.");
+        }
+        static_cast<void>(effective_num_threads(num_threads_));
+    }
+
+    // Checks whether left_indices and right_indices select the same vectors of vec_array
+    [[nodiscard]] static bool same_indices(const VectorArrayInterface<ScalarType>& vec_array,
+                                           const std::optional<Indices>& left_indices,
+                                           const std::optional<Indices>& right_indices)
+    {
+        if (!left_indices || !right_indices)
+        {
+            return !left_indices && !right_indices;
+        }
+        return left_indices->as_vec(vec_array.size()) == right_indices->as_vec(vec_array.size());
+    }
+
+    [[nodiscard]] ssize_t num_blocks(ssize_t length) const
+    {
+        return (length + tile_size_ - 1) / tile_size_;
+    }
+
+    [[nodiscard]] std::pair<ssize_t, ssize_t> block_range(ssize_t block, ssize_t length) const
+    {
+        return {block * tile_size_, std::min(length, (block + 1) * tile_size_)};
+    }
+
+    [[nodiscard]] static Indices range_indices(ssize_t begin, ssize_t end)
+    {
+        std::vector<ssize_t> indices(as_size_t(end - begin));
+        std::iota(indices.begin(), indices.end(), begin);
+        return indices;
+    }
+
+    [[nodiscard]] F evaluate_pair(const VectorArrayInterface<ScalarType>& left,
+                                  const VectorArrayInterface<ScalarType>& right, ssize_t i, ssize_t j) const
+    {
+        if (inner_product_function_)
+        {
+            return inner_product_function_(left.vector(i), right.vector(j));
+        }
+        const auto result = block_function_(left[Indices(i)], right[Indices(j)]);
+        check_tile_shape(result, 1, 1);
+        return result[0][0];
+    }
+
+    static void check_tile_shape(const std::vector<std::vector<F>>& tile, ssize_t rows, ssize_t cols)
+    {
+        if (std::ssize(tile) != rows || std::ranges::any_of(tile,
+                                                            [cols](const auto& row)
+                                                            {
+                                                                return std::ssize(row) != cols;
+                                                            }))
+        {
+            throw InvalidStateError(
+                "VectorFunctionBasedInnerProduct: block function returned a result of wrong shape.");
+        }
+    }
+
+    // Computes the entries (i, j) with i in [row_begin, row_end) and j in [col_begin, col_end)
+    void compute_tile(const VectorArrayInterface<ScalarType>& left,
+                      const VectorArrayInterface<ScalarType>& right, std::vector<std::vector<F>>& ret,
+                      std::pair<ssize_t, ssize_t> rows, std::pair<ssize_t, ssize_t> cols) const
+    {
+        const auto [row_begin, row_end] = rows;
+        const auto [col_begin, col_end] = cols;
+        if (inner_product_function_)
         {
-            ret[as_size_t(i)] = inner_product_function_(left.vector(i), right.vector(i));
+            for (ssize_t i = row_begin; i < row_end; ++i)
+            {
+                for (ssize_t j = col_begin; j < col_end; ++j)
+                {
+                    ret[as_size_t(i)][as_size_t(j)] =
+                        inner_product_function_(left.vector(i), right.vector(j));
+                }
+            }
+            return;
+        }
+        const auto tile = block_function_(left[range_indices(row_begin, row_end)],
+                                          right[range_indices(col_begin, col_end)]);
+        check_tile_shape(tile, row_end - row_begin, col_end - col_begin);
+        for (ssize_t i = row_begin; i < row_end; ++i)
+        {
+            std::ranges::copy(tile[as_size_t(i - row_begin)], ret[as_size_t(i)].begin() + col_begin);
+        }
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> apply_tiled(const VectorArrayInterface<ScalarType>& left,
+                                                          const VectorArrayInterface<ScalarType>& right,
+                                                          bool symmetric) const
+    {
+        std::vector<std::vector<F>> ret(as_size_t(left.size()), std::vector<F>(as_size_t(right.size())));
+        const auto num_row_blocks = num_blocks(left.size());
+        const auto num_col_blocks = num_blocks(right.size());
+        // list of (row block, column block) pairs that have to be computed
+        std::vector<std::pair<ssize_t, ssize_t>> tiles;
+        for (ssize_t bi = 0; bi < num_row_blocks; ++bi)
+        {
+            for (ssize_t bj = symmetric ? bi : 0; bj < num_col_blocks; ++bj)
+            {
+                tiles.emplace_back(bi, bj);
+            }
+        }
+        parallel_for(
+            0, std::ssize(tiles),
+            [&](ssize_t t)
+            {
+                const auto [bi, bj] = tiles[as_size_t(t)];
+                compute_tile(left, right, ret, block_range(bi, left.size()), block_range(bj, right.size()));
+            },
+            num_threads_);
+        if (symmetric)
+        {
+            // fill the tiles below the diagonal using (u, v) = conj((v, u))
+            for (ssize_t i = 0; i < left.size(); ++i)
+            {
+                for (ssize_t j = 0; j < block_range(i / tile_size_, left.size()).first; ++j)
+                {
+                    ret[as_size_t(i)][as_size_t(j)] = conj_if_complex(ret[as_size_t(j)][as_size_t(i)]);
+                }
+            }
         }
         return ret;
     }
 
-   private:
-    std::function<ScalarType(const VectorInterface<ScalarType>&, const VectorInterface<ScalarType>&)>
-        inner_product_function_;
+    VectorFunctionType inner_product_function_;
+    BlockFunctionType block_function_;
+    ssize_t num_threads_;
+    ssize_t tile_size_;
 };
 
 
@@ -0,0 +1,114 @@
+#ifndef NIAS_CPP_INNER_PRODUCTS_OPERATOR_BASED_H
+#define NIAS_CPP_INNER_PRODUCTS_OPERATOR_BASED_H
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Inner product <tt>(u, v) = u^H M v</tt> given by a (Hermitian positive definite) operator \c M
+ *
+ * E.g., L2 or energy inner products given by a sparse mass or stiffness matrix (see CsrMatrixOperator).
+ * \c apply applies \c M to all right vectors at once and then delegates the inner products of the left
+ * vectors with the result to the left vector array (which may provide an optimized implementation).
+ *
+ * Since vector arrays can be modified in place, products <tt>M v</tt> are only reused if this is requested
+ * explicitly: after <tt>cache_right_array(v)</tt>, all calls with \c v as right array (and any right indices)
+ * use the stored product until the cache is cleared or the version of \c v (see
+ * VectorArrayInterface::version) changes. Changes which bypass the VectorArray interface cannot be
+ * detected, call clear_cache after such changes.
+ */
+template <floating_point_or_complex F>
+class OperatorBasedInnerProduct : public InnerProductInterface<F>
+{
+   public:
+    using InterfaceType = InnerProductInterface<F>;
+    using typename InterfaceType::ScalarType;
+    using OperatorType = OperatorInterface<ScalarType>;
+    using VectorArrayType = VectorArrayInterface<ScalarType>;
+
+    explicit OperatorBasedInnerProduct(std::shared_ptr<const OperatorType> op)
+        : op_(std::move(op))
+    {
+        if (op_ == nullptr || op_->source_dim() != op_->range_dim())
+        {
+            throw InvalidArgumentError("OperatorBasedInnerProduct: operator must be square.");
+        }
+    }
+
+    [[nodiscard]] const OperatorType& op() const
+    {
+        return *op_;
+    }
+
+    /**
+     * \brief Applies the operator to all vectors of \c right and stores the result
+     *
+     * Replaces a previously cached array.
+     */
+    void cache_right_array(std::shared_ptr<const VectorArrayType> right)
+    {
+        cached_product_ = op_->apply(*right);
+        cached_version_ = right->version();
+        cached_right_ = std::move(right);
+    }
+
+    void clear_cache()
+    {
+        cached_right_.reset();
+        cached_product_.reset();
+    }
+
+    [[nodiscard]] bool is_cached(const VectorArrayType& right) const
+    {
+        return cached_right_.get() == &right && right.version() == cached_version_;
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> apply(
+        const VectorArrayType& left, const VectorArrayType& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const override
+    {
+        if (is_cached(right))
+        {
+            return left.inner(*cached_product_, left_indices, right_indices);
+        }
+        return left.inner(*op_->apply(right, right_indices), left_indices);
+    }
+
+    [[nodiscard]] std::vector<F> apply_pairwise(
+        const VectorArrayType& left, const VectorArrayType& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const override
+    {
+        if (is_cached(right))
+        {
+            return left.pairwise_inner(*cached_product_, left_indices, right_indices);
+        }
+        return left.pairwise_inner(*op_->apply(right, right_indices), left_indices);
+    }
+
+   private:
+    std::shared_ptr<const OperatorType> op_;
+    std::shared_ptr<const VectorArrayType> cached_right_;
+    std::shared_ptr<const VectorArrayType> cached_product_;
+    VectorArrayVersion cached_version_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_INNER_PRODUCTS_OPERATOR_BASED_H
@@ -0,0 +1,287 @@
+#ifndef NIAS_CPP_INNER_PRODUCTS_WEIGHTED_EUCLIDEAN_H
+#define NIAS_CPP_INNER_PRODUCTS_WEIGHTED_EUCLIDEAN_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Weighted Euclidean inner product <tt>(u, v) = sum_k w_k conj(u_k) v_k</tt> (e.g., for lumped mass
+ * matrices)
+ *
+ * The weights are applied inside the summation loops (no weighted copies of the vectors are created). The
+ * loops use \c simd_width independent partial sums (of the real and imaginary parts for complex \c F), so
+ * the compiler can vectorize them without reordering floating point operations, and Gram matrices are
+ * computed in blocks of \c block_length entries per vector, so the blocks of all vectors involved stay in
+ * cache. If \c left and \c right are the same array (and the same indices are used), only the upper
+ * triangle of the Gram matrix is computed. Products of a vector with itself (e.g., in the induced norm) only
+ * sum up <tt>w_k |u_k|^2</tt>.
+ *
+ * The entries of C-order MappedNpyVectorArrays are read directly, all other arrays are copied into a
+ * contiguous buffer (using \c get) first.
+ */
+template <floating_point_or_complex F>
+class WeightedEuclideanInnerProduct : public InnerProductInterface<F>
+{
+   public:
+    using InterfaceType = InnerProductInterface<F>;
+    using typename InterfaceType::ScalarType;
+    using RealType = typename VectorArrayInterface<F>::RealType;
+
+    /// Number of independent partial sums in reductions
+    static constexpr ssize_t simd_width = 8;
+    /// Number of entries per vector processed at once when computing Gram matrices (to keep them in cache)
+    static constexpr ssize_t block_length = 1024;
+
+    /// Construct from the (positive) weights, the dimension of the vectors is the number of weights
+    explicit WeightedEuclideanInnerProduct(std::vector<RealType> weights)
+        : weights_(std::move(weights))
+    {
+        if (!std::ranges::all_of(weights_,
+                                 [](RealType weight)
+                                 {
+                                     return weight > 0 && std::isfinite(weight);
+                                 }))
+        {
+            throw InvalidArgumentError("WeightedEuclideanInnerProduct: weights must be positive and finite.");
+        }
+    }
+
+    [[nodiscard]] const std::vector<RealType>& weights() const
+    {
+        return weights_;
+    }
+
+    [[nodiscard]] ssize_t dim() const
+    {
+        return std::ssize(weights_);
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> apply(
+        const VectorArrayInterface<ScalarType>& left, const VectorArrayInterface<ScalarType>& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const override
+    {
+        const Rows left_rows(*this, left, left_indices);
+        const bool symmetric = &left == &right && index_vector(left_indices, left.size()) ==
+                                                       index_vector(right_indices, right.size());
+        const Rows right_rows = symmetric ? left_rows : Rows(*this, right, right_indices);
+        const auto num_left = std::ssize(left_rows.rows);
+        const auto num_right = std::ssize(right_rows.rows);
+        std::vector<std::vector<F>> ret(as_size_t(num_left), std::vector<F>(as_size_t(num_right), F(0)));
+        for (ssize_t begin = 0; begin < dim(); begin += block_length)
+        {
+            const auto end = std::min(dim(), begin + block_length);
+            for (ssize_t i = 0; i < num_left; ++i)
+            {
+                const F* const u = left_rows.rows[as_size_t(i)];
+                auto& row = ret[as_size_t(i)];
+                if (symmetric)
+                {
+                    row[as_size_t(i)] += F(norm2(u, begin, end));
+                }
+                for (ssize_t j = symmetric ? i + 1 : 0; j < num_right; ++j)
+                {
+                    row[as_size_t(j)] += dot(u, right_rows.rows[as_size_t(j)], begin, end);
+                }
+            }
+        }
+        if (symmetric)
+        {
+            for (ssize_t i = 0; i < num_left; ++i)
+            {
+                for (ssize_t j = 0; j < i; ++j)
+                {
+                    ret[as_size_t(i)][as_size_t(j)] = conj_if_complex(ret[as_size_t(j)][as_size_t(i)]);
+                }
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> apply_pairwise(
+        const VectorArrayInterface<ScalarType>& left, const VectorArrayInterface<ScalarType>& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const override
+    {
+        const Rows left_rows(*this, left, left_indices);
+        const bool same = &left == &right && index_vector(left_indices, left.size()) ==
+                                                  index_vector(right_indices, right.size());
+        const Rows right_rows = same ? left_rows : Rows(*this, right, right_indices);
+        if (left_rows.rows.size() != right_rows.rows.size())
+        {
+            throw InvalidArgumentError("Vector arrays must have the same size for pairwise application.");
+        }
+        std::vector<F> ret(left_rows.rows.size());
+        for (size_t i = 0; i < ret.size(); ++i)
+        {
+            const F* const u = left_rows.rows[i];
+            const F* const v = right_rows.rows[i];
+            ret[i] = u == v ? F(norm2(u, 0, dim())) : dot(u, v, 0, dim());
+        }
+        return ret;
+    }
+
+   private:
+    // Pointers to the (contiguous) entries of the selected vectors of an array
+    struct Rows
+    {
+        Rows(const WeightedEuclideanInnerProduct& inner_product, const VectorArrayInterface<F>& vec_array,
+             const std::optional<Indices>& indices)
+        {
+            if (vec_array.dim() != inner_product.dim())
+            {
+                throw InvalidArgumentError(
+                    "WeightedEuclideanInnerProduct: vectors and weights have different dimensions.");
+            }
+            const auto dim = vec_array.dim();
+            const auto index_vec = index_vector(indices, vec_array.size());
+            rows.reserve(index_vec.size());
+            const auto* mapped = dynamic_cast<const MappedNpyVectorArray<F>*>(&vec_array);
+            if (mapped != nullptr && !mapped->fortran_order())
+            {
+                for (const auto index : index_vec)
+                {
+                    rows.push_back(mapped->data() + (index * dim));
+                }
+                return;
+            }
+            // the buffer is not resized after the pointers have been computed, so they stay valid
+            buffer = std::make_shared<std::vector<F>>(index_vec.size() * as_size_t(dim));
+            for (size_t i = 0; i < index_vec.size(); ++i)
+            {
+                F* const row = buffer->data() + (i * as_size_t(dim));
+                for (ssize_t j = 0; j < dim; ++j)
+                {
+                    row[j] = vec_array.get(index_vec[i], j);
+                }
+                rows.push_back(row);
+            }
+        }
+
+        std::vector<const F*> rows;
+        std::shared_ptr<std::vector<F>> buffer;
+    };
+
+    [[nodiscard]] static RealType abs2(const F& value)
+    {
+        if constexpr (complex<F>)
+        {
+            return (value.real() * value.real()) + (value.imag() * value.imag());
+        }
+        else
+        {
+            return value * value;
+        }
+    }
+
+    template <class T>
+    [[nodiscard]] static T sum(const std::array<T, simd_width>& values)
+    {
+        T ret(0);
+        for (const T& value : values)
+        {
+            ret += value;
+        }
+        return ret;
+    }
+
+    // Weighted inner product of the entries [begin, end) of u (conjugated) and v
+    [[nodiscard]] F dot(const F* u, const F* v, ssize_t begin, ssize_t end) const
+    {
+        const RealType* const w = weights_.data();
+        if constexpr (complex<F>)
+        {
+            // complex multiplications are not vectorized, so we sum up the real and imaginary parts
+            // separately (std::complex is guaranteed to be stored as an array of real and imaginary part)
+            const auto* const u_parts = reinterpret_cast<const RealType*>(u);
+            const auto* const v_parts = reinterpret_cast<const RealType*>(v);
+            std::array<RealType, simd_width> real_sums{};
+            std::array<RealType, simd_width> imag_sums{};
+            const auto add = [&](ssize_t l, ssize_t k)
+            {
+                const RealType u_re = u_parts[2 * k];
+                const RealType u_im = u_parts[(2 * k) + 1];
+                const RealType v_re = v_parts[2 * k];
+                const RealType v_im = v_parts[(2 * k) + 1];
+                real_sums[as_size_t(l)] += w[k] * ((u_re * v_re) + (u_im * v_im));
+                imag_sums[as_size_t(l)] += w[k] * ((u_re * v_im) - (u_im * v_re));
+            };
+            ssize_t k = begin;
+            for (; k + simd_width <= end; k += simd_width)
+            {
+                for (ssize_t l = 0; l < simd_width; ++l)
+                {
+                    add(l, k + l);
+                }
+            }
+            for (; k < end; ++k)
+            {
+                add(0, k);
+            }
+            return F(sum(real_sums), sum(imag_sums));
+        }
+        else
+        {
+            std::array<F, simd_width> sums{};
+            ssize_t k = begin;
+            for (; k + simd_width <= end; k += simd_width)
+            {
+                for (ssize_t l = 0; l < simd_width; ++l)
+                {
+                    sums[as_size_t(l)] += w[k + l] * (u[k + l] * v[k + l]);
+                }
+            }
+            for (; k < end; ++k)
+            {
+                sums[0] += w[k] * (u[k] * v[k]);
+            }
+            return sum(sums);
+        }
+    }
+
+    // Weighted squared norm of the entries [begin, end) of u
+    [[nodiscard]] RealType norm2(const F* u, ssize_t begin, ssize_t end) const
+    {
+        const RealType* const w = weights_.data();
+        std::array<RealType, simd_width> sums{};
+        ssize_t k = begin;
+        for (; k + simd_width <= end; k += simd_width)
+        {
+            for (ssize_t l = 0; l < simd_width; ++l)
+            {
+                sums[as_size_t(l)] += w[k + l] * abs2(u[k + l]);
+            }
+        }
+        for (; k < end; ++k)
+        {
+            sums[0] += w[k] * abs2(u[k]);
+        }
+        return sum(sums);
+    }
+
+    std::vector<RealType> weights_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_INNER_PRODUCTS_WEIGHTED_EUCLIDEAN_H
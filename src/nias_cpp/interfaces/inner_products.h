@@ -9,7 +9,6 @@
 #include <nias_cpp/indices.h>
 #include <nias_cpp/interfaces/vectorarray.h>
 #include <nias_cpp/type_traits.h>
-#include <pybind11/numpy.h>
 
 namespace nias
 {
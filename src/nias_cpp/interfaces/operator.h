@@ -0,0 +1,79 @@
+#ifndef NIAS_CPP_INTERFACES_OPERATOR_H
+#define NIAS_CPP_INTERFACES_OPERATOR_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Interface for linear operators mapping vectors of dimension \c source_dim to vectors of dimension
+ * \c range_dim
+ *
+ * Operators are always applied to whole vector arrays (or subsets of them), so implementations can process
+ * all vectors at once instead of applying the operator vector by vector.
+ */
+template <floating_point_or_complex F>
+class OperatorInterface
+{
+   public:
+    using ScalarType = F;
+
+    OperatorInterface() = default;
+    OperatorInterface(const OperatorInterface&) = default;
+    OperatorInterface(OperatorInterface&&) = default;
+    OperatorInterface& operator=(const OperatorInterface&) = default;
+    OperatorInterface& operator=(OperatorInterface&&) = default;
+    virtual ~OperatorInterface() = default;
+
+    [[nodiscard]] virtual ssize_t source_dim() const = 0;
+
+    [[nodiscard]] virtual ssize_t range_dim() const = 0;
+
+    /**
+     * \brief Apply the operator to (a subset of) the vectors of \c vec_array
+     *
+     * \returns A new array containing the images of the vectors (in the order given by \c indices).
+     */
+    [[nodiscard]] virtual std::shared_ptr<VectorArrayInterface<ScalarType>> apply(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const = 0;
+
+    /**
+     * \brief Apply the adjoint operator (with respect to the Euclidean inner product) to (a subset of) the
+     * vectors of \c vec_array
+     *
+     * \c vec_array has to contain vectors of dimension \c range_dim, the returned vectors have dimension
+     * \c source_dim.
+     */
+    [[nodiscard]] virtual std::shared_ptr<VectorArrayInterface<ScalarType>> apply_adjoint(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const = 0;
+
+    /**
+     * \brief Computes the matrix <tt>(left_i, A right_j)</tt> (Euclidean inner products)
+     *
+     * The default implementation applies the operator to the right vectors and computes the inner products
+     * with the left vectors.
+     */
+    [[nodiscard]] virtual std::vector<std::vector<ScalarType>> apply2(
+        const VectorArrayInterface<ScalarType>& left, const VectorArrayInterface<ScalarType>& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const
+    {
+        return left.inner(*apply(right, right_indices), left_indices);
+    }
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_INTERFACES_OPERATOR_H
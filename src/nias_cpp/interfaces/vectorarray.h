@@ -1,11 +1,15 @@
 #ifndef NIAS_CPP_INTERFACES_VECTORARRAY_H
 #define NIAS_CPP_INTERFACES_VECTORARRAY_H
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <format>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <nias_cpp/checked_integer_cast.h>
@@ -20,6 +24,25 @@ namespace nias
 {
 
 
+/**
+ * \brief Counters for the operations which changed a VectorArray
+ *
+ * The counters of an array are only ever incremented, so if the version (and the size) of an array is
+ * unchanged, its content is unchanged. If only \c appends changed, the old vectors are unchanged and the
+ * new vectors are at the end of the array.
+ */
+struct VectorArrayVersion
+{
+    /// Number of append operations
+    ssize_t appends = 0;
+    /// Number of delete operations (including removals by append of another array)
+    ssize_t deletions = 0;
+    /// Number of operations which (may have) modified the entries of existing vectors
+    ssize_t modifications = 0;
+
+    bool operator==(const VectorArrayVersion&) const = default;
+};
+
 // forward
 template <floating_point_or_complex F>
 class VectorArrayInterface;
@@ -29,6 +52,7 @@ class ConstVectorArrayView : public VectorArrayInterface<F>
 {
     using ThisType = ConstVectorArrayView<F>;
     using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
 
    public:
     // TODO: Add some refcounting in the interface to throw if the underlying object is deleted and there is still a view
@@ -49,6 +73,12 @@ class ConstVectorArrayView : public VectorArrayInterface<F>
         return vec_array_.dim();
     }
 
+    /// Views have the version of the underlying array
+    [[nodiscard]] VectorArrayVersion version() const override
+    {
+        return vec_array_.version();
+    }
+
     [[nodiscard]] std::shared_ptr<InterfaceType> copy(
         const std::optional<Indices>& view_indices = std::nullopt) const override
     {
@@ -76,6 +106,55 @@ class ConstVectorArrayView : public VectorArrayInterface<F>
         throw NotImplementedError("ConstVectorArrayView: axpy is not implemented, use VectorArrayView.");
     }
 
+    // The bulk operations are forwarded to the viewed array to use its (possibly optimized) implementation
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& view_indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        return vec_array_.inner(other, new_indices(view_indices), other_indices);
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& view_indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        return vec_array_.pairwise_inner(other, new_indices(view_indices), other_indices);
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& view_indices = std::nullopt) const override
+    {
+        return vec_array_.norm2(new_indices(view_indices));
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& view_indices = std::nullopt) const override
+    {
+        return vec_array_.amax(new_indices(view_indices));
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        if (!indices_)
+        {
+            return vec_array_.lincomb(coefficients);
+        }
+        this->check_lincomb_coefficients(coefficients);
+        // translate to coefficients for all vectors of the viewed array
+        const auto index_vec = indices_->as_vec(vec_array_.size());
+        std::vector<std::vector<F>> full_coefficients(coefficients.size(),
+                                                      std::vector<F>(as_size_t(vec_array_.size()), F(0)));
+        for (size_t i = 0; i < coefficients.size(); ++i)
+        {
+            for (size_t k = 0; k < index_vec.size(); ++k)
+            {
+                full_coefficients[i][as_size_t(index_vec[k])] += coefficients[i][k];
+            }
+        }
+        return vec_array_.lincomb(full_coefficients);
+    }
+
     [[nodiscard]] const VectorInterface<F>& vector(ssize_t i) const override
     {
         return vec_array_.vector(indices_ ? indices_->get(i, vec_array_.size()) : i);
@@ -119,24 +198,12 @@ class ConstVectorArrayView : public VectorArrayInterface<F>
         std::vector<ssize_t> new_indices_vec;
         new_indices_vec.reserve(as_size_t(view_indices->size(this->size())));
         const auto old_indices_vec = indices_->as_vec(vec_array_.size());
-        std::cerr << "old_indices_vec: ";
-        for (auto i : old_indices_vec)
-        {
-            std::cerr << i << " ";
-        }
-        std::cerr << '\n';
         view_indices->for_each(
             [&new_indices_vec, &old_indices_vec](ssize_t i)
             {
                 new_indices_vec.push_back(old_indices_vec[as_size_t(i)]);
             },
             this->size());
-        std::cerr << "new_indices_vec: ";
-        for (auto i : new_indices_vec)
-        {
-            std::cerr << i << " ";
-        }
-        std::cerr << '\n';
         return Indices(new_indices_vec);
     }
 
@@ -192,6 +259,7 @@ class VectorArrayInterface
 
    public:
     using ScalarType = F;
+    using RealType = real_type_t<F>;
 
     // constructors and destructor
     VectorArrayInterface() = default;
@@ -200,8 +268,19 @@ class VectorArrayInterface
     // copy and move constructor and assignment operators
     VectorArrayInterface(const ThisType&) = default;
     VectorArrayInterface(ThisType&&) = default;
-    VectorArrayInterface& operator=(const ThisType&) = default;
-    VectorArrayInterface& operator=(ThisType&&) = default;
+
+    // the version is not assigned, since the counters of an array must never decrease
+    VectorArrayInterface& operator=(const ThisType& /*other*/)
+    {
+        record_modification();
+        return *this;
+    }
+
+    VectorArrayInterface& operator=(ThisType&& /*other*/) noexcept
+    {
+        record_modification();
+        return *this;
+    }
 
     /// \brief return the number of vectors in the array
     [[nodiscard]] virtual ssize_t size() const = 0;
@@ -209,6 +288,19 @@ class VectorArrayInterface
     /// \brief return the dimension (length) of the vectors in the array
     [[nodiscard]] virtual ssize_t dim() const = 0;
 
+    /**
+     * \brief Returns the counters for the operations which changed the array (see VectorArrayVersion)
+     *
+     * Implementations have to record all changes (see record_append, record_deletion and
+     * record_modification), including changes through non-const accessors to the underlying data, which
+     * count as modifications when the accessor is called. Like the arrays themselves, the counters are not
+     * synchronized between threads.
+     */
+    [[nodiscard]] virtual VectorArrayVersion version() const
+    {
+        return version_;
+    }
+
     // Hack to get the scalar type on the Python side by calling type(impl.scalar_zero())
     // TODO: Find a better way to do this
     [[nodiscard]] F scalar_zero() const
@@ -225,6 +317,19 @@ class VectorArrayInterface
         return dim() == other.dim();
     }
 
+    /**
+     * \brief Whether inner products with this VectorArray should be computed by this VectorArray
+     *
+     * Returns true if \c inner and \c pairwise_inner of this VectorArray are much cheaper than the ones of
+     * a generic VectorArray with this VectorArray as \c other (e.g., for sparse arrays). If only the right
+     * array prefers computing the inner products, EuclideanInnerProduct computes <tt>(u, v)</tt> as the
+     * conjugate of <tt>(v, u)</tt>.
+     */
+    [[nodiscard]] virtual bool prefers_computing_inner_products() const
+    {
+        return false;
+    }
+
     /**
      * \brief Copies (a subset of) the VectorArray to a new VectorArray
      *
@@ -369,6 +474,183 @@ class VectorArrayInterface
         axpy(std::vector<F>{alpha}, x, indices, x_indices);
     }
 
+    /**
+     * \brief Euclidean inner products of (a subset of) the vectors with (a subset of) the vectors of \c other
+     *
+     * Returns the matrix whose <tt>(i, j)</tt>-th entry is the inner product of the i-th vector of this
+     * VectorArray (after applying \c indices) with the j-th vector of \c other (after applying
+     * <tt>other_indices</tt>). For complex scalars, the inner product is antilinear in the first argument.
+     *
+     * \note The default implementation only uses \c get. Implementations with direct access to their
+     * data should override it.
+     */
+    [[nodiscard]] virtual std::vector<std::vector<F>> inner(
+        const ThisType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto this_index_vec = index_vector(indices, size());
+        const auto other_index_vec = index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(this_index_vec.size(), std::vector<F>(other_index_vec.size(), F(0)));
+        for (size_t i = 0; i < this_index_vec.size(); ++i)
+        {
+            for (size_t j = 0; j < other_index_vec.size(); ++j)
+            {
+                for (ssize_t k = 0; k < dim(); ++k)
+                {
+                    ret[i][j] +=
+                        conj_if_complex(get(this_index_vec[i], k)) * other.get(other_index_vec[j], k);
+                }
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Pairwise Euclidean inner products of (a subset of) the vectors with (a subset of) the vectors
+     * of \c other
+     *
+     * Both arrays (after applying the indices) have to have the same size. The i-th entry of the result is
+     * the inner product of the i-th vector of this VectorArray with the i-th vector of \c other.
+     * \sa inner
+     */
+    [[nodiscard]] virtual std::vector<F> pairwise_inner(
+        const ThisType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto this_index_vec = index_vector(indices, size());
+        const auto other_index_vec = index_vector(other_indices, other.size());
+        check(this_index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(this_index_vec.size(), F(0));
+        for (size_t i = 0; i < this_index_vec.size(); ++i)
+        {
+            for (ssize_t k = 0; k < dim(); ++k)
+            {
+                ret[i] += conj_if_complex(get(this_index_vec[i], k)) * other.get(other_index_vec[i], k);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Squared Euclidean norms of (a subset of) the vectors
+     */
+    [[nodiscard]] virtual std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const
+    {
+        const auto index_vec = index_vector(indices, size());
+        std::vector<RealType> ret(index_vec.size(), RealType(0));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (ssize_t k = 0; k < dim(); ++k)
+            {
+                ret[i] += abs2(get(index_vec[i], k));
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Euclidean norms of (a subset of) the vectors
+     */
+    [[nodiscard]] std::vector<RealType> norm(const std::optional<Indices>& indices = std::nullopt) const
+    {
+        auto ret = norm2(indices);
+        std::ranges::transform(ret, ret.begin(),
+                               [](const RealType& value)
+                               {
+                                   return std::sqrt(value);
+                               });
+        return ret;
+    }
+
+    /**
+     * \brief Linear combinations of the vectors
+     *
+     * Returns a new VectorArray containing one vector for each entry of \c coefficients. The i-th vector is
+     * the sum over all k of <tt>coefficients[i][k]</tt> times the k-th vector of this VectorArray, so each
+     * entry of \c coefficients has to have the same size as the VectorArray.
+     *
+     * \note The result is created by copying vectors of this VectorArray, so this VectorArray must not be
+     * empty unless \c coefficients is empty, too.
+     */
+    [[nodiscard]] virtual std::shared_ptr<ThisType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const
+    {
+        check_lincomb_coefficients(coefficients);
+        // use copies of the first vector as storage for the result
+        auto ret = copy(Indices(std::vector<ssize_t>(coefficients.size(), 0)));
+        for (size_t i = 0; i < coefficients.size(); ++i)
+        {
+            for (ssize_t j = 0; j < dim(); ++j)
+            {
+                F value(0);
+                for (ssize_t k = 0; k < size(); ++k)
+                {
+                    value += coefficients[i][as_size_t(k)] * get(k, j);
+                }
+                ret->set(as_ssize_t(i), j, value);
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Position and absolute value of the entry with the largest absolute value for each vector
+     *
+     * Returns a pair of vectors, the first containing the index (within the vector) of the entry with
+     * maximal absolute value and the second containing the corresponding absolute value. If several entries
+     * have the same maximal absolute value, the first one is returned.
+     */
+    [[nodiscard]] virtual std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const
+    {
+        check(dim() > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = index_vector(indices, size());
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{std::vector<ssize_t>(index_vec.size(), 0),
+                                                                   std::vector<RealType>(index_vec.size())};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret.second[i] = std::abs(get(index_vec[i], 0));
+            for (ssize_t k = 1; k < dim(); ++k)
+            {
+                const RealType value = std::abs(get(index_vec[i], k));
+                if (value > ret.second[i])
+                {
+                    ret.first[i] = k;
+                    ret.second[i] = value;
+                }
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * \brief Extracts the entries given by \c dof_indices from (a subset of) the vectors
+     *
+     * Returns a matrix with one row per (selected) vector and one column per entry of \c dof_indices.
+     */
+    [[nodiscard]] std::vector<std::vector<F>> dofs(const std::vector<ssize_t>& dof_indices,
+                                                   const std::optional<Indices>& indices = std::nullopt) const
+    {
+        for (const auto& j : dof_indices)
+        {
+            check_second_index(j);
+        }
+        const auto index_vec = index_vector(indices, size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(dof_indices.size()));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (size_t j = 0; j < dof_indices.size(); ++j)
+            {
+                ret[i][j] = get(index_vec[i], dof_indices[j]);
+            }
+        }
+        return ret;
+    }
+
     /**
      * \brief Returns a const reference to the i-th vector
      *
@@ -486,6 +768,21 @@ class VectorArrayInterface
     virtual void delete_vectors(const std::optional<Indices>& indices) = 0;
 
    protected:
+    void record_append()
+    {
+        ++version_.appends;
+    }
+
+    void record_deletion()
+    {
+        ++version_.deletions;
+    }
+
+    void record_modification()
+    {
+        ++version_.modifications;
+    }
+
     /**
      * \brief Checks that the first index i is in the range [0, size())
      */
@@ -526,6 +823,45 @@ class VectorArrayInterface
             throw InvalidArgumentError(message);
         }
     }
+
+    /**
+     * \brief Checks that \c coefficients has the correct shape for \c lincomb
+     */
+    void check_lincomb_coefficients(const std::vector<std::vector<F>>& coefficients) const
+    {
+        check(std::ranges::all_of(coefficients,
+                                  [this](const auto& row)
+                                  {
+                                      return std::ssize(row) == size();
+                                  }),
+              "lincomb: each row of coefficients must have the same size as the array.");
+        if (!coefficients.empty() && size() == 0)
+        {
+            throw NotImplementedError("lincomb: cannot create new vectors from an empty array.");
+        }
+    }
+
+    /// See nias::index_vector (accessible without qualification in derived class templates)
+    [[nodiscard]] static std::vector<ssize_t> index_vector(const std::optional<Indices>& indices,
+                                                           ssize_t length)
+    {
+        return nias::index_vector(indices, length);
+    }
+
+    [[nodiscard]] static RealType abs2(const F& value)
+    {
+        if constexpr (complex<F>)
+        {
+            return std::norm(value);
+        }
+        else
+        {
+            return value * value;
+        }
+    }
+
+   private:
+    VectorArrayVersion version_;
 };
 
 template <floating_point_or_complex F>
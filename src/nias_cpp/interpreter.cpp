@@ -1,16 +1,129 @@
 #include "interpreter.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
 
+#include <nias_cpp/exceptions.h>
 #include <pybind11/embed.h>
 #include <pybind11/eval.h>
+#include <pybind11/pybind11.h>
 
 namespace nias
 {
+namespace
+{
+
+
+// Site-packages directory and Python version of the virtualenv (see cmake/write_venv_config.py)
+struct VenvConfig
+{
+    std::string site_packages;
+    std::string version;
+};
+
+// Reads the virtualenv config written at build time. Returns std::nullopt if the file does not exist
+// or is outdated (e.g., because the virtualenv has been moved or recreated after building).
+std::optional<VenvConfig> read_venv_config()
+{
+#ifdef NIAS_CPP_VENV_CONFIG_FILE
+    std::ifstream file(NIAS_CPP_VENV_CONFIG_FILE);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    VenvConfig config;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const auto pos = line.find('=');
+        if (line.starts_with('#') || pos == std::string::npos)
+        {
+            continue;
+        }
+        const auto key = std::string_view(line).substr(0, pos);
+        if (key == "site_packages")
+        {
+            config.site_packages = line.substr(pos + 1);
+        }
+        else if (key == "version")
+        {
+            config.version = line.substr(pos + 1);
+        }
+    }
+    std::error_code error;
+    if (config.site_packages.empty() || config.version.empty() ||
+        !std::filesystem::is_directory(config.site_packages, error))
+    {
+        return std::nullopt;
+    }
+    return config;
+#else
+    return std::nullopt;
+#endif
+}
+
+// Version of the running interpreter (same as sys.version.split()[0] but without executing Python code)
+std::string interpreter_version()
+{
+    const std::string version = Py_GetVersion();
+    return version.substr(0, version.find(' '));
+}
+
+// Timing information is printed to std::cerr if the environment variable NIAS_CPP_TIMING_LOG is set
+// (to something other than 0)
+bool timing_log_enabled()
+{
+    const char* value = std::getenv("NIAS_CPP_TIMING_LOG");
+    return value != nullptr && *value != '\0' && std::string_view(value) != "0";
+}
+
+// Fallback if there is no (valid) virtualenv config: search the virtualenv at runtime
+void find_and_activate_venv()
+{
+    pybind11::exec("nias_cpp_venv_dir = '" NIAS_CPP_VENV_DIR "'");
+    pybind11::exec(R"(
+        import pathlib
+        venv_path = pathlib.Path(nias_cpp_venv_dir)
+        venv_module_path = list(venv_path.rglob('site-packages'))
+        if len(venv_module_path) != 1:
+            raise RuntimeError('Could not find virtualenv module path')
+        venv_module_path = venv_module_path[0]
+        sys.path.insert(0, str(venv_module_path))
+        )");
+    // check that Python versions match (pyvenv.cfg contains version_info or version, depending on the tool
+    // which created the virtualenv, same as in cmake/write_venv_config.py)
+    pybind11::exec(R"(
+        venv_version = None
+        with open(venv_path / 'pyvenv.cfg', 'r') as f:
+            for line in f:
+                key, _, value = line.partition('=')
+                if key.strip() in ('version_info', 'version'):
+                    venv_version = value.strip()
+                    break
+        if venv_version is None:
+            raise RuntimeError(f'Could not find Python version in {venv_path / "pyvenv.cfg"}')
+        interpreter_version = sys.version.split()[0]
+        if venv_version != interpreter_version:
+            raise RuntimeError(f'Python versions (interpreter {interpreter_version}'
+                               f' vs virtualenv {venv_version}) do not match!')
+        )");
+}
+
 
+}  // namespace
 
 void ensure_interpreter_and_venv_are_active()
 {
+    const auto start = std::chrono::steady_clock::now();
     static auto interpreter = pybind11::scoped_interpreter{};
     // For the moment, we simply prepend the virtualenv module path to Python's module search path.
     // This seems to work fine for now but we have to ensure that the python version that is linked to pybind11
@@ -21,33 +134,39 @@ void ensure_interpreter_and_venv_are_active()
     std::call_once(flag,
                    [&]()
                    {
+                       const auto interpreter_started = std::chrono::steady_clock::now();
                        // insert build directory into python module search path
                        pybind11::exec(
                            "import sys\n"
-                           "import pathlib\n"
                            "sys.path.insert(0, '" NIAS_CPP_BUILD_DIR "')");
                        // insert virtualenv module path into python module search path
-                       pybind11::exec("nias_cpp_venv_dir = '" NIAS_CPP_VENV_DIR "'");
-                       pybind11::exec(R"(
-                           venv_path = pathlib.Path(nias_cpp_venv_dir)
-                           venv_module_path = list(venv_path.rglob('site-packages'))
-                           if len(venv_module_path) != 1:
-                               raise RuntimeError('Could not find virtualenv module path')
-                           venv_module_path = venv_module_path[0]
-                           sys.path.insert(0, str(venv_module_path))
-                           )");
-                       // check that Python versions match
-                       pybind11::exec(R"(
-                           with open(venv_path / 'pyvenv.cfg', 'r') as f:
-                               for line in f:
-                                   if line.startswith('version_info'):
-                                       venv_version = line.split('=')[1].strip()
-                                       break
-                           interpreter_version = sys.version.split()[0]
-                           if venv_version != interpreter_version:
-                               raise RuntimeError(f'Python versions (interpreter {interpreter_version}'
-                                                  f' vs virtualenv {venv_version}) do not match!')
-                           )");
+                       const auto config = read_venv_config();
+                       if (config)
+                       {
+                           if (config->version != interpreter_version())
+                           {
+                               throw InvalidStateError(std::format(
+                                   "Python versions (interpreter {} vs virtualenv {}) do not match!",
+                                   interpreter_version(), config->version));
+                           }
+                           const auto sys_path = pybind11::module_::import("sys").attr("path");
+                           sys_path.attr("insert")(0, config->site_packages);
+                       }
+                       else
+                       {
+                           find_and_activate_venv();
+                       }
+                       if (timing_log_enabled())
+                       {
+                           const auto end = std::chrono::steady_clock::now();
+                           using milliseconds = std::chrono::duration<double, std::milli>;
+                           std::cerr << std::format(
+                               "nias_cpp: starting the Python interpreter took {:.2f} ms, activating the "
+                               "virtualenv took {:.2f} ms ({})\n",
+                               milliseconds(interpreter_started - start).count(),
+                               milliseconds(end - interpreter_started).count(),
+                               config ? "paths from build-time config" : "searched at runtime");
+                       }
                    });
 }
 
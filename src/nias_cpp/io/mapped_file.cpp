@@ -0,0 +1,430 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/type_traits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nias
+{
+
+namespace
+{
+[[nodiscard]] std::string last_error_message()
+{
+    return std::system_category().message(errno);
+}
+}  // namespace
+
+struct MappedFile::State
+{
+    State() = default;
+    State(const State&) = delete;
+    State(State&&) = delete;
+    State& operator=(const State&) = delete;
+    State& operator=(State&&) = delete;
+
+    ~State()
+    {
+        unmap();
+#ifndef _WIN32
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+#endif
+    }
+
+    [[nodiscard]] bool file_backed() const
+    {
+        return !path.empty();
+    }
+
+    // whether the data is mapped from a file or shared memory object (instead of being held in buffer)
+    [[nodiscard]] bool mapped() const
+    {
+        return fd >= 0;
+    }
+
+    // the path of the file or the name of the shared memory object (for error messages)
+    [[nodiscard]] std::string name() const
+    {
+        return file_backed() ? path.string() : shared_memory_name;
+    }
+
+    // map the first size bytes of the file
+    void map()
+    {
+        if (!mapped())
+        {
+            data = buffer.data();
+            return;
+        }
+        data = nullptr;
+        // mmap does not allow mappings of length 0
+        if (size == 0)
+        {
+            return;
+        }
+#ifndef _WIN32
+        const int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* const mapping = ::mmap(nullptr, as_size_t(size), protection, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            throw IOError(std::format("MappedFile: could not map {}: {}", name(), last_error_message()));
+        }
+        data = static_cast<char*>(mapping);
+#endif
+    }
+
+    void unmap()
+    {
+#ifndef _WIN32
+        if (mapped() && data != nullptr)
+        {
+            ::munmap(data, as_size_t(size));
+        }
+#endif
+        data = nullptr;
+    }
+
+    std::filesystem::path path;
+    std::string shared_memory_name;
+    // storage for anonymous mappings
+    std::vector<char> buffer;
+    char* data = nullptr;
+    ssize_t size = 0;
+    bool writable = true;
+    int fd = -1;
+};
+
+MappedFile::MappedFile(ssize_t size)
+    : state_(nullptr)
+{
+    if (size < 0)
+    {
+        throw InvalidArgumentError("MappedFile: size must be non-negative");
+    }
+    auto state = std::make_unique<State>();
+    state->buffer.resize(as_size_t(size));
+    state->size = size;
+    state->map();
+    state_ = state.release();
+}
+
+MappedFile::MappedFile(State* state)
+    : state_(state)
+{
+}
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& /*path*/, MappedFileMode /*mode*/)
+    : state_(nullptr)
+{
+    throw NotImplementedError("MappedFile: memory-mapped files are only supported on POSIX systems");
+}
+
+MappedFile MappedFile::create(const std::filesystem::path& /*path*/, ssize_t /*size*/)
+{
+    throw NotImplementedError("MappedFile: memory-mapped files are only supported on POSIX systems");
+}
+
+MappedFile MappedFile::create_shared_memory(const std::string& /*name*/, ssize_t /*size*/)
+{
+    throw NotImplementedError("MappedFile: shared memory is only supported on POSIX systems");
+}
+
+MappedFile MappedFile::open_shared_memory(const std::string& /*name*/, MappedFileMode /*mode*/)
+{
+    throw NotImplementedError("MappedFile: shared memory is only supported on POSIX systems");
+}
+
+void MappedFile::unlink_shared_memory(const std::string& /*name*/)
+{
+    throw NotImplementedError("MappedFile: shared memory is only supported on POSIX systems");
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path, MappedFileMode mode)
+    : state_(nullptr)
+{
+    auto state = std::make_unique<State>();
+    state->path = path;
+    state->writable = mode == MappedFileMode::read_write;
+    state->fd = ::open(path.c_str(), state->writable ? O_RDWR : O_RDONLY);
+    if (state->fd < 0)
+    {
+        throw IOError(std::format("MappedFile: could not open {}: {}", path.string(), last_error_message()));
+    }
+    struct stat file_status = {};
+    if (::fstat(state->fd, &file_status) != 0)
+    {
+        throw IOError(std::format("MappedFile: could not stat {}: {}", path.string(), last_error_message()));
+    }
+    state->size = static_cast<ssize_t>(file_status.st_size);
+    state->map();
+    state_ = state.release();
+}
+
+MappedFile MappedFile::create(const std::filesystem::path& path, ssize_t size)
+{
+    if (size < 0)
+    {
+        throw InvalidArgumentError("MappedFile: size must be non-negative");
+    }
+    auto state = std::make_unique<State>();
+    state->path = path;
+    state->fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (state->fd < 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not create {}: {}", path.string(), last_error_message()));
+    }
+    if (::ftruncate(state->fd, static_cast<off_t>(size)) != 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not resize {}: {}", path.string(), last_error_message()));
+    }
+    state->size = size;
+    state->map();
+    return MappedFile(state.release());
+}
+
+MappedFile MappedFile::create_shared_memory(const std::string& name, ssize_t size)
+{
+    if (size < 0)
+    {
+        throw InvalidArgumentError("MappedFile: size must be non-negative");
+    }
+    auto state = std::make_unique<State>();
+    state->shared_memory_name = name;
+    state->fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (state->fd < 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not create shared memory {}: {}", name, last_error_message()));
+    }
+    if (::ftruncate(state->fd, static_cast<off_t>(size)) != 0)
+    {
+        const auto message = last_error_message();
+        ::shm_unlink(name.c_str());
+        throw IOError(std::format("MappedFile: could not resize shared memory {}: {}", name, message));
+    }
+    state->size = size;
+    try
+    {
+        state->map();
+    }
+    catch (...)
+    {
+        ::shm_unlink(name.c_str());
+        throw;
+    }
+    return MappedFile(state.release());
+}
+
+MappedFile MappedFile::open_shared_memory(const std::string& name, MappedFileMode mode)
+{
+    auto state = std::make_unique<State>();
+    state->shared_memory_name = name;
+    state->writable = mode == MappedFileMode::read_write;
+    state->fd = ::shm_open(name.c_str(), state->writable ? O_RDWR : O_RDONLY, 0);
+    if (state->fd < 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not open shared memory {}: {}", name, last_error_message()));
+    }
+    struct stat status = {};
+    if (::fstat(state->fd, &status) != 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not stat shared memory {}: {}", name, last_error_message()));
+    }
+    state->size = static_cast<ssize_t>(status.st_size);
+    state->map();
+    return MappedFile(state.release());
+}
+
+void MappedFile::unlink_shared_memory(const std::string& name)
+{
+    if (::shm_unlink(name.c_str()) != 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not remove shared memory {}: {}", name, last_error_message()));
+    }
+}
+
+#endif  // _WIN32
+
+MappedFile::~MappedFile()
+{
+    delete state_;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : state_(nullptr)
+{
+    std::swap(state_, other.state_);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    MappedFile tmp(std::move(other));
+    std::swap(state_, tmp.state_);
+    return *this;
+}
+
+const char* MappedFile::data() const
+{
+    return state_->data;
+}
+
+char* MappedFile::mutable_data()
+{
+    if (!state_->writable)
+    {
+        throw InvalidStateError("MappedFile: file has been mapped read-only");
+    }
+    return state_->data;
+}
+
+ssize_t MappedFile::size() const
+{
+    return state_->size;
+}
+
+bool MappedFile::writable() const
+{
+    return state_->writable;
+}
+
+bool MappedFile::file_backed() const
+{
+    return state_->file_backed();
+}
+
+std::filesystem::path MappedFile::path() const
+{
+    return state_->path;
+}
+
+std::string MappedFile::shared_memory_name() const
+{
+    return state_->shared_memory_name;
+}
+
+void MappedFile::resize(ssize_t new_size)
+{
+    if (!state_->writable)
+    {
+        throw InvalidStateError("MappedFile: cannot resize a file that has been mapped read-only");
+    }
+    if (new_size < 0)
+    {
+        throw InvalidArgumentError("MappedFile: size must be non-negative");
+    }
+    if (new_size == state_->size)
+    {
+        return;
+    }
+    if (!state_->mapped())
+    {
+        state_->buffer.resize(as_size_t(new_size));
+        state_->size = new_size;
+        state_->map();
+        return;
+    }
+#ifndef _WIN32
+    state_->unmap();
+    if (::ftruncate(state_->fd, static_cast<off_t>(new_size)) != 0)
+    {
+        // try to restore the old mapping so that this object stays usable
+        state_->map();
+        throw IOError(
+            std::format("MappedFile: could not resize {}: {}", state_->name(), last_error_message()));
+    }
+    state_->size = new_size;
+    state_->map();
+#endif
+}
+
+void MappedFile::advise(ssize_t offset, ssize_t length, AccessAdvice advice) const
+{
+#ifdef _WIN32
+    static_cast<void>(offset);
+    static_cast<void>(length);
+    static_cast<void>(advice);
+#else
+    if (!state_->mapped() || state_->data == nullptr)
+    {
+        return;
+    }
+    const ssize_t begin = std::clamp(offset, ssize_t(0), state_->size);
+    const ssize_t end = std::clamp(offset + length, begin, state_->size);
+    if (begin == end)
+    {
+        return;
+    }
+    // madvise requires a page-aligned start address (the mapping itself is page-aligned)
+    const auto page_size = static_cast<ssize_t>(::sysconf(_SC_PAGESIZE));
+    const ssize_t aligned_begin = begin - (begin % page_size);
+    int flag = MADV_NORMAL;
+    switch (advice)
+    {
+        case AccessAdvice::normal:
+            flag = MADV_NORMAL;
+            break;
+        case AccessAdvice::sequential:
+            flag = MADV_SEQUENTIAL;
+            break;
+        case AccessAdvice::random:
+            flag = MADV_RANDOM;
+            break;
+        case AccessAdvice::will_need:
+            flag = MADV_WILLNEED;
+            break;
+        case AccessAdvice::dont_need:
+            // for shared mappings, this only drops the pages from our address space, modified pages are
+            // kept in the page cache (or the shared memory object) and written back to the file as usual
+            flag = MADV_DONTNEED;
+            break;
+    }
+    // this is only a hint, so we ignore errors
+    static_cast<void>(::madvise(state_->data + aligned_begin, as_size_t(end - aligned_begin), flag));
+#endif
+}
+
+void MappedFile::flush()
+{
+#ifndef _WIN32
+    if (!state_->mapped() || !state_->writable || state_->data == nullptr)
+    {
+        return;
+    }
+    if (::msync(state_->data, as_size_t(state_->size), MS_SYNC) != 0)
+    {
+        throw IOError(
+            std::format("MappedFile: could not write {}: {}", state_->name(), last_error_message()));
+    }
+#endif
+}
+
+}  // namespace nias
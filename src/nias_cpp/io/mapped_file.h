@@ -0,0 +1,126 @@
+#ifndef NIAS_CPP_IO_MAPPED_FILE_H
+#define NIAS_CPP_IO_MAPPED_FILE_H
+
+#include <filesystem>
+#include <string>
+
+#include <nias_cpp/type_traits.h>
+
+#include "nias_cpp_core_export.h"
+
+namespace nias
+{
+
+
+enum class MappedFileMode
+{
+    read_only,
+    read_write
+};
+
+/// Hints on how a range of a MappedFile is going to be accessed (see madvise)
+enum class AccessAdvice
+{
+    normal,
+    sequential,
+    random,
+    will_need,
+    dont_need
+};
+
+/**
+ * \brief A file mapped into memory
+ *
+ * The whole file is mapped (shared, i.e., writes go to the file), so files larger than the available
+ * memory can be accessed and the operating system takes care of loading and evicting pages. A MappedFile
+ * can also be "anonymous", i.e., not backed by a file. In that case the data is held in (heap) memory.
+ * Finally, POSIX shared memory objects can be mapped, so that several processes can access the same data.
+ *
+ * \note Memory-mapped files and shared memory are currently only supported on POSIX systems. On other
+ * systems, only anonymous MappedFiles can be created.
+ * \note Resizing the mapping invalidates all pointers obtained from \c data.
+ */
+class NIAS_CPP_CORE_EXPORT MappedFile
+{
+   public:
+    /// Create an anonymous (not file-backed) zero-initialized mapping of the given size
+    explicit MappedFile(ssize_t size = 0);
+
+    /// Map an existing file
+    MappedFile(const std::filesystem::path& path, MappedFileMode mode);
+
+    /// Create a new (zero-initialized) file of the given size (an existing file is overwritten) and map it
+    [[nodiscard]] static MappedFile create(const std::filesystem::path& path, ssize_t size);
+
+    /**
+     * \brief Create a new (zero-initialized) POSIX shared memory object of the given size and map it
+     *
+     * \c name has to start with a slash and must not contain further slashes (see \c shm_open). It is an
+     * error if a shared memory object with this name already exists. The object persists (even if it is no
+     * longer mapped by any process) until unlink_shared_memory is called.
+     */
+    [[nodiscard]] static MappedFile create_shared_memory(const std::string& name, ssize_t size);
+
+    /// Map an existing POSIX shared memory object (e.g., one created by another process)
+    [[nodiscard]] static MappedFile open_shared_memory(const std::string& name, MappedFileMode mode);
+
+    /// Remove the shared memory object \c name (existing mappings stay valid until they are unmapped)
+    static void unlink_shared_memory(const std::string& name);
+
+    /// Destructor (unmaps the file)
+    ~MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(const MappedFile& other) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] const char* data() const;
+
+    /// Mutable access to the data (throws if the file has been mapped read-only)
+    [[nodiscard]] char* mutable_data();
+
+    [[nodiscard]] ssize_t size() const;
+
+    [[nodiscard]] bool writable() const;
+
+    [[nodiscard]] bool file_backed() const;
+
+    /// The path of the mapped file (empty for anonymous mappings and shared memory)
+    [[nodiscard]] std::filesystem::path path() const;
+
+    /// The name of the mapped shared memory object (empty if no shared memory object is mapped)
+    [[nodiscard]] std::string shared_memory_name() const;
+
+    /**
+     * \brief Change the size of the mapping (and of the file)
+     *
+     * The first <tt>min(size(), new_size)</tt> bytes are preserved, new bytes are zero-initialized. Does
+     * nothing (in particular, does not remap the file) if \c new_size equals <tt>size()</tt>.
+     */
+    void resize(ssize_t new_size);
+
+    /**
+     * \brief Tell the operating system how the bytes <tt>[offset, offset + length)</tt> will be accessed
+     *
+     * The range is extended to full pages. This is only a hint, so it never throws and is ignored for
+     * anonymous mappings (where \c dont_need could discard data).
+     */
+    void advise(ssize_t offset, ssize_t length, AccessAdvice advice) const;
+
+    /// Write modified pages back to the file
+    void flush();
+
+   private:
+    struct State;
+
+    explicit MappedFile(State* state);
+
+    // See the comment on Indices::indices_ on why this is a pointer
+    State* state_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_IO_MAPPED_FILE_H
@@ -0,0 +1,234 @@
+#include "npy.h"
+
+#include <cctype>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+namespace
+{
+constexpr std::string_view npy_magic = "\x93NUMPY";
+// size of magic string, version and header length for version 1.0 and versions 2.0 / 3.0
+constexpr ssize_t preamble_size_v1 = 10;
+constexpr ssize_t preamble_size_v2 = 12;
+constexpr ssize_t max_dict_size_v1 = 65535;
+constexpr ssize_t header_alignment = 64;
+// additional space reserved in new headers so that the shape can grow without moving the data
+constexpr ssize_t shape_reserve = 32;
+
+[[noreturn]] void throw_invalid_header(std::string_view reason)
+{
+    throw InvalidArgumentError(std::format("parse_npy_header: invalid .npy header ({})", reason));
+}
+
+void skip_whitespace(std::string_view& str)
+{
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front())) != 0)
+    {
+        str.remove_prefix(1);
+    }
+}
+
+// returns the part of dict following "'key':" (with leading whitespace removed)
+std::string_view find_value(std::string_view dict, std::string_view key)
+{
+    for (const char quote : {'\'', '"'})
+    {
+        const auto quoted_key = std::format("{}{}{}", quote, key, quote);
+        auto pos = dict.find(quoted_key);
+        if (pos == std::string_view::npos)
+        {
+            continue;
+        }
+        auto value = dict.substr(pos + quoted_key.size());
+        skip_whitespace(value);
+        if (value.empty() || value.front() != ':')
+        {
+            throw_invalid_header(std::format("missing ':' after key {}", key));
+        }
+        value.remove_prefix(1);
+        skip_whitespace(value);
+        return value;
+    }
+    throw_invalid_header(std::format("missing key {}", key));
+}
+
+std::string parse_string(std::string_view value)
+{
+    if (value.empty() || (value.front() != '\'' && value.front() != '"'))
+    {
+        throw_invalid_header("expected a string");
+    }
+    const char quote = value.front();
+    value.remove_prefix(1);
+    const auto end = value.find(quote);
+    if (end == std::string_view::npos)
+    {
+        throw_invalid_header("unterminated string");
+    }
+    return std::string(value.substr(0, end));
+}
+
+bool parse_bool(std::string_view value)
+{
+    if (value.starts_with("True"))
+    {
+        return true;
+    }
+    if (value.starts_with("False"))
+    {
+        return false;
+    }
+    throw_invalid_header("expected True or False");
+}
+
+std::vector<ssize_t> parse_tuple(std::string_view value)
+{
+    if (value.empty() || value.front() != '(')
+    {
+        throw_invalid_header("expected a tuple");
+    }
+    value.remove_prefix(1);
+    std::vector<ssize_t> ret;
+    while (true)
+    {
+        skip_whitespace(value);
+        if (value.empty())
+        {
+            throw_invalid_header("unterminated tuple");
+        }
+        if (value.front() == ')')
+        {
+            return ret;
+        }
+        ssize_t entry = 0;
+        ssize_t num_digits = 0;
+        while (!value.empty() && std::isdigit(static_cast<unsigned char>(value.front())) != 0)
+        {
+            const ssize_t digit = value.front() - '0';
+            if (entry > (std::numeric_limits<ssize_t>::max() - digit) / 10)
+            {
+                throw_invalid_header("shape entry too large");
+            }
+            entry = (entry * 10) + digit;
+            value.remove_prefix(1);
+            ++num_digits;
+        }
+        // Python 2 wrote shapes as (3L, 4L)
+        if (!value.empty() && value.front() == 'L')
+        {
+            value.remove_prefix(1);
+        }
+        if (num_digits == 0)
+        {
+            throw_invalid_header("expected a non-negative integer");
+        }
+        ret.push_back(entry);
+        skip_whitespace(value);
+        if (!value.empty() && value.front() == ',')
+        {
+            value.remove_prefix(1);
+        }
+    }
+}
+
+ssize_t round_up(ssize_t value, ssize_t multiple)
+{
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+}  // namespace
+
+NpyHeader parse_npy_header(std::string_view data)
+{
+    if (data.size() < as_size_t(preamble_size_v1) || !data.starts_with(npy_magic))
+    {
+        throw_invalid_header("wrong magic string");
+    }
+    const auto byte = [&data](size_t pos)
+    {
+        return static_cast<std::uint32_t>(static_cast<unsigned char>(data[pos]));
+    };
+    const auto major_version = byte(6);
+    ssize_t preamble_size = 0;
+    ssize_t dict_size = 0;
+    if (major_version == 1)
+    {
+        preamble_size = preamble_size_v1;
+        dict_size = static_cast<ssize_t>(byte(8) | (byte(9) << 8U));
+    }
+    else if (major_version == 2 || major_version == 3)
+    {
+        if (data.size() < as_size_t(preamble_size_v2))
+        {
+            throw_invalid_header("truncated header");
+        }
+        preamble_size = preamble_size_v2;
+        dict_size =
+            static_cast<ssize_t>(byte(8) | (byte(9) << 8U) | (byte(10) << 16U) | (byte(11) << 24U));
+    }
+    else
+    {
+        throw_invalid_header(std::format("unsupported version {}", major_version));
+    }
+    if (std::ssize(data) < preamble_size + dict_size)
+    {
+        throw_invalid_header("truncated header");
+    }
+    const auto dict = data.substr(as_size_t(preamble_size), as_size_t(dict_size));
+    NpyHeader header;
+    header.descr = parse_string(find_value(dict, "descr"));
+    header.fortran_order = parse_bool(find_value(dict, "fortran_order"));
+    header.shape = parse_tuple(find_value(dict, "shape"));
+    header.header_size = preamble_size + dict_size;
+    return header;
+}
+
+std::string format_npy_header(const NpyHeader& header)
+{
+    std::string dict = std::format("{{'descr': '{}', 'fortran_order': {}, 'shape': (", header.descr,
+                                   header.fortran_order ? "True" : "False");
+    for (size_t i = 0; i < header.shape.size(); ++i)
+    {
+        dict += std::format("{}{}", i == 0 ? "" : ", ", header.shape[i]);
+    }
+    // one-element tuples need a trailing comma in Python
+    dict += header.shape.size() == 1 ? ",), }" : "), }";
+
+    // the dict is padded with spaces and terminated by a newline
+    ssize_t header_size = preamble_size_v1 + std::ssize(dict) + 1;
+    if (header.header_size >= header_size && header.header_size % header_alignment == 0)
+    {
+        header_size = header.header_size;
+    }
+    else
+    {
+        header_size = round_up(header_size + shape_reserve, header_alignment);
+    }
+    const bool version_1 = header_size - preamble_size_v1 <= max_dict_size_v1;
+    const ssize_t preamble_size = version_1 ? preamble_size_v1 : preamble_size_v2;
+    const auto dict_size = static_cast<std::uint32_t>(header_size - preamble_size);
+
+    std::string ret(npy_magic);
+    ret += static_cast<char>(version_1 ? 1 : 2);
+    ret += static_cast<char>(0);
+    for (ssize_t i = 0; i < preamble_size - std::ssize(npy_magic) - 2; ++i)
+    {
+        ret += static_cast<char>((dict_size >> (8U * as_size_t(i))) & 0xFFU);
+    }
+    ret += dict;
+    ret.append(as_size_t(header_size - std::ssize(ret) - 1), ' ');
+    ret += '\n';
+    return ret;
+}
+
+}  // namespace nias
@@ -0,0 +1,62 @@
+#ifndef NIAS_CPP_IO_NPY_H
+#define NIAS_CPP_IO_NPY_H
+
+#include <bit>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/type_traits.h>
+
+#include "nias_cpp_core_export.h"
+
+namespace nias
+{
+
+
+/**
+ * \brief Header of a file in NumPy's \c .npy format
+ *
+ * See https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html for a description of the format.
+ */
+struct NpyHeader
+{
+    /// The data type, e.g., \c "<f8" for little-endian doubles
+    std::string descr;
+    bool fortran_order = false;
+    std::vector<ssize_t> shape;
+    /// Size of the header in bytes (including magic string and version), i.e., the offset of the data
+    ssize_t header_size = 0;
+};
+
+/**
+ * \brief Parses the header at the beginning of \c data
+ *
+ * \throws InvalidArgumentError if \c data does not start with a valid \c .npy header.
+ */
+NIAS_CPP_CORE_EXPORT NpyHeader parse_npy_header(std::string_view data);
+
+/**
+ * \brief Returns the binary representation of \c header (to be written at the beginning of a \c .npy file)
+ *
+ * If <tt>header.header_size</tt> is large enough and a multiple of 64, the result is padded to exactly that
+ * size (so an existing header can be overwritten without moving the data). Otherwise, the result has the
+ * smallest possible size plus some space so that the shape can grow later on.
+ */
+NIAS_CPP_CORE_EXPORT std::string format_npy_header(const NpyHeader& header);
+
+/// The \c .npy data type descriptor for the scalar type \c F in native byte order
+template <floating_point_or_complex F>
+[[nodiscard]] std::string npy_descr()
+{
+    const char byte_order = std::endian::native == std::endian::little ? '<' : '>';
+    const char kind = complex<F> ? 'c' : 'f';
+    return std::format("{}{}{}", byte_order, kind, sizeof(F));
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_IO_NPY_H
@@ -0,0 +1,345 @@
+#include "vectorarray_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace nias
+{
+
+namespace
+{
+constexpr std::string_view magic{"\x89NIASVA\n", 8};
+constexpr std::uint32_t format_version = 1;
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+// the header checksum covers all bytes in front of it
+constexpr ssize_t header_checksum_offset = 56;
+constexpr ssize_t chunk_alignment = 64;
+constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+constexpr std::uint64_t fnv_prime = 1099511628211ULL;
+
+template <class T>
+void put(std::string& buffer, ssize_t offset, T value)
+{
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <class T>
+T get(std::string_view data, ssize_t offset)
+{
+    T value{};
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+// FNV-1a hash processing 8 bytes at once (the last word is padded with zeros)
+std::uint64_t hash_words(std::string_view data)
+{
+    std::uint64_t hash = fnv_offset_basis;
+    size_t pos = 0;
+    for (; pos + sizeof(std::uint64_t) <= data.size(); pos += sizeof(std::uint64_t))
+    {
+        hash = (hash ^ get<std::uint64_t>(data, as_ssize_t(pos))) * fnv_prime;
+    }
+    if (pos < data.size())
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data.data() + pos, data.size() - pos);
+        hash = (hash ^ word) * fnv_prime;
+    }
+    // include the length so that trailing zeros are not ignored
+    return (hash ^ static_cast<std::uint64_t>(data.size())) * fnv_prime;
+}
+
+std::uint64_t combine_checksums(const std::vector<std::uint64_t>& block_checksums)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return hash_words(std::string_view(reinterpret_cast<const char*>(block_checksums.data()),
+                                       block_checksums.size() * sizeof(std::uint64_t)));
+}
+
+ssize_t num_chunks(ssize_t data_size, ssize_t chunk_size)
+{
+    return (data_size + chunk_size - 1) / chunk_size;
+}
+
+std::string format_header(const VectorArrayFileHeader& header)
+{
+    std::string ret(as_size_t(vector_array_file_header_size), '\0');
+    ret.replace(0, magic.size(), magic);
+    put(ret, 8, format_version);
+    put(ret, 12, byte_order_mark);
+    ret[16] = header.scalar_kind;
+    ret[17] = static_cast<char>(header.scalar_size);
+    // layout (ret[18]) is always 0, i.e., the vectors are stored one after the other
+    put(ret, 24, static_cast<std::int64_t>(header.size));
+    put(ret, 32, static_cast<std::int64_t>(header.dim));
+    put(ret, 40, static_cast<std::uint64_t>(header.checksum_block_size));
+    put(ret, 48, header.checksum);
+    put(ret, header_checksum_offset,
+        hash_words(std::string_view(ret).substr(0, as_size_t(header_checksum_offset))));
+    return ret;
+}
+
+[[noreturn]] void throw_invalid_header(std::string_view reason)
+{
+    throw IOError(std::format("parse_vector_array_file_header: invalid header ({})", reason));
+}
+
+std::fstream open_file(const std::filesystem::path& path, std::ios::openmode mode, std::string_view caller)
+{
+    std::fstream file(path, mode | std::ios::binary);
+    if (!file)
+    {
+        throw IOError(std::format("{}: could not open {}", caller, path.string()));
+    }
+    return file;
+}
+
+// Writes the contents of the file to the disk (before the file is renamed, so that a crash never leaves a
+// file with the final name but incomplete contents behind)
+void sync_file(const std::filesystem::path& path, std::string_view caller)
+{
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDWR);
+    const bool synced = fd >= 0 && ::fsync(fd) == 0;
+    const auto message = std::system_category().message(errno);
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+    if (!synced)
+    {
+        throw IOError(std::format("{}: could not sync {}: {}", caller, path.string(), message));
+    }
+#else
+    static_cast<void>(path);
+    static_cast<void>(caller);
+#endif
+}
+}  // namespace
+
+std::uint64_t vector_array_file_checksum(std::string_view data, ssize_t block_size, ssize_t num_threads)
+{
+    if (block_size <= 0)
+    {
+        throw InvalidArgumentError("vector_array_file_checksum: block_size must be positive");
+    }
+    std::vector<std::uint64_t> block_checksums(as_size_t(num_chunks(std::ssize(data), block_size)));
+    parallel_for(
+        0, std::ssize(block_checksums),
+        [&](ssize_t block)
+        {
+            block_checksums[as_size_t(block)] =
+                hash_words(data.substr(as_size_t(block * block_size), as_size_t(block_size)));
+        },
+        num_threads);
+    return combine_checksums(block_checksums);
+}
+
+VectorArrayFileHeader parse_vector_array_file_header(std::string_view data)
+{
+    if (std::ssize(data) < vector_array_file_header_size || !data.starts_with(magic))
+    {
+        throw_invalid_header("not a vector array file");
+    }
+    if (get<std::uint64_t>(data, header_checksum_offset) !=
+        hash_words(data.substr(0, as_size_t(header_checksum_offset))))
+    {
+        throw_invalid_header("header checksum mismatch");
+    }
+    if (const auto version = get<std::uint32_t>(data, 8); version != format_version)
+    {
+        throw_invalid_header(std::format("unsupported version {}", version));
+    }
+    if (get<std::uint32_t>(data, 12) != byte_order_mark)
+    {
+        throw_invalid_header("file has been written on a machine with different byte order");
+    }
+    if (data[18] != 0)
+    {
+        throw_invalid_header("unsupported layout");
+    }
+    VectorArrayFileHeader header;
+    header.scalar_kind = data[16];
+    header.scalar_size = static_cast<unsigned char>(data[17]);
+    header.size = get<std::int64_t>(data, 24);
+    header.dim = get<std::int64_t>(data, 32);
+    header.checksum_block_size = static_cast<ssize_t>(get<std::uint64_t>(data, 40));
+    header.checksum = get<std::uint64_t>(data, 48);
+    if ((header.scalar_kind != 'f' && header.scalar_kind != 'c') || header.scalar_size == 0)
+    {
+        throw_invalid_header("invalid scalar type");
+    }
+    if (header.size < 0 || header.dim < 0 || header.checksum_block_size <= 0 ||
+        header.checksum_block_size % header.scalar_size != 0)
+    {
+        throw_invalid_header("invalid shape or checksum block size");
+    }
+    // the file size (header + size * dim * scalar_size bytes) has to be representable
+    const auto max_data_size = std::numeric_limits<ssize_t>::max() - vector_array_file_header_size;
+    if (header.dim > 0 && header.size > max_data_size / header.scalar_size / header.dim)
+    {
+        throw_invalid_header("shape too large");
+    }
+    return header;
+}
+
+VectorArrayFileHeader read_vector_array_file_header(const std::filesystem::path& path)
+{
+    auto file = open_file(path, std::ios::in, "read_vector_array_file_header");
+    std::string buffer(as_size_t(vector_array_file_header_size), '\0');
+    file.read(buffer.data(), vector_array_file_header_size);
+    if (file.gcount() != vector_array_file_header_size)
+    {
+        throw IOError(std::format("read_vector_array_file_header: {} is truncated", path.string()));
+    }
+    const auto header = parse_vector_array_file_header(buffer);
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(path, error);
+    if (error || as_ssize_t(file_size) < vector_array_file_header_size + header.data_size())
+    {
+        throw IOError(std::format("read_vector_array_file_header: {} is truncated", path.string()));
+    }
+    return header;
+}
+
+VectorArrayFileHeader write_vector_array_file(
+    const std::filesystem::path& path, const VectorArrayFileHeader& header,
+    const std::function<void(ssize_t offset, ssize_t count, char* buffer)>& read_data,
+    const VectorArrayFileOptions& options)
+{
+    if (header.size < 0 || header.dim < 0 || header.scalar_size <= 0)
+    {
+        throw InvalidArgumentError("write_vector_array_file: invalid header");
+    }
+    VectorArrayFileHeader ret = header;
+    ret.checksum_block_size =
+        std::max(chunk_alignment, options.chunk_size - (options.chunk_size % chunk_alignment));
+    if (ret.checksum_block_size % ret.scalar_size != 0)
+    {
+        throw InvalidArgumentError(
+            "write_vector_array_file: chunk size must be a multiple of the scalar size");
+    }
+    const auto data_size = ret.data_size();
+    const auto chunk_size = ret.checksum_block_size;
+    // write to a temporary file first, so that an existing file is only replaced by a complete one
+    auto temporary_path = path;
+    temporary_path += ".tmp";
+    try
+    {
+        {
+            auto file = open_file(temporary_path, std::ios::out | std::ios::trunc, "write_vector_array_file");
+            // the header is written last (once the checksum is known)
+            const std::string placeholder(as_size_t(vector_array_file_header_size), '\0');
+            file.write(placeholder.data(), vector_array_file_header_size);
+        }
+        std::filesystem::resize_file(temporary_path, as_size_t(vector_array_file_header_size + data_size));
+        std::vector<std::uint64_t> chunk_checksums(as_size_t(num_chunks(data_size, chunk_size)));
+        parallel_for(
+            0, std::ssize(chunk_checksums),
+            [&](ssize_t chunk)
+            {
+                const auto offset = chunk * chunk_size;
+                const auto count = std::min(chunk_size, data_size - offset);
+                std::string buffer(as_size_t(count), '\0');
+                read_data(offset, count, buffer.data());
+                chunk_checksums[as_size_t(chunk)] = hash_words(buffer);
+                // every chunk uses its own stream, so chunks can be written concurrently
+                auto file =
+                    open_file(temporary_path, std::ios::in | std::ios::out, "write_vector_array_file");
+                file.seekp(vector_array_file_header_size + offset);
+                file.write(buffer.data(), count);
+                if (!file.flush())
+                {
+                    throw IOError(std::format("write_vector_array_file: could not write {}", path.string()));
+                }
+            },
+            options.num_threads);
+        ret.checksum = combine_checksums(chunk_checksums);
+        {
+            auto file = open_file(temporary_path, std::ios::in | std::ios::out, "write_vector_array_file");
+            const auto header_bytes = format_header(ret);
+            file.write(header_bytes.data(), vector_array_file_header_size);
+            if (!file.flush())
+            {
+                throw IOError(std::format("write_vector_array_file: could not write {}", path.string()));
+            }
+        }
+        sync_file(temporary_path, "write_vector_array_file");
+        std::filesystem::rename(temporary_path, path);
+    }
+    catch (const std::filesystem::filesystem_error& error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporary_path, ignored);
+        throw IOError(std::format("write_vector_array_file: {}", error.what()));
+    }
+    catch (...)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(temporary_path, ignored);
+        throw;
+    }
+    return ret;
+}
+
+void read_vector_array_file(
+    const std::filesystem::path& path, const VectorArrayFileHeader& header,
+    const std::function<void(ssize_t offset, ssize_t count, const char* buffer)>& write_data,
+    const VectorArrayFileOptions& options)
+{
+    const auto data_size = header.data_size();
+    // chunks have to coincide with the checksum blocks
+    const auto chunk_size = header.checksum_block_size;
+    std::vector<std::uint64_t> chunk_checksums(as_size_t(num_chunks(data_size, chunk_size)));
+    parallel_for(
+        0, std::ssize(chunk_checksums),
+        [&](ssize_t chunk)
+        {
+            const auto offset = chunk * chunk_size;
+            const auto count = std::min(chunk_size, data_size - offset);
+            std::string buffer(as_size_t(count), '\0');
+            auto file = open_file(path, std::ios::in, "read_vector_array_file");
+            file.seekg(vector_array_file_header_size + offset);
+            file.read(buffer.data(), count);
+            if (file.gcount() != count)
+            {
+                throw IOError(std::format("read_vector_array_file: {} is truncated", path.string()));
+            }
+            if (options.verify_checksum)
+            {
+                chunk_checksums[as_size_t(chunk)] = hash_words(buffer);
+            }
+            write_data(offset, count, buffer.data());
+        },
+        options.num_threads);
+    if (options.verify_checksum && combine_checksums(chunk_checksums) != header.checksum)
+    {
+        throw IOError(std::format("read_vector_array_file: checksum mismatch in {}", path.string()));
+    }
+}
+
+}  // namespace nias
@@ -0,0 +1,248 @@
+#ifndef NIAS_CPP_IO_VECTORARRAY_FILE_H
+#define NIAS_CPP_IO_VECTORARRAY_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/io/mapped_file.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "nias_cpp_core_export.h"
+
+namespace nias
+{
+
+
+/**
+ * \brief Header of a vector array file
+ *
+ * A vector array file consists of a header of \c vector_array_file_header_size bytes followed by the entries
+ * of the vectors (one vector after the other, in native byte order):
+ *
+ * | Offset | Type        | Content                                                             |
+ * |--------|-------------|---------------------------------------------------------------------|
+ * | 0      | char[8]     | magic string <tt>"\x89NIASVA\n"</tt>                                |
+ * | 8      | uint32      | format version (currently 1)                                        |
+ * | 12     | uint32      | byte order mark \c 0x01020304                                       |
+ * | 16     | char        | scalar kind (\c 'f' for real, \c 'c' for complex numbers)           |
+ * | 17     | uint8       | size of a scalar in bytes                                           |
+ * | 18     | uint8       | layout (0: vectors are stored one after the other)                  |
+ * | 19     | char[5]     | reserved (zero)                                                     |
+ * | 24     | int64       | number of vectors                                                   |
+ * | 32     | int64       | dimension of the vectors                                            |
+ * | 40     | uint64      | size of the checksum blocks in bytes                                |
+ * | 48     | uint64      | checksum of the data                                                |
+ * | 56     | uint64      | checksum of the bytes 0 to 55 of the header                         |
+ *
+ * The data is split into blocks of \c checksum_block_size bytes (the last block may be shorter). The checksum
+ * of the data is the checksum of the sequence of the block checksums, so it can be computed in parallel.
+ * The header size is a multiple of 64 bytes, so the data is suitably aligned when the file is mapped.
+ */
+struct VectorArrayFileHeader
+{
+    char scalar_kind = 'f';
+    ssize_t scalar_size = 0;
+    ssize_t size = 0;
+    ssize_t dim = 0;
+    ssize_t checksum_block_size = 0;
+    std::uint64_t checksum = 0;
+
+    [[nodiscard]] ssize_t data_size() const
+    {
+        return size * dim * scalar_size;
+    }
+
+    /// Returns the header for vector arrays with scalar type \c F
+    template <floating_point_or_complex F>
+    [[nodiscard]] static VectorArrayFileHeader for_scalar_type(ssize_t size, ssize_t dim)
+    {
+        return {complex<F> ? 'c' : 'f', as_ssize_t(sizeof(F)), size, dim, 0, 0};
+    }
+
+    /// Checks whether the scalar type stored in the file is \c F
+    template <floating_point_or_complex F>
+    [[nodiscard]] bool has_scalar_type() const
+    {
+        return scalar_kind == (complex<F> ? 'c' : 'f') && scalar_size == as_ssize_t(sizeof(F));
+    }
+};
+
+inline constexpr ssize_t vector_array_file_header_size = 64;
+
+/// Options for saving and loading vector array files
+struct VectorArrayFileOptions
+{
+    /**
+     * \brief Number of bytes read or written at once
+     *
+     * This is also the checksum block size of newly written files. It is rounded down to a multiple of 64
+     * bytes (but is at least 64 bytes). When reading files, the checksum block size of the file is used.
+     */
+    ssize_t chunk_size = ssize_t(4) << 20;
+    /// Number of threads reading or writing chunks concurrently (0 means all hardware threads)
+    ssize_t num_threads = 1;
+    /// Whether the checksum is verified when reading a file
+    bool verify_checksum = true;
+};
+
+/**
+ * \brief Computes the checksum of the data of a vector array file
+ *
+ * The checksum of each block is a 64-bit FNV-1a hash (applied to 8-byte words instead of single bytes).
+ * Blocks are processed by up to \c num_threads threads (0 means all hardware threads).
+ */
+NIAS_CPP_CORE_EXPORT std::uint64_t vector_array_file_checksum(std::string_view data, ssize_t block_size,
+                                                              ssize_t num_threads = 1);
+
+/**
+ * \brief Parses the header at the beginning of \c data
+ *
+ * \throws IOError if \c data does not start with a valid vector array file header.
+ */
+NIAS_CPP_CORE_EXPORT VectorArrayFileHeader parse_vector_array_file_header(std::string_view data);
+
+/// Reads the header of the vector array file \c path
+NIAS_CPP_CORE_EXPORT VectorArrayFileHeader read_vector_array_file_header(const std::filesystem::path& path);
+
+/**
+ * \brief Writes a vector array file
+ *
+ * The data is written in chunks of (approximately) \c options.chunk_size bytes, using up to
+ * \c options.num_threads threads. To obtain the bytes <tt>[offset, offset + count)</tt> of the data,
+ * <tt>read_data(offset, count, buffer)</tt> is called (concurrently if several threads are used). Offsets
+ * and counts are multiples of the scalar size. The file is first written to a temporary file next to
+ * \c path, which then replaces \c path, so \c path is never left in a partially written state.
+ *
+ * \returns The header that has been written (including the checksum).
+ */
+NIAS_CPP_CORE_EXPORT VectorArrayFileHeader write_vector_array_file(
+    const std::filesystem::path& path, const VectorArrayFileHeader& header,
+    const std::function<void(ssize_t offset, ssize_t count, char* buffer)>& read_data,
+    const VectorArrayFileOptions& options = {});
+
+/**
+ * \brief Reads the data of the vector array file \c path
+ *
+ * For each chunk of the data, <tt>write_data(offset, count, buffer)</tt> is called (concurrently if several
+ * threads are used). \c header has to be the header of the file (see read_vector_array_file_header).
+ *
+ * \throws IOError if the file cannot be read or the checksum does not match.
+ */
+NIAS_CPP_CORE_EXPORT void read_vector_array_file(
+    const std::filesystem::path& path, const VectorArrayFileHeader& header,
+    const std::function<void(ssize_t offset, ssize_t count, const char* buffer)>& write_data,
+    const VectorArrayFileOptions& options = {});
+
+/**
+ * \brief Saves \c array to the vector array file \c path
+ *
+ * For MappedNpyVectorArrays in C order, the data is written directly from memory. For all other arrays,
+ * the entries are obtained using \c get, so the array has to support concurrent calls to \c get if
+ * <tt>options.num_threads != 1</tt>.
+ */
+template <floating_point_or_complex F>
+void save_vector_array(const VectorArrayInterface<F>& array, const std::filesystem::path& path,
+                       const VectorArrayFileOptions& options = {})
+{
+    const auto header = VectorArrayFileHeader::for_scalar_type<F>(array.size(), array.dim());
+    const auto* mapped_array = dynamic_cast<const MappedNpyVectorArray<F>*>(&array);
+    if (mapped_array != nullptr && !mapped_array->fortran_order())
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* data = reinterpret_cast<const char*>(mapped_array->data());
+        write_vector_array_file(
+            path, header,
+            [data](ssize_t offset, ssize_t count, char* buffer)
+            {
+                std::memcpy(buffer, data + offset, as_size_t(count));
+            },
+            options);
+        return;
+    }
+    write_vector_array_file(
+        path, header,
+        [&array](ssize_t offset, ssize_t count, char* buffer)
+        {
+            const auto dim = array.dim();
+            const auto first = offset / as_ssize_t(sizeof(F));
+            const auto num_entries = count / as_ssize_t(sizeof(F));
+            for (ssize_t k = 0; k < num_entries; ++k)
+            {
+                const F value = array.get((first + k) / dim, (first + k) % dim);
+                std::memcpy(buffer + (k * as_ssize_t(sizeof(F))), &value, sizeof(F));
+            }
+        },
+        options);
+}
+
+/// Loads the vector array file \c path into memory
+template <floating_point_or_complex F>
+[[nodiscard]] std::shared_ptr<MappedNpyVectorArray<F>> load_vector_array(
+    const std::filesystem::path& path, const VectorArrayFileOptions& options = {})
+{
+    const auto header = read_vector_array_file_header(path);
+    if (!header.has_scalar_type<F>())
+    {
+        throw InvalidArgumentError(
+            std::format("load_vector_array: scalar type of {} does not match", path.string()));
+    }
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(header.size, header.dim);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto* data = reinterpret_cast<char*>(ret->mutable_data());
+    read_vector_array_file(
+        path, header,
+        [data](ssize_t offset, ssize_t count, const char* buffer)
+        {
+            std::memcpy(data + offset, buffer, as_size_t(count));
+        },
+        options);
+    return ret;
+}
+
+/**
+ * \brief Maps the vector array file \c path into memory (read-only)
+ *
+ * Opening the file takes constant time (the data is only read when it is accessed), unless
+ * \c verify_checksum is \c true.
+ */
+template <floating_point_or_complex F>
+[[nodiscard]] std::shared_ptr<MappedNpyVectorArray<F>> open_vector_array(const std::filesystem::path& path,
+                                                                          bool verify_checksum = false)
+{
+    MappedFile file(path, MappedFileMode::read_only);
+    const std::string_view contents(file.data(), as_size_t(file.size()));
+    const auto header = parse_vector_array_file_header(contents);
+    if (!header.has_scalar_type<F>())
+    {
+        throw InvalidArgumentError(
+            std::format("open_vector_array: scalar type of {} does not match", path.string()));
+    }
+    if (file.size() < vector_array_file_header_size + header.data_size())
+    {
+        throw IOError(std::format("open_vector_array: {} is truncated", path.string()));
+    }
+    const auto data =
+        contents.substr(as_size_t(vector_array_file_header_size), as_size_t(header.data_size()));
+    if (verify_checksum && vector_array_file_checksum(data, header.checksum_block_size, 0) != header.checksum)
+    {
+        throw IOError(std::format("open_vector_array: checksum mismatch in {}", path.string()));
+    }
+    return MappedNpyVectorArray<F>::map(std::move(file), vector_array_file_header_size, header.size,
+                                        header.dim);
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_IO_VECTORARRAY_FILE_H
@@ -0,0 +1,279 @@
+#ifndef NIAS_CPP_OPERATORS_CSR_MATRIX_H
+#define NIAS_CPP_OPERATORS_CSR_MATRIX_H
+
+#include <algorithm>
+#include <complex>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/parallel.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Linear operator given by a sparse matrix in compressed sparse row (CSR) format
+ *
+ * The column indices of the nonzero entries of row \c i are
+ * <tt>column_indices()[row_offsets()[i]:row_offsets()[i + 1]]</tt>, the corresponding entries are stored at
+ * the same positions in <tt>values()</tt> (this is the format of scipy's csr_matrix, entries with the same
+ * column index are summed up).
+ *
+ * \c apply multiplies the matrix with all vectors at once (SpMM): the vectors are copied in blocks of
+ * \c vector_block_size vectors into a buffer in which the entries of all vectors of the block with the same
+ * index are stored next to each other, so each matrix entry is loaded once per block and multiplied with
+ * a contiguous chunk of the buffer. The result is split into tiles of one vector block and (at most)
+ * \c row_block_size rows, which are distributed over \c num_threads threads. \c apply_adjoint scatters the
+ * entries of the transposed product, so it only distributes whole vector blocks over the threads.
+ *
+ * The results are returned as (in-memory) MappedNpyVectorArrays.
+ */
+template <floating_point_or_complex F>
+class CsrMatrixOperator : public OperatorInterface<F>
+{
+   public:
+    using InterfaceType = OperatorInterface<F>;
+    using typename InterfaceType::ScalarType;
+
+    static constexpr ssize_t vector_block_size = 16;
+    static constexpr ssize_t row_block_size = 512;
+
+    /**
+     * \brief Construct from CSR data (e.g., the \c indptr, \c indices and \c data of a scipy csr_matrix)
+     *
+     * \param num_threads: Number of threads used in apply and apply_adjoint (0 means all hardware threads).
+     */
+    CsrMatrixOperator(ssize_t range_dim, ssize_t source_dim, std::vector<ssize_t> row_offsets,
+                      std::vector<ssize_t> column_indices, std::vector<F> values, ssize_t num_threads = 1)
+        : range_dim_(range_dim)
+        , source_dim_(source_dim)
+        , row_offsets_(std::move(row_offsets))
+        , column_indices_(std::move(column_indices))
+        , values_(std::move(values))
+        , num_threads_(num_threads)
+    {
+        check(range_dim >= 0 && source_dim >= 0, "dimensions must be non-negative.");
+        check(std::ssize(row_offsets_) == range_dim + 1 && row_offsets_.front() == 0 &&
+                  row_offsets_.back() == std::ssize(column_indices_) &&
+                  column_indices_.size() == values_.size(),
+              "row_offsets, column_indices and values do not describe a CSR matrix.");
+        for (ssize_t i = 0; i < range_dim; ++i)
+        {
+            check(row_offsets_[as_size_t(i)] <= row_offsets_[as_size_t(i + 1)],
+                  std::format("row_offsets must be non-decreasing (row {}).", i));
+        }
+        check(std::ranges::all_of(column_indices_,
+                                  [source_dim](ssize_t column)
+                                  {
+                                      return column >= 0 && column < source_dim;
+                                  }),
+              "column indices must be non-negative and smaller than source_dim.");
+        static_cast<void>(effective_num_threads(num_threads_));
+    }
+
+    [[nodiscard]] ssize_t source_dim() const override
+    {
+        return source_dim_;
+    }
+
+    [[nodiscard]] ssize_t range_dim() const override
+    {
+        return range_dim_;
+    }
+
+    /// Number of stored entries
+    [[nodiscard]] ssize_t nnz() const
+    {
+        return std::ssize(values_);
+    }
+
+    [[nodiscard]] ssize_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    [[nodiscard]] const std::vector<ssize_t>& row_offsets() const
+    {
+        return row_offsets_;
+    }
+
+    [[nodiscard]] const std::vector<ssize_t>& column_indices() const
+    {
+        return column_indices_;
+    }
+
+    [[nodiscard]] const std::vector<F>& values() const
+    {
+        return values_;
+    }
+
+    [[nodiscard]] std::shared_ptr<VectorArrayInterface<ScalarType>> apply(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(vec_array.dim() == source_dim_, "vectors do not have dimension source_dim.");
+        const auto index_vec = index_vector(indices, vec_array.size());
+        const auto num_vectors = std::ssize(index_vec);
+        const auto packed = pack(vec_array, index_vec);
+        auto ret = std::make_shared<MappedNpyVectorArray<F>>(num_vectors, range_dim_);
+        F* const result = ret->mutable_data();
+        const auto num_row_blocks = (range_dim_ + row_block_size - 1) / row_block_size;
+        parallel_for(
+            0, num_vector_blocks(num_vectors) * num_row_blocks,
+            [&](ssize_t tile)
+            {
+                const auto vector_block = tile / num_row_blocks;
+                const auto row_block = tile % num_row_blocks;
+                const auto [first_vector, block_size] = vector_block_range(vector_block, num_vectors);
+                const F* const block = packed.data() + (first_vector * source_dim_);
+                std::vector<F> row_result(as_size_t(block_size));
+                const auto row_end = std::min(range_dim_, (row_block + 1) * row_block_size);
+                for (ssize_t i = row_block * row_block_size; i < row_end; ++i)
+                {
+                    std::ranges::fill(row_result, F(0));
+                    for (ssize_t k = row_offsets_[as_size_t(i)]; k < row_offsets_[as_size_t(i + 1)]; ++k)
+                    {
+                        const F value = values_[as_size_t(k)];
+                        const F* const entries = block + (column_indices_[as_size_t(k)] * block_size);
+                        for (ssize_t v = 0; v < block_size; ++v)
+                        {
+                            row_result[as_size_t(v)] += value * entries[v];
+                        }
+                    }
+                    for (ssize_t v = 0; v < block_size; ++v)
+                    {
+                        result[((first_vector + v) * range_dim_) + i] = row_result[as_size_t(v)];
+                    }
+                }
+            },
+            num_threads_);
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<VectorArrayInterface<ScalarType>> apply_adjoint(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(vec_array.dim() == range_dim_, "vectors do not have dimension range_dim.");
+        const auto index_vec = index_vector(indices, vec_array.size());
+        const auto num_vectors = std::ssize(index_vec);
+        const auto packed = pack(vec_array, index_vec);
+        auto ret = std::make_shared<MappedNpyVectorArray<F>>(num_vectors, source_dim_);
+        F* const result = ret->mutable_data();
+        parallel_for(
+            0, num_vector_blocks(num_vectors),
+            [&](ssize_t vector_block)
+            {
+                const auto [first_vector, block_size] = vector_block_range(vector_block, num_vectors);
+                const F* const block = packed.data() + (first_vector * range_dim_);
+                // the result for the vector block (in the same layout as the packed vectors)
+                std::vector<F> block_result(as_size_t(source_dim_ * block_size), F(0));
+                for (ssize_t i = 0; i < range_dim_; ++i)
+                {
+                    const F* const entries = block + (i * block_size);
+                    for (ssize_t k = row_offsets_[as_size_t(i)]; k < row_offsets_[as_size_t(i + 1)]; ++k)
+                    {
+                        const F value = conj_if_complex(values_[as_size_t(k)]);
+                        const auto column = column_indices_[as_size_t(k)];
+                        F* const column_result = block_result.data() + (column * block_size);
+                        for (ssize_t v = 0; v < block_size; ++v)
+                        {
+                            column_result[v] += value * entries[v];
+                        }
+                    }
+                }
+                for (ssize_t v = 0; v < block_size; ++v)
+                {
+                    for (ssize_t j = 0; j < source_dim_; ++j)
+                    {
+                        result[((first_vector + v) * source_dim_) + j] =
+                            block_result[as_size_t((j * block_size) + v)];
+                    }
+                }
+            },
+            num_threads_);
+        return ret;
+    }
+
+   private:
+    void check(const bool condition, const std::string& message) const
+    {
+        if (!condition)
+        {
+            throw InvalidArgumentError("CsrMatrixOperator: " + message);
+        }
+    }
+
+    [[nodiscard]] static ssize_t num_vector_blocks(ssize_t num_vectors)
+    {
+        return (num_vectors + vector_block_size - 1) / vector_block_size;
+    }
+
+    // First vector and number of vectors of the given vector block
+    [[nodiscard]] static std::pair<ssize_t, ssize_t> vector_block_range(ssize_t vector_block,
+                                                                        ssize_t num_vectors)
+    {
+        const auto first_vector = vector_block * vector_block_size;
+        return {first_vector, std::min(vector_block_size, num_vectors - first_vector)};
+    }
+
+    /**
+     * \brief Copies the vectors index_vec of vec_array into a buffer, one vector block after the other
+     *
+     * Within the block starting at vector \c first_vector (with \c block_size vectors), entry \c j of vector
+     * <tt>first_vector + v</tt> is stored at position <tt>first_vector * dim + j * block_size + v</tt>. The
+     * entries of C-order MappedNpyVectorArrays are read directly (using all threads), all other arrays are
+     * read by \c get in the calling thread (since they may be implemented in Python).
+     */
+    [[nodiscard]] std::vector<F> pack(const VectorArrayInterface<F>& vec_array,
+                                      const std::vector<ssize_t>& index_vec) const
+    {
+        const auto dim = vec_array.dim();
+        const auto num_vectors = std::ssize(index_vec);
+        std::vector<F> ret(as_size_t(num_vectors * dim));
+        const auto* mapped = dynamic_cast<const MappedNpyVectorArray<F>*>(&vec_array);
+        const bool c_order = mapped != nullptr && !mapped->fortran_order();
+        const auto pack_block = [&](ssize_t vector_block)
+        {
+            const auto [first_vector, block_size] = vector_block_range(vector_block, num_vectors);
+            F* const block = ret.data() + (first_vector * dim);
+            for (ssize_t v = 0; v < block_size; ++v)
+            {
+                const auto index = index_vec[as_size_t(first_vector + v)];
+                for (ssize_t j = 0; j < dim; ++j)
+                {
+                    block[(j * block_size) + v] =
+                        c_order ? mapped->data()[(index * dim) + j] : vec_array.get(index, j);
+                }
+            }
+        };
+        parallel_for(0, num_vector_blocks(num_vectors), pack_block, c_order ? num_threads_ : 1);
+        return ret;
+    }
+
+    ssize_t range_dim_;
+    ssize_t source_dim_;
+    std::vector<ssize_t> row_offsets_;
+    std::vector<ssize_t> column_indices_;
+    std::vector<F> values_;
+    ssize_t num_threads_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_OPERATORS_CSR_MATRIX_H
@@ -0,0 +1,86 @@
+#ifndef NIAS_CPP_OPERATORS_IDENTITY_H
+#define NIAS_CPP_OPERATORS_IDENTITY_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/// Identity operator on vectors of dimension \c dim (applying it copies the vectors)
+template <floating_point_or_complex F>
+class IdentityOperator : public OperatorInterface<F>
+{
+   public:
+    using InterfaceType = OperatorInterface<F>;
+    using typename InterfaceType::ScalarType;
+
+    explicit IdentityOperator(ssize_t dim)
+        : dim_(dim)
+    {
+        if (dim < 0)
+        {
+            throw InvalidArgumentError("IdentityOperator: dim must be non-negative.");
+        }
+    }
+
+    [[nodiscard]] ssize_t source_dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] ssize_t range_dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] std::shared_ptr<VectorArrayInterface<ScalarType>> apply(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check_dim(vec_array);
+        return vec_array.copy(indices);
+    }
+
+    [[nodiscard]] std::shared_ptr<VectorArrayInterface<ScalarType>> apply_adjoint(
+        const VectorArrayInterface<ScalarType>& vec_array,
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check_dim(vec_array);
+        return vec_array.copy(indices);
+    }
+
+    [[nodiscard]] std::vector<std::vector<ScalarType>> apply2(
+        const VectorArrayInterface<ScalarType>& left, const VectorArrayInterface<ScalarType>& right,
+        const std::optional<Indices>& left_indices = std::nullopt,
+        const std::optional<Indices>& right_indices = std::nullopt) const override
+    {
+        check_dim(right);
+        return left.inner(right, left_indices, right_indices);
+    }
+
+   private:
+    void check_dim(const VectorArrayInterface<ScalarType>& vec_array) const
+    {
+        if (vec_array.dim() != dim_)
+        {
+            throw InvalidArgumentError("IdentityOperator: vectors have the wrong dimension.");
+        }
+    }
+
+    ssize_t dim_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_OPERATORS_IDENTITY_H
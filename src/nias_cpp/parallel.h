@@ -0,0 +1,106 @@
+#ifndef NIAS_CPP_PARALLEL_H
+#define NIAS_CPP_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief Returns the number of threads that should be used if \c num_threads threads were requested
+ *
+ * A value of 0 means "use all hardware threads". Negative values are invalid.
+ */
+inline ssize_t effective_num_threads(ssize_t num_threads)
+{
+    if (num_threads < 0)
+    {
+        throw InvalidArgumentError("num_threads must be non-negative");
+    }
+    if (num_threads == 0)
+    {
+        return std::max(ssize_t(1), as_ssize_t(std::thread::hardware_concurrency()));
+    }
+    return num_threads;
+}
+
+/**
+ * \brief Calls <tt>func(i)</tt> for all \c i in <tt>[begin, end)</tt> using up to \c num_threads threads
+ *
+ * Iterations are handed out dynamically (one at a time), so \c func should do a reasonable amount of
+ * work per call (e.g., process a tile instead of a single entry). If \c num_threads is 1 or there is
+ * only a single iteration, everything runs in the calling thread. If one of the calls throws, the
+ * remaining iterations are skipped and the first exception is rethrown in the calling thread.
+ *
+ * \param num_threads: Number of threads to use, 0 means all hardware threads (see effective_num_threads).
+ */
+template <class Func>
+void parallel_for(ssize_t begin, ssize_t end, Func&& func, ssize_t num_threads = 0)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+    const ssize_t num_workers = std::min(effective_num_threads(num_threads), end - begin);
+    if (num_workers == 1)
+    {
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+    std::atomic<ssize_t> next{begin};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_exception;
+    std::mutex exception_mutex;
+    const auto work = [&]()
+    {
+        for (ssize_t i = next++; i < end && !failed; i = next++)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!failed.exchange(true))
+                {
+                    first_exception = std::current_exception();
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(as_size_t(num_workers - 1));
+    for (ssize_t t = 0; t < num_workers - 1; ++t)
+    {
+        threads.emplace_back(work);
+    }
+    // the calling thread does its share of the work, too
+    work();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (first_exception)
+    {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_PARALLEL_H
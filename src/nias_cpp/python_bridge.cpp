@@ -0,0 +1,107 @@
+#include "python_bridge.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <nias_cpp/interpreter.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+namespace nias
+{
+
+
+struct PythonBridge::Cache
+{
+    std::map<std::string, pybind11::module_> modules;
+    std::map<std::string, pybind11::object> attributes;
+    pybind11::object nias_vector_array_impl;
+    pybind11::object nias_vector_array;
+    pybind11::object nias_inner_product;
+    pybind11::object nias_gram_schmidt;
+};
+
+PythonBridge& PythonBridge::instance()
+{
+    // The constructor starts the interpreter (which is a function-local static, too), so the bridge is
+    // destroyed before the interpreter is finalized.
+    static PythonBridge bridge;
+    return bridge;
+}
+
+PythonBridge::PythonBridge()
+    : cache_(new Cache())
+{
+    try
+    {
+        ensure_interpreter_and_venv_are_active();
+        const pybind11::gil_scoped_acquire gil;
+        // the bindings module has to be imported so that pybind11 is able to convert the nias_cpp types
+        static_cast<void>(module("nias_cpp_bindings"));
+        const std::string vectorarray_module = "nias.bindings.nias_cpp.vectorarray";
+        cache_->nias_vector_array_impl = attribute(vectorarray_module, "NiasCppVectorArrayImpl");
+        cache_->nias_vector_array = attribute(vectorarray_module, "NiasCppVectorArray");
+        cache_->nias_inner_product = attribute("nias.bindings.nias_cpp.product", "NiasCppInnerProduct");
+        cache_->nias_gram_schmidt = attribute("nias.linalg.gram_schmidt", "gram_schmidt");
+    }
+    catch (...)
+    {
+        delete cache_;
+        throw;
+    }
+}
+
+PythonBridge::~PythonBridge()
+{
+    // the GIL may have been released by another thread (e.g., by the PythonExecutor)
+    const pybind11::gil_scoped_acquire gil;
+    delete cache_;
+}
+
+const pybind11::module_& PythonBridge::module(const std::string& module_name)
+{
+    auto it = cache_->modules.find(module_name);
+    if (it == cache_->modules.end())
+    {
+        it = cache_->modules.emplace(module_name, pybind11::module_::import(module_name.c_str())).first;
+    }
+    return it->second;
+}
+
+const pybind11::object& PythonBridge::attribute(const std::string& module_name,
+                                                const std::string& attribute_name)
+{
+    const auto key = module_name + "." + attribute_name;
+    auto it = cache_->attributes.find(key);
+    if (it == cache_->attributes.end())
+    {
+        pybind11::object attr = module(module_name).attr(attribute_name.c_str());
+        it = cache_->attributes.emplace(key, std::move(attr)).first;
+    }
+    return it->second;
+}
+
+const pybind11::object& PythonBridge::nias_vector_array_impl() const
+{
+    return cache_->nias_vector_array_impl;
+}
+
+const pybind11::object& PythonBridge::nias_vector_array() const
+{
+    return cache_->nias_vector_array;
+}
+
+const pybind11::object& PythonBridge::nias_inner_product() const
+{
+    return cache_->nias_inner_product;
+}
+
+const pybind11::object& PythonBridge::nias_gram_schmidt() const
+{
+    return cache_->nias_gram_schmidt;
+}
+
+
+}  // namespace nias
@@ -0,0 +1,73 @@
+#ifndef NIAS_CPP_PYTHON_BRIDGE_H
+#define NIAS_CPP_PYTHON_BRIDGE_H
+
+#include <string>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+#include "nias_cpp_export.h"
+
+namespace nias
+{
+
+
+/**
+ * \brief Process-wide cache of the Python modules and objects used by Python-backed algorithms
+ *
+ * Importing a module and resolving its attributes is comparatively expensive, even if the module has
+ * already been imported (the import machinery still has to be run and several dictionary lookups are
+ * needed). The bridge resolves the objects once and keeps references to them, so repeated calls of
+ * Python-backed algorithms (e.g., gram_schmidt) only pay for the actual call.
+ *
+ * The bridge is created on the first call of \c instance, which also starts the interpreter (see
+ * ensure_interpreter_and_venv_are_active) and resolves the NiAS objects that are used by nias_cpp.
+ * Further modules and attributes can be resolved (and cached) via \c module and \c attribute.
+ *
+ * \note As for all Python objects, the bridge (except for \c instance) may only be used while holding the
+ * GIL. The GIL is also what protects the internal cache, so no additional locking is done.
+ */
+class NIAS_CPP_EXPORT PythonBridge
+{
+   public:
+    /// \brief Returns the bridge (creating it on first use)
+    static PythonBridge& instance();
+
+    ~PythonBridge();
+
+    PythonBridge(const PythonBridge&) = delete;
+    PythonBridge(PythonBridge&&) = delete;
+    PythonBridge& operator=(const PythonBridge&) = delete;
+    PythonBridge& operator=(PythonBridge&&) = delete;
+
+    /// \brief Returns the Python module \c module_name (imported on first use)
+    const pybind11::module_& module(const std::string& module_name);
+
+    /// \brief Returns the attribute \c attribute_name of the module \c module_name (resolved on first use)
+    const pybind11::object& attribute(const std::string& module_name, const std::string& attribute_name);
+
+    /// \brief The class nias.bindings.nias_cpp.vectorarray.NiasCppVectorArrayImpl
+    [[nodiscard]] const pybind11::object& nias_vector_array_impl() const;
+
+    /// \brief The class nias.bindings.nias_cpp.vectorarray.NiasCppVectorArray
+    [[nodiscard]] const pybind11::object& nias_vector_array() const;
+
+    /// \brief The class nias.bindings.nias_cpp.product.NiasCppInnerProduct
+    [[nodiscard]] const pybind11::object& nias_inner_product() const;
+
+    /// \brief The function nias.linalg.gram_schmidt.gram_schmidt
+    [[nodiscard]] const pybind11::object& nias_gram_schmidt() const;
+
+   private:
+    PythonBridge();
+
+    struct Cache;
+
+    // See the comment on Indices::indices_ on why this is a pointer
+    Cache* cache_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_PYTHON_BRIDGE_H
@@ -0,0 +1,132 @@
+#include "python_executor.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/interpreter.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+
+namespace nias
+{
+
+
+struct PythonExecutor::State
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::function<void()>> queue;
+    bool stop = false;
+    size_t num_batches = 0;
+    size_t num_tasks = 0;
+    // thread state of the constructing thread if it held the GIL (restored in the destructor)
+    PyThreadState* released_thread_state = nullptr;
+    std::thread worker;
+};
+
+PythonExecutor& PythonExecutor::instance()
+{
+    // The constructor starts the interpreter (if necessary), so the executor is destroyed before the
+    // interpreter is finalized.
+    static PythonExecutor executor;
+    return executor;
+}
+
+PythonExecutor::PythonExecutor()
+    : state_(new State())
+{
+    ensure_interpreter_and_venv_are_active();
+    if (PyGILState_Check() != 0)
+    {
+        state_->released_thread_state = PyEval_SaveThread();
+    }
+    state_->worker = std::thread(
+        [state = state_]()
+        {
+            // keep the thread state of the worker for its whole lifetime
+            const pybind11::gil_scoped_acquire gil;
+            std::vector<std::function<void()>> batch;
+            while (true)
+            {
+                {
+                    // do not block other Python threads while waiting
+                    const pybind11::gil_scoped_release release;
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->condition.wait(lock,
+                                          [state]()
+                                          {
+                                              return state->stop || !state->queue.empty();
+                                          });
+                    if (state->queue.empty())
+                    {
+                        // stop was requested and all tasks are done
+                        break;
+                    }
+                    batch.swap(state->queue);
+                    ++state->num_batches;
+                    state->num_tasks += batch.size();
+                }
+                // exceptions are caught by the packaged_task and passed on to the future
+                for (auto& task : batch)
+                {
+                    task();
+                }
+                batch.clear();
+            }
+        });
+}
+
+PythonExecutor::~PythonExecutor()
+{
+    {
+        const std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stop = true;
+    }
+    state_->condition.notify_one();
+    state_->worker.join();
+    if (state_->released_thread_state != nullptr)
+    {
+        PyEval_RestoreThread(state_->released_thread_state);
+    }
+    delete state_;
+}
+
+bool PythonExecutor::on_worker_thread() const
+{
+    return std::this_thread::get_id() == state_->worker.get_id();
+}
+
+size_t PythonExecutor::num_batches() const
+{
+    const std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->num_batches;
+}
+
+size_t PythonExecutor::num_tasks() const
+{
+    const std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->num_tasks;
+}
+
+bool PythonExecutor::runs_tasks_directly() const
+{
+    return on_worker_thread() || PyGILState_Check() != 0;
+}
+
+void PythonExecutor::enqueue(std::function<void()> task)
+{
+    {
+        const std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->queue.push_back(std::move(task));
+    }
+    state_->condition.notify_one();
+}
+
+
+}  // namespace nias
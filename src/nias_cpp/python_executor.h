@@ -0,0 +1,112 @@
+#ifndef NIAS_CPP_PYTHON_EXECUTOR_H
+#define NIAS_CPP_PYTHON_EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "nias_cpp_export.h"
+
+namespace nias
+{
+
+
+/**
+ * \brief Executes Python-backed tasks from arbitrary C++ threads on a dedicated Python thread
+ *
+ * Tasks submitted from any thread are queued and executed (in submission order) on the worker thread of
+ * the executor. The worker acquires the GIL once for all tasks that are queued when it wakes up, so
+ * consecutive requests are batched instead of paying for a GIL hand-over per task. While waiting for
+ * tasks, the worker does not hold the GIL.
+ *
+ * On construction (i.e., on the first call of \c instance), the interpreter is started if necessary (see
+ * ensure_interpreter_and_venv_are_active). If the constructing thread holds the GIL afterwards (which is the
+ * case for the thread that started the interpreter), the GIL is released, so that the worker can acquire it.
+ * From then on, code that uses Python directly (instead of through the executor) has to acquire the GIL
+ * itself, e.g., using <tt>pybind11::gil_scoped_acquire</tt> (the Python-backed algorithms in nias_cpp do so).
+ * The executor should thus be created by the thread that started the interpreter, before any other threads
+ * submit tasks.
+ *
+ * Tasks submitted from the worker thread itself or from a thread that currently holds the GIL are executed
+ * directly (the worker would not be able to run them anyway).
+ *
+ * \note Python >= 3.12 supports sub-interpreters with their own GIL, which would allow to run independent
+ * tasks in parallel. This is not used since neither pybind11 nor NumPy support sub-interpreters yet.
+ */
+class NIAS_CPP_EXPORT PythonExecutor
+{
+   public:
+    /// \brief Returns the executor (creating it on first use)
+    static PythonExecutor& instance();
+
+    ~PythonExecutor();
+
+    PythonExecutor(const PythonExecutor&) = delete;
+    PythonExecutor(PythonExecutor&&) = delete;
+    PythonExecutor& operator=(const PythonExecutor&) = delete;
+    PythonExecutor& operator=(PythonExecutor&&) = delete;
+
+    /**
+     * \brief Schedules \c func for execution on the Python thread
+     *
+     * \returns A future for the result of \c func. Exceptions thrown by \c func are rethrown by
+     * <tt>future.get()</tt>.
+     */
+    template <class Func>
+    [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<Func>>> submit(Func&& func)
+    {
+        using ResultType = std::invoke_result_t<std::decay_t<Func>>;
+        // std::function requires a copyable callable, so we wrap the (move-only) packaged_task
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        if (runs_tasks_directly())
+        {
+            (*task)();
+        }
+        else
+        {
+            enqueue(
+                [task]()
+                {
+                    (*task)();
+                });
+        }
+        return future;
+    }
+
+    /// \brief Executes \c func on the Python thread and waits for the result
+    template <class Func>
+    decltype(auto) run(Func&& func)
+    {
+        return submit(std::forward<Func>(func)).get();
+    }
+
+    /// \brief Whether the calling thread is the worker thread of the executor
+    [[nodiscard]] bool on_worker_thread() const;
+
+    /// \brief Number of batches (i.e., GIL acquisitions of the worker) so far
+    [[nodiscard]] size_t num_batches() const;
+
+    /// \brief Number of tasks executed by the worker so far
+    [[nodiscard]] size_t num_tasks() const;
+
+   private:
+    PythonExecutor();
+
+    [[nodiscard]] bool runs_tasks_directly() const;
+
+    void enqueue(std::function<void()> task);
+
+    struct State;
+
+    // See the comment on Indices::indices_ on why this is a pointer
+    State* state_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_PYTHON_EXECUTOR_H
@@ -0,0 +1,289 @@
+#ifndef NIAS_CPP_REDUCED_PRECISION_H
+#define NIAS_CPP_REDUCED_PRECISION_H
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/type_traits.h>
+
+// The F16C conversion kernels are compiled with GCC and Clang on x86 CPUs, also if the compiler flags do not
+// enable F16C (they are only used if the CPU supports F16C then, see f16c_supported)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NIAS_CPP_HAS_F16C_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace nias
+{
+
+
+/**
+ * \brief IEEE 754 half precision floating point number
+ *
+ * Only used for storing numbers, computations are done after converting to float or double (see widen and
+ * narrow). Half precision numbers have 11 significant bits and a maximal value of 65504.
+ */
+struct float16
+{
+    std::uint16_t bits = 0;
+
+    bool operator==(const float16& other) const = default;
+};
+
+/**
+ * \brief bfloat16 ("brain floating point") number, i.e., the upper 16 bits of a single precision number
+ *
+ * Only used for storing numbers (see float16). bfloat16 numbers have the same range as float but only 8
+ * significant bits.
+ */
+struct bfloat16
+{
+    std::uint16_t bits = 0;
+
+    bool operator==(const bfloat16& other) const = default;
+};
+
+/// Scalar types that can be used for storing the entries of a ReducedPrecisionVectorArray
+template <class S>
+concept storage_scalar = any_of<S, float16, bfloat16, float, double>;
+
+/// Machine epsilon (distance from 1 to the next larger number) of the storage type \c S
+template <storage_scalar S>
+constexpr double storage_epsilon()
+{
+    if constexpr (std::same_as<S, float16>)
+    {
+        return 0x1p-10;
+    }
+    else if constexpr (std::same_as<S, bfloat16>)
+    {
+        return 0x1p-7;
+    }
+    else
+    {
+        return std::numeric_limits<S>::epsilon();
+    }
+}
+
+/// Converts a half precision number to float (exactly)
+inline float widen(float16 value)
+{
+    // see https://gist.github.com/rygorous/2144712 (half_to_float_fast5)
+    constexpr std::uint32_t shifted_exponent = 0x7c00U << 13U;
+    const auto magic = std::bit_cast<float>((127U - 15U + 1U) << 23U);
+    std::uint32_t ret = (value.bits & 0x7fffU) << 13U;
+    const std::uint32_t exponent = ret & shifted_exponent;
+    ret += (127U - 15U) << 23U;
+    if (exponent == shifted_exponent)
+    {
+        // infinity or NaN
+        ret += (128U - 16U) << 23U;
+    }
+    else if (exponent == 0)
+    {
+        // zero or subnormal number, renormalized by a floating point subtraction
+        ret += 1U << 23U;
+        ret = std::bit_cast<std::uint32_t>(std::bit_cast<float>(ret) - magic);
+    }
+    return std::bit_cast<float>(ret | (std::uint32_t(value.bits & 0x8000U) << 16U));
+}
+
+/// Converts a bfloat16 number to float (exactly)
+inline float widen(bfloat16 value)
+{
+    return std::bit_cast<float>(std::uint32_t(value.bits) << 16U);
+}
+
+/// Converts a float to half precision (rounding to nearest even, numbers that are too large become infinite)
+template <std::same_as<float16> S>
+S narrow(float value)
+{
+    // see https://gist.github.com/rygorous/2156668 (float_to_half_fast3_rtne)
+    std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = bits & 0x80000000U;
+    bits ^= sign;
+    std::uint32_t ret = 0;
+    if (bits >= 0x47800000U)
+    {
+        // too large for half precision (infinity) or NaN (which stays a quiet NaN)
+        ret = bits > 0x7f800000U ? 0x7e00U : 0x7c00U;
+    }
+    else if (bits < 0x38800000U)
+    {
+        // the result is subnormal (or zero), let the floating point addition do the rounding
+        const auto magic = std::bit_cast<float>(((127U - 15U) + (23U - 10U) + 1U) << 23U);
+        ret = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) + magic) -
+              std::bit_cast<std::uint32_t>(magic);
+    }
+    else
+    {
+        const std::uint32_t mantissa_odd = (bits >> 13U) & 1U;
+        // adjust the exponent and round (the carry of the rounding propagates into the exponent)
+        bits -= (127U - 15U) << 23U;
+        bits += 0xfffU + mantissa_odd;
+        ret = bits >> 13U;
+    }
+    return S{static_cast<std::uint16_t>(ret | (sign >> 16U))};
+}
+
+/// Converts a float to bfloat16 (rounding to nearest even)
+template <std::same_as<bfloat16> S>
+S narrow(float value)
+{
+    const auto bits = std::bit_cast<std::uint32_t>(value);
+    if ((bits & 0x7fffffffU) > 0x7f800000U)
+    {
+        // make sure that NaNs stay NaNs (truncating could result in infinity)
+        return S{static_cast<std::uint16_t>((bits >> 16U) | 0x0040U)};
+    }
+    const std::uint32_t rounding_bias = 0x7fffU + ((bits >> 16U) & 1U);
+    return S{static_cast<std::uint16_t>((bits + rounding_bias) >> 16U)};
+}
+
+/**
+ * \brief Converts a double (or long double) to float, rounding to odd
+ *
+ * The result is the float next to \c value (in the direction of zero) with the last mantissa bit set if
+ * \c value is not exactly representable. Rounding this result to a type with at least two significant bits
+ * less than float (e.g., half precision or bfloat16) gives the same result as rounding \c value directly,
+ * while rounding to nearest twice can be off by one unit in the last place.
+ */
+template <std::floating_point F>
+float round_to_odd_float(F value)
+{
+    const auto rounded = static_cast<float>(value);
+    if (std::isnan(value) || static_cast<F>(rounded) == value)
+    {
+        return rounded;
+    }
+    auto magnitude_bits = std::bit_cast<std::uint32_t>(rounded) & 0x7fffffffU;
+    if (std::abs(static_cast<F>(rounded)) > std::abs(value))
+    {
+        // rounded away from zero (the bits of floats are ordered like their magnitudes)
+        --magnitude_bits;
+    }
+    const std::uint32_t sign = std::signbit(value) ? 0x80000000U : 0U;
+    return std::bit_cast<float>(sign | magnitude_bits | 1U);
+}
+
+/// Converts \c value to the storage type \c S (no-op if \c S is \c F), rounding to nearest even
+template <storage_scalar S, std::floating_point F>
+S narrow(F value)
+{
+    if constexpr (any_of<S, float, double>)
+    {
+        return static_cast<S>(value);
+    }
+    else
+    {
+        // only round once (see round_to_odd_float, which returns floats unchanged)
+        return narrow<S>(round_to_odd_float(value));
+    }
+}
+
+/// Converts \c value from the storage type \c S to \c F
+template <std::floating_point F, storage_scalar S>
+F widen(S value)
+{
+    if constexpr (any_of<S, float, double>)
+    {
+        return static_cast<F>(value);
+    }
+    else
+    {
+        return static_cast<F>(widen(value));
+    }
+}
+
+#ifdef NIAS_CPP_HAS_F16C_KERNELS
+/// Whether the CPU supports F16C (checked once at runtime unless the compiler flags already enable F16C)
+inline bool f16c_supported()
+{
+#if defined(__F16C__) && defined(__AVX__)
+    return true;
+#else
+    static const bool ret = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    return ret;
+#endif
+}
+
+/// Converts the numbers in \c in in chunks of 8 using F16C, returns the number of converted numbers
+[[gnu::target("avx,f16c")]] inline ssize_t widen_f16c(const float16* in, ssize_t count, float* out)
+{
+    ssize_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(half));
+    }
+    return i;
+}
+
+/// Counterpart of widen_f16c
+[[gnu::target("avx,f16c")]] inline ssize_t narrow_f16c(const float* in, ssize_t count, float16* out)
+{
+    ssize_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), half);
+    }
+    return i;
+}
+#endif
+
+/**
+ * \brief Converts the \c count numbers in \c in from the storage type \c S to \c F
+ *
+ * The loops are simple enough to be vectorized by the compiler. Conversions between half and single
+ * precision use the F16C instructions if the CPU supports them (see f16c_supported).
+ */
+template <std::floating_point F, storage_scalar S>
+void widen(const S* in, ssize_t count, F* out)
+{
+    ssize_t i = 0;
+#ifdef NIAS_CPP_HAS_F16C_KERNELS
+    if constexpr (std::same_as<S, float16> && std::same_as<F, float>)
+    {
+        if (f16c_supported())
+        {
+            i = widen_f16c(in, count, out);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = widen<F>(in[i]);
+    }
+}
+
+/// Converts the \c count numbers in \c in to the storage type \c S (see widen)
+template <storage_scalar S, std::floating_point F>
+void narrow(const F* in, ssize_t count, S* out)
+{
+    ssize_t i = 0;
+#ifdef NIAS_CPP_HAS_F16C_KERNELS
+    if constexpr (std::same_as<S, float16> && std::same_as<F, float>)
+    {
+        if (f16c_supported())
+        {
+            i = narrow_f16c(in, count, out);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = narrow<S>(in[i]);
+    }
+}
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_REDUCED_PRECISION_H
@@ -1,6 +1,7 @@
 #ifndef NIAS_CPP_TYPE_TRAITS_H
 #define NIAS_CPP_TYPE_TRAITS_H
 
+#include <complex>
 #include <cstddef>
 #include <type_traits>
 
@@ -18,6 +19,41 @@ struct always_false : public std::false_type
 {
 };
 
+/**
+ * \brief Real type corresponding to a (possibly complex) scalar type
+ *
+ * For real types \c F, \c real_type_t<F> is \c F itself, for <tt>std::complex<R></tt> it is \c R.
+ * This is, e.g., the type of norms of vectors with entries of type \c F.
+ */
+template <class F>
+struct real_type
+{
+    using type = F;
+};
+
+template <class F>
+struct real_type<std::complex<F>>
+{
+    using type = F;
+};
+
+template <class F>
+using real_type_t = typename real_type<F>::type;
+
+/// Complex conjugate of \c value (\c value itself for real types)
+template <class F>
+[[nodiscard]] constexpr F conj_if_complex(const F& value)
+{
+    if constexpr (std::is_same_v<F, std::complex<real_type_t<F>>>)
+    {
+        return std::conj(value);
+    }
+    else
+    {
+        return value;
+    }
+}
+
 }  // namespace nias
 
 #endif  // NIAS_CPP_TYPE_TRAITS_H
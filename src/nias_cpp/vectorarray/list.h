@@ -9,8 +9,10 @@
 #include <set>
 #include <string>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
+#include <nias_cpp/algorithms/dot_product.h>
 #include <nias_cpp/checked_integer_cast.h>
 #include <nias_cpp/concepts.h>
 #include <nias_cpp/exceptions.h>
@@ -29,6 +31,7 @@ class ListVectorArray : public VectorArrayInterface<F>
     using ThisType = ListVectorArray;
     using VectorInterfaceType = VectorInterface<F>;
     using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
 
    public:
     // Create an empty ListVectorArray with the given dimension
@@ -91,6 +94,7 @@ class ListVectorArray : public VectorArrayInterface<F>
 
     [[nodiscard]] VectorInterface<F>& vector(ssize_t i) override
     {
+        this->record_modification();
         return *vectors_.at(as_size_t(i));
     }
 
@@ -103,6 +107,7 @@ class ListVectorArray : public VectorArrayInterface<F>
     void set(ssize_t i, ssize_t j, F value) override
     {
         this->check_indices(i, j);
+        this->record_modification();
         vectors_[as_size_t(i)]->get(j) = value;
     }
 
@@ -143,6 +148,7 @@ class ListVectorArray : public VectorArrayInterface<F>
                 const std::optional<Indices>& other_indices = std::nullopt) override
     {
         check(is_list_vector_array(other), "append is not (yet) implemented if x is not a ListVectorArray");
+        this->record_append();
         remove_from_other ? append_with_removal(dynamic_cast<ThisType&>(other), other_indices)
                           : append_without_removal(dynamic_cast<ThisType&>(other), other_indices);
     }
@@ -150,11 +156,13 @@ class ListVectorArray : public VectorArrayInterface<F>
     // TODO: Think about append signatures
     void append(const std::shared_ptr<VectorInterfaceType>& new_vector)
     {
+        this->record_append();
         vectors_.push_back(new_vector->copy());
     }
 
     void append(const std::vector<std::shared_ptr<VectorInterfaceType>>& new_vectors)
     {
+        this->record_append();
         vectors_.reserve(vectors_.size() + new_vectors.size());
         for (const auto& vec : new_vectors)
         {
@@ -166,11 +174,13 @@ class ListVectorArray : public VectorArrayInterface<F>
         requires std::derived_from<VectorType, VectorInterfaceType>
     void emplace_back(Args&&... args)
     {
+        this->record_append();
         vectors_.emplace_back(std::make_shared<VectorType>(std::forward<Args>(args)...));
     }
 
     void delete_vectors(const std::optional<Indices>& indices) override
     {
+        this->record_deletion();
         if (!indices)
         {
             vectors_.clear();
@@ -188,6 +198,156 @@ class ListVectorArray : public VectorArrayInterface<F>
         }
     }
 
+    void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
+    {
+        const auto index_vec = this->index_vector(indices, this->size());
+        check(alpha.size() == 1 || alpha.size() == index_vec.size(),
+              "alpha must have size 1 or the same size as indices.");
+        this->record_modification();
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            vectors_[as_size_t(index_vec[i])]->scal(alpha.size() == 1 ? alpha[0] : alpha[i]);
+        }
+    }
+
+    void axpy(const std::vector<F>& alpha, const InterfaceType& x,
+              const std::optional<Indices>& indices = std::nullopt,
+              const std::optional<Indices>& x_indices = std::nullopt) override
+    {
+        const auto* x_list = dynamic_cast<const ThisType*>(&x);
+        if (x_list == nullptr)
+        {
+            InterfaceType::axpy(alpha, x, indices, x_indices);
+            return;
+        }
+        check(this->is_compatible_array(x), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, this->size());
+        const auto x_index_vec = this->index_vector(x_indices, x.size());
+        check(x_index_vec.size() == index_vec.size() || x_index_vec.size() == 1,
+              "x must have length 1 or the same length as this");
+        check(alpha.size() == index_vec.size() || alpha.size() == 1,
+              "alpha must be scalar or have the same length as this");
+        this->record_modification();
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto& x_vec = *x_list->vectors_[as_size_t(x_index_vec[x_index_vec.size() == 1 ? 0 : i])];
+            vectors_[as_size_t(index_vec[i])]->axpy(alpha.size() == 1 ? alpha[0] : alpha[i], x_vec);
+        }
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_list = dynamic_cast<const ThisType*>(&other);
+        if (other_list == nullptr)
+        {
+            return InterfaceType::inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, this->size());
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(other_index_vec.size()));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto& vec = *vectors_[as_size_t(index_vec[i])];
+            for (size_t j = 0; j < other_index_vec.size(); ++j)
+            {
+                ret[i][j] = dot_product(vec, *other_list->vectors_[as_size_t(other_index_vec[j])]);
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_list = dynamic_cast<const ThisType*>(&other);
+        if (other_list == nullptr)
+        {
+            return InterfaceType::pairwise_inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, this->size());
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        check(index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret[i] = dot_product(*vectors_[as_size_t(index_vec[i])],
+                                 *other_list->vectors_[as_size_t(other_index_vec[i])]);
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        const auto index_vec = this->index_vector(indices, this->size());
+        std::vector<RealType> ret(index_vec.size(), RealType(0));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto& vec = *vectors_[as_size_t(index_vec[i])];
+            for (ssize_t k = 0; k < dim_; ++k)
+            {
+                ret[i] += this->abs2(vec.get(k));
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        this->check_lincomb_coefficients(coefficients);
+        std::vector<std::shared_ptr<VectorInterfaceType>> new_vectors;
+        new_vectors.reserve(coefficients.size());
+        for (const auto& row : coefficients)
+        {
+            // zero coefficients are skipped, so that non-finite entries of their vectors do not propagate
+            auto new_vec = vectors_[0]->copy();
+            for (ssize_t j = 0; j < dim_; ++j)
+            {
+                new_vec->get(j) = F(0);
+            }
+            for (size_t k = 0; k < vectors_.size(); ++k)
+            {
+                if (row[k] != F(0))
+                {
+                    new_vec->axpy(row[k], *vectors_[k]);
+                }
+            }
+            new_vectors.push_back(std::move(new_vec));
+        }
+        return std::make_shared<ThisType>(std::move(new_vectors), dim_);
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(dim_ > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = this->index_vector(indices, this->size());
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{std::vector<ssize_t>(index_vec.size(), 0),
+                                                                   std::vector<RealType>(index_vec.size())};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto& vec = *vectors_[as_size_t(index_vec[i])];
+            ret.second[i] = std::abs(vec.get(0));
+            for (ssize_t k = 1; k < dim_; ++k)
+            {
+                const RealType value = std::abs(vec.get(k));
+                if (value > ret.second[i])
+                {
+                    ret.first[i] = k;
+                    ret.second[i] = value;
+                }
+            }
+        }
+        return ret;
+    }
+
     using InterfaceType::axpy;
     using InterfaceType::scal;
 
@@ -256,6 +416,7 @@ class ListVectorArray : public VectorArrayInterface<F>
             vectors_.insert(vectors_.end(), std::make_move_iterator(other.vectors_.begin()),
                             std::make_move_iterator(other.vectors_.end()));
             other.vectors_.clear();
+            other.record_deletion();
         }
         else
         {
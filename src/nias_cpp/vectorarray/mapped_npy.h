@@ -0,0 +1,835 @@
+#ifndef NIAS_CPP_VECTORARRAY_MAPPED_NPY_H
+#define NIAS_CPP_VECTORARRAY_MAPPED_NPY_H
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/io/mapped_file.h>
+#include <nias_cpp/io/npy.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief VectorArray stored in a memory-mapped file in NumPy's \c .npy format
+ *
+ * The file contains a two-dimensional array with one vector per row (like a NumpyVectorArray), so arrays
+ * written with \c numpy.save can be opened directly and files written by this class can be read with
+ * \c numpy.load (or \c numpy.memmap). Since the file is memory-mapped, arrays larger than the available
+ * memory can be used; the operating system loads and evicts pages as needed.
+ *
+ * The bulk operations (\c inner, \c pairwise_inner, \c norm2, \c amax, \c scal, \c axpy and \c lincomb)
+ * stream through the file in blocks of (approximately) \c block_size bytes. While a block is processed, the
+ * next one is prefetched, and blocks that have been processed are released again, so that streaming through
+ * a huge array does not evict everything else from memory.
+ *
+ * Files in Fortran order (i.e., with the entries of each vector spread over the whole file) are supported,
+ * but the bulk operations fall back to the generic implementations for them and \c append has to move the
+ * whole data, so C order should be preferred.
+ *
+ * To make appending vectors one at a time cheap, files and shared memory objects in C order grow
+ * geometrically: room for further vectors is reserved at the end (readers of \c .npy files ignore trailing
+ * bytes). For files, the reserved room is removed again by \c flush and on destruction.
+ *
+ * Arrays created by the (size, dim) constructor, by \c copy or by \c lincomb are not backed by a file.
+ * Arrays can also be stored in POSIX shared memory (see create_shared_memory), which allows several
+ * processes to work on the same vectors without copying them.
+ *
+ * \note Mapping files is currently only supported on POSIX systems.
+ */
+template <floating_point_or_complex F>
+class MappedNpyVectorArray : public VectorArrayInterface<F>
+{
+    using ThisType = MappedNpyVectorArray;
+    using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
+
+   public:
+    static constexpr ssize_t default_block_size = ssize_t(64) << 20;
+
+    /// Create an array of \c size zero vectors of dimension \c dim in memory (not backed by a file)
+    explicit MappedNpyVectorArray(ssize_t size, ssize_t dim)
+        : MappedNpyVectorArray(MappedFile(), size, dim, false)
+    {
+    }
+
+    /**
+     * \brief Open an existing \c .npy file
+     *
+     * The file has to contain a two-dimensional array with scalar type \c F (in native byte order).
+     */
+    explicit MappedNpyVectorArray(const std::filesystem::path& path,
+                                  MappedFileMode mode = MappedFileMode::read_only)
+        : MappedNpyVectorArray(MappedFile(path, mode), path.string())
+    {
+    }
+
+    /**
+     * \brief Create a new \c .npy file containing \c size zero vectors of dimension \c dim
+     *
+     * An existing file is overwritten. The file is opened for reading and writing.
+     */
+    [[nodiscard]] static std::shared_ptr<ThisType> create(const std::filesystem::path& path, ssize_t size,
+                                                          ssize_t dim, bool fortran_order = false)
+    {
+        // the constructor is private, so we cannot use std::make_shared here
+        return std::shared_ptr<ThisType>(new ThisType(MappedFile::create(path, 0), size, dim, fortran_order));
+    }
+
+    /**
+     * \brief Create a new POSIX shared memory object containing \c size zero vectors of dimension \c dim
+     *
+     * The shared memory object contains the data in \c .npy format, so other processes can attach to it
+     * using open_shared_memory without copying the data. The object persists until
+     * <tt>MappedFile::unlink_shared_memory(name)</tt> is called (see MappedFile::create_shared_memory).
+     *
+     * \note Changes of the size (by \c append or \c delete_vectors) are not propagated to arrays attached
+     * to the same shared memory object, so the size should not be changed while other processes use it.
+     */
+    [[nodiscard]] static std::shared_ptr<ThisType> create_shared_memory(const std::string& name, ssize_t size,
+                                                                        ssize_t dim)
+    {
+        auto file = MappedFile::create_shared_memory(name, 0);
+        try
+        {
+            return std::shared_ptr<ThisType>(new ThisType(std::move(file), size, dim, false));
+        }
+        catch (...)
+        {
+            // the shared memory object outlives the mapping, so we have to remove it if creation failed
+            try
+            {
+                MappedFile::unlink_shared_memory(name);
+            }
+            catch (...)  // NOLINT(bugprone-empty-catch)
+            {
+                // an error while removing the object must not hide the original error
+            }
+            throw;
+        }
+    }
+
+    /// Attach to a shared memory object created by create_shared_memory (e.g., in another process)
+    [[nodiscard]] static std::shared_ptr<ThisType> open_shared_memory(
+        const std::string& name, MappedFileMode mode = MappedFileMode::read_write)
+    {
+        return std::shared_ptr<ThisType>(new ThisType(MappedFile::open_shared_memory(name, mode), name));
+    }
+
+    /**
+     * \brief Create an array of \c size vectors stored one after the other at \c data_offset in \c file
+     *
+     * This is used to map files in other formats (see open_vector_array). Since the array cannot update
+     * headers of other formats when its size changes, \c file has to be mapped read-only.
+     */
+    [[nodiscard]] static std::shared_ptr<ThisType> map(MappedFile&& file, ssize_t data_offset, ssize_t size,
+                                                       ssize_t dim)
+    {
+        if (file.writable())
+        {
+            throw InvalidArgumentError("MappedNpyVectorArray: file has to be mapped read-only");
+        }
+        auto ret = std::shared_ptr<ThisType>(new ThisType(std::move(file)));
+        ret->check(data_offset >= 0 && size >= 0 && dim >= 0 && data_offset % ssize_t(alignof(F)) == 0,
+                   "invalid data offset or shape.");
+        ret->size_ = size;
+        ret->dim_ = dim;
+        ret->data_offset_ = data_offset;
+        ret->check(ret->file_.size() >= data_offset + ret->num_bytes(size), "file is truncated.");
+        return ret;
+    }
+
+    ~MappedNpyVectorArray() override
+    {
+        try
+        {
+            release_reserved_space();
+        }
+        catch (...)  // NOLINT(bugprone-empty-catch)
+        {
+            // the file stays valid (with some trailing zeros), and destructors must not throw
+        }
+    }
+
+    MappedNpyVectorArray(const MappedNpyVectorArray& other) = delete;
+    MappedNpyVectorArray(MappedNpyVectorArray&& other) = delete;
+    MappedNpyVectorArray& operator=(const MappedNpyVectorArray& other) = delete;
+    MappedNpyVectorArray& operator=(MappedNpyVectorArray&& other) = delete;
+
+    [[nodiscard]] ssize_t size() const override
+    {
+        return size_;
+    }
+
+    [[nodiscard]] ssize_t dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] bool is_compatible_array(const InterfaceType& other) const override
+    {
+        return dim() == other.dim();
+    }
+
+    [[nodiscard]] bool fortran_order() const
+    {
+        return fortran_order_;
+    }
+
+    [[nodiscard]] bool writable() const
+    {
+        return file_.writable();
+    }
+
+    /// The path of the underlying file (empty if the array is not backed by a file)
+    [[nodiscard]] std::filesystem::path path() const
+    {
+        return file_.path();
+    }
+
+    /// The name of the underlying shared memory object (empty if the array is not stored in shared memory)
+    [[nodiscard]] std::string shared_memory_name() const
+    {
+        return file_.shared_memory_name();
+    }
+
+    /// Approximate number of bytes processed at once by the bulk operations
+    [[nodiscard]] ssize_t block_size() const
+    {
+        return block_size_;
+    }
+
+    void set_block_size(ssize_t block_size)
+    {
+        check(block_size > 0, "block_size must be positive.");
+        block_size_ = block_size;
+    }
+
+    /**
+     * \brief Pointer to the data
+     *
+     * Entry \c j of vector \c i is stored at position <tt>i * dim() + j</tt> (C order) or
+     * <tt>j * size() + i</tt> (Fortran order). The pointer is invalidated by \c append and \c delete_vectors.
+     */
+    [[nodiscard]] const F* data() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const F*>(file_.data() + data_offset_);
+    }
+
+    /**
+     * \brief Mutable pointer to the data (throws if the file has been opened read-only)
+     *
+     * Counts as a modification of the array (see VectorArrayInterface::version).
+     */
+    [[nodiscard]] F* mutable_data()
+    {
+        this->record_modification();
+        return writable_data();
+    }
+
+    /// Write all changes back to the file (and remove the room reserved for further vectors from it)
+    void flush()
+    {
+        release_reserved_space();
+        file_.flush();
+    }
+
+    [[nodiscard]] F get(ssize_t i, ssize_t j) const override
+    {
+        this->check_indices(i, j);
+        return data()[offset(i, j)];
+    }
+
+    void set(ssize_t i, ssize_t j, F value) override
+    {
+        this->check_indices(i, j);
+        mutable_data()[offset(i, j)] = value;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> copy(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        auto ret = std::make_shared<ThisType>(std::ssize(index_vec), dim_);
+        ret->copy_vectors_from(0, *this, index_vec);
+        return ret;
+    }
+
+    void append(InterfaceType& other, bool remove_from_other = false,
+                const std::optional<Indices>& other_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        check_writable();
+        this->record_append();
+        if (&other == this)
+        {
+            const auto vectors_to_append = copy(other_indices);
+            append(*vectors_to_append);
+        }
+        else
+        {
+            const auto other_index_vec = this->index_vector(other_indices, other.size());
+            const auto old_size = size_;
+            resize_vectors(size_ + std::ssize(other_index_vec));
+            copy_vectors_from(old_size, other, other_index_vec);
+        }
+        if (remove_from_other)
+        {
+            other.delete_vectors(other_indices);
+        }
+    }
+
+    void delete_vectors(const std::optional<Indices>& indices) override
+    {
+        check_writable();
+        this->record_deletion();
+        std::vector<ssize_t> indices_to_keep;
+        if (indices)
+        {
+            const auto indices_vec = this->index_vector(indices, size_);
+            const std::set<ssize_t> indices_to_delete(indices_vec.begin(), indices_vec.end());
+            for (ssize_t i = 0; i < size_; ++i)
+            {
+                if (!indices_to_delete.contains(i))
+                {
+                    indices_to_keep.push_back(i);
+                }
+            }
+        }
+        // Move the remaining entries to their new position. Since indices_to_keep is sorted, the new
+        // position of each entry is never behind its old position, and entries that have not been moved
+        // yet are never overwritten (also in Fortran order, where the distance between the entries of a
+        // vector shrinks, too).
+        const auto new_size = std::ssize(indices_to_keep);
+        F* const data_ptr = writable_data();
+        for (ssize_t j = 0; j < (fortran_order_ ? dim_ : 1); ++j)
+        {
+            for (ssize_t i = 0; i < new_size; ++i)
+            {
+                const auto old_i = indices_to_keep[as_size_t(i)];
+                if (fortran_order_)
+                {
+                    data_ptr[(j * new_size) + i] = data_ptr[(j * size_) + old_i];
+                }
+                else if (old_i != i)
+                {
+                    std::copy_n(data_ptr + (old_i * dim_), dim_, data_ptr + (i * dim_));
+                }
+            }
+        }
+        resize_vectors(new_size);
+    }
+
+    void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
+    {
+        if (fortran_order_)
+        {
+            InterfaceType::scal(alpha, indices);
+            return;
+        }
+        const auto index_vec = this->index_vector(indices, size_);
+        check(alpha.size() == 1 || alpha.size() == index_vec.size(),
+              "alpha must have size 1 or the same size as indices.");
+        F* const data_ptr = mutable_data();
+        stream_blocks({{this, &index_vec}}, std::ssize(index_vec), rows_per_block(), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t i = begin; i < end; ++i)
+                          {
+                              const auto factor = alpha.size() == 1 ? alpha[0] : alpha[as_size_t(i)];
+                              F* const row = data_ptr + (index_vec[as_size_t(i)] * dim_);
+                              for (ssize_t k = 0; k < dim_; ++k)
+                              {
+                                  row[k] *= factor;
+                              }
+                          }
+                      });
+    }
+
+    void axpy(const std::vector<F>& alpha, const InterfaceType& x,
+              const std::optional<Indices>& indices = std::nullopt,
+              const std::optional<Indices>& x_indices = std::nullopt) override
+    {
+        const auto* x_mapped = c_ordered(x);
+        if (x_mapped == nullptr || fortran_order_)
+        {
+            InterfaceType::axpy(alpha, x, indices, x_indices);
+            return;
+        }
+        check(this->is_compatible_array(x), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto x_index_vec = this->index_vector(x_indices, x.size());
+        check(x_index_vec.size() == index_vec.size() || x_index_vec.size() == 1,
+              "x must have length 1 or the same length as this");
+        check(alpha.size() == index_vec.size() || alpha.size() == 1,
+              "alpha must be scalar or have the same length as this");
+        F* const data_ptr = mutable_data();
+        const F* const x_data = x_mapped->data();
+        const auto compute_block = [&](ssize_t begin, ssize_t end)
+        {
+            for (ssize_t i = begin; i < end; ++i)
+            {
+                const auto factor = alpha.size() == 1 ? alpha[0] : alpha[as_size_t(i)];
+                const auto x_index = x_index_vec[x_index_vec.size() == 1 ? 0 : as_size_t(i)];
+                F* const row = data_ptr + (index_vec[as_size_t(i)] * dim_);
+                const F* const x_row = x_data + (x_index * dim_);
+                for (ssize_t k = 0; k < dim_; ++k)
+                {
+                    row[k] += factor * x_row[k];
+                }
+            }
+        };
+        if (x_index_vec.size() == 1)
+        {
+            stream_blocks({{this, &index_vec}}, std::ssize(index_vec), rows_per_block(), true, compute_block);
+        }
+        else
+        {
+            stream_blocks({{this, &index_vec}, {x_mapped, &x_index_vec}}, std::ssize(index_vec),
+                          std::max(ssize_t(1), rows_per_block() / 2), true, compute_block);
+        }
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_mapped = c_ordered(other);
+        if (other_mapped == nullptr || fortran_order_)
+        {
+            return InterfaceType::inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(other_index_vec.size()));
+        // The result is computed tile by tile: for each block of vectors of this array, we stream through
+        // all blocks of other. The blocks of this array are not needed anymore afterwards and are released
+        // (unless other is the same array and the blocks are needed again).
+        const auto rows = std::max(ssize_t(1), rows_per_block() / 2);
+        stream_blocks(
+            {{this, &index_vec}}, std::ssize(index_vec), rows, other_mapped != this,
+            [&](ssize_t begin, ssize_t end)
+            {
+                stream_blocks({{other_mapped, &other_index_vec}}, std::ssize(other_index_vec), rows, false,
+                              [&](ssize_t other_begin, ssize_t other_end)
+                              {
+                                  for (ssize_t i = begin; i < end; ++i)
+                                  {
+                                      const F* const row = vector_data(index_vec[as_size_t(i)]);
+                                      auto& ret_row = ret[as_size_t(i)];
+                                      for (ssize_t j = other_begin; j < other_end; ++j)
+                                      {
+                                          ret_row[as_size_t(j)] = dot(
+                                              row, other_mapped->vector_data(other_index_vec[as_size_t(j)]));
+                                      }
+                                  }
+                              });
+            });
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_mapped = c_ordered(other);
+        if (other_mapped == nullptr || fortran_order_)
+        {
+            return InterfaceType::pairwise_inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        check(index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(index_vec.size());
+        stream_blocks({{this, &index_vec}, {other_mapped, &other_index_vec}}, std::ssize(index_vec),
+                      std::max(ssize_t(1), rows_per_block() / 2), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t i = begin; i < end; ++i)
+                          {
+                              const F* const row = vector_data(index_vec[as_size_t(i)]);
+                              const auto other_index = other_index_vec[as_size_t(i)];
+                              const F* const other_row = other_mapped->vector_data(other_index);
+                              ret[as_size_t(i)] = dot(row, other_row);
+                          }
+                      });
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        if (fortran_order_)
+        {
+            return InterfaceType::norm2(indices);
+        }
+        const auto index_vec = this->index_vector(indices, size_);
+        std::vector<RealType> ret(index_vec.size(), RealType(0));
+        stream_blocks({{this, &index_vec}}, std::ssize(index_vec), rows_per_block(), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t i = begin; i < end; ++i)
+                          {
+                              const F* const row = vector_data(index_vec[as_size_t(i)]);
+                              for (ssize_t k = 0; k < dim_; ++k)
+                              {
+                                  ret[as_size_t(i)] += this->abs2(row[k]);
+                              }
+                          }
+                      });
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        if (fortran_order_)
+        {
+            return InterfaceType::lincomb(coefficients);
+        }
+        this->check_lincomb_coefficients(coefficients);
+        auto ret = std::make_shared<ThisType>(std::ssize(coefficients), dim_);
+        F* const ret_data = ret->mutable_data();
+        // we stream through this array only once and update all linear combinations with each vector
+        const auto index_vec = this->index_vector(std::nullopt, size_);
+        stream_blocks({{this, &index_vec}}, size_, rows_per_block(), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t k = begin; k < end; ++k)
+                          {
+                              const F* const row = vector_data(k);
+                              for (size_t i = 0; i < coefficients.size(); ++i)
+                              {
+                                  const auto coefficient = coefficients[i][as_size_t(k)];
+                                  if (coefficient == F(0))
+                                  {
+                                      continue;
+                                  }
+                                  F* const ret_row = ret_data + (as_ssize_t(i) * dim_);
+                                  for (ssize_t j = 0; j < dim_; ++j)
+                                  {
+                                      ret_row[j] += coefficient * row[j];
+                                  }
+                              }
+                          }
+                      });
+        return ret;
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        if (fortran_order_)
+        {
+            return InterfaceType::amax(indices);
+        }
+        check(dim_ > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = this->index_vector(indices, size_);
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{std::vector<ssize_t>(index_vec.size(), 0),
+                                                                   std::vector<RealType>(index_vec.size())};
+        stream_blocks({{this, &index_vec}}, std::ssize(index_vec), rows_per_block(), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t i = begin; i < end; ++i)
+                          {
+                              const F* const row = vector_data(index_vec[as_size_t(i)]);
+                              auto& max_index = ret.first[as_size_t(i)];
+                              auto& max_value = ret.second[as_size_t(i)];
+                              max_value = std::abs(row[0]);
+                              for (ssize_t k = 1; k < dim_; ++k)
+                              {
+                                  const RealType value = std::abs(row[k]);
+                                  if (value > max_value)
+                                  {
+                                      max_index = k;
+                                      max_value = value;
+                                  }
+                              }
+                          }
+                      });
+        return ret;
+    }
+
+    using InterfaceType::axpy;
+    using InterfaceType::scal;
+
+   private:
+    explicit MappedNpyVectorArray(MappedFile&& file)
+        : file_(std::move(file))
+    {
+    }
+
+    // Reads the .npy header at the beginning of file (name is the file name used in error messages)
+    MappedNpyVectorArray(MappedFile&& file, const std::string& name)
+        : file_(std::move(file))
+    {
+        const auto header = parse_npy_header(std::string_view(file_.data(), as_size_t(file_.size())));
+        check(header.descr == npy_descr<F>(),
+              std::format("data type {} of {} does not match the scalar type (expected {})", header.descr,
+                          name, npy_descr<F>()));
+        check(header.shape.size() == 2, std::format("{} does not contain a two-dimensional array", name));
+        size_ = header.shape[0];
+        dim_ = header.shape[1];
+        fortran_order_ = header.fortran_order;
+        data_offset_ = header.header_size;
+        // the file size (header + size * dim * sizeof(F) bytes) has to be representable
+        const auto max_data_size = std::numeric_limits<ssize_t>::max() - data_offset_;
+        check(dim_ == 0 || size_ <= max_data_size / as_ssize_t(sizeof(F)) / dim_,
+              std::format("shape of {} is too large", name));
+        check(file_.size() >= data_offset_ + num_bytes(size_), std::format("{} is truncated", name));
+    }
+
+    MappedNpyVectorArray(MappedFile&& file, ssize_t size, ssize_t dim, bool fortran_order)
+        : file_(std::move(file))
+        , size_(0)
+        , dim_(dim)
+        , fortran_order_(fortran_order)
+    {
+        check(size >= 0 && dim >= 0, "size and dim must be non-negative.");
+        resize_vectors(size);
+    }
+
+    void check(const bool condition, const std::string& message) const
+    {
+        if (!condition)
+        {
+            throw InvalidArgumentError("MappedNpyVectorArray: " + message);
+        }
+    }
+
+    void check_writable() const
+    {
+        if (!file_.writable())
+        {
+            throw InvalidStateError("MappedNpyVectorArray: array has been opened read-only.");
+        }
+    }
+
+    [[nodiscard]] ssize_t num_bytes(ssize_t num_vectors) const
+    {
+        return num_vectors * dim_ * as_ssize_t(sizeof(F));
+    }
+
+    [[nodiscard]] ssize_t offset(ssize_t i, ssize_t j) const
+    {
+        return fortran_order_ ? (j * size_) + i : (i * dim_) + j;
+    }
+
+    // pointer to the first entry of the i-th vector (only meaningful in C order)
+    [[nodiscard]] const F* vector_data(ssize_t i) const
+    {
+        return data() + (i * dim_);
+    }
+
+    [[nodiscard]] ssize_t rows_per_block() const
+    {
+        return std::max(ssize_t(1), block_size_ / std::max(ssize_t(1), num_bytes(1)));
+    }
+
+    // returns other as MappedNpyVectorArray if it is one and stored in C order (nullptr otherwise)
+    [[nodiscard]] static const ThisType* c_ordered(const InterfaceType& other)
+    {
+        const auto* ret = dynamic_cast<const ThisType*>(&other);
+        return (ret != nullptr && !ret->fortran_order_) ? ret : nullptr;
+    }
+
+    [[nodiscard]] F dot(const F* lhs, const F* rhs) const
+    {
+        F ret(0);
+        for (ssize_t k = 0; k < dim_; ++k)
+        {
+            ret += conj_if_complex(lhs[k]) * rhs[k];
+        }
+        return ret;
+    }
+
+    // Checks whether index_vec contains consecutive (ascending) indices, i.e., the vectors are stored
+    // contiguously (in C order)
+    [[nodiscard]] static bool is_contiguous(const std::vector<ssize_t>& index_vec)
+    {
+        for (size_t i = 1; i < index_vec.size(); ++i)
+        {
+            if (index_vec[i] != index_vec[i - 1] + 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Gives a hint to the operating system on how the vectors index_vec[begin:end] are going to be accessed.
+    // For scattered indices, we do not give any hints.
+    void advise_vectors(const std::vector<ssize_t>& index_vec, bool contiguous, ssize_t begin, ssize_t end,
+                        AccessAdvice advice) const
+    {
+        if (!contiguous || begin >= end || fortran_order_)
+        {
+            return;
+        }
+        file_.advise(data_offset_ + num_bytes(index_vec[as_size_t(begin)]), num_bytes(end - begin), advice);
+    }
+
+    // Calls func(begin, end) for consecutive blocks [begin, end) of [0, num_vectors). The vectors
+    // index_vec[begin:end] of the given arrays are prefetched one block ahead and (if release is true)
+    // released once the block has been processed.
+    template <class Func>
+    static void stream_blocks(
+        std::initializer_list<std::pair<const ThisType*, const std::vector<ssize_t>*>> arrays,
+        ssize_t num_vectors, ssize_t vectors_per_block, bool release, Func&& func)
+    {
+        std::vector<bool> contiguous;
+        for (const auto& [array, index_vec] : arrays)
+        {
+            contiguous.push_back(is_contiguous(*index_vec));
+            array->advise_vectors(*index_vec, contiguous.back(), 0, num_vectors, AccessAdvice::sequential);
+        }
+        for (ssize_t begin = 0; begin < num_vectors; begin += vectors_per_block)
+        {
+            const auto end = std::min(num_vectors, begin + vectors_per_block);
+            size_t a = 0;
+            for (const auto& [array, index_vec] : arrays)
+            {
+                const auto next_end = std::min(num_vectors, end + vectors_per_block);
+                array->advise_vectors(*index_vec, contiguous[a++], end, next_end, AccessAdvice::will_need);
+            }
+            func(begin, end);
+            if (release)
+            {
+                a = 0;
+                for (const auto& [array, index_vec] : arrays)
+                {
+                    array->advise_vectors(*index_vec, contiguous[a++], begin, end, AccessAdvice::dont_need);
+                }
+            }
+        }
+    }
+
+    // Copies the vectors other_index_vec of other to the vectors starting at first_index
+    void copy_vectors_from(ssize_t first_index, const InterfaceType& other,
+                           const std::vector<ssize_t>& other_index_vec)
+    {
+        const auto* other_mapped = c_ordered(other);
+        if (other_mapped == nullptr || fortran_order_)
+        {
+            for (ssize_t i = 0; i < std::ssize(other_index_vec); ++i)
+            {
+                for (ssize_t j = 0; j < dim_; ++j)
+                {
+                    writable_data()[offset(first_index + i, j)] = other.get(other_index_vec[as_size_t(i)], j);
+                }
+            }
+            return;
+        }
+        F* const data_ptr = writable_data();
+        stream_blocks({{other_mapped, &other_index_vec}}, std::ssize(other_index_vec), rows_per_block(), true,
+                      [&](ssize_t begin, ssize_t end)
+                      {
+                          for (ssize_t i = begin; i < end; ++i)
+                          {
+                              std::copy_n(other_mapped->vector_data(other_index_vec[as_size_t(i)]), dim_,
+                                          data_ptr + ((first_index + i) * dim_));
+                          }
+                      });
+    }
+
+    // mutable pointer to the data which (unlike mutable_data) does not record a modification
+    [[nodiscard]] F* writable_data()
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<F*>(file_.mutable_data() + data_offset_);
+    }
+
+    // Changes the number of vectors to new_size (new vectors are zero-initialized) and updates the header.
+    // When shrinking the array in Fortran order, the entries have to be moved to their new positions before.
+    void resize_vectors(ssize_t new_size)
+    {
+        const auto header =
+            format_npy_header({npy_descr<F>(), fortran_order_, {new_size, dim_}, data_offset_});
+        const auto new_offset = std::ssize(header);
+        const auto old_size = size_;
+        const auto required_size =
+            std::max(new_offset, data_offset_) + num_bytes(std::max(new_size, old_size));
+        if (required_size > file_.size())
+        {
+            // Reserve room for further vectors in mapped files (in-memory buffers already grow
+            // geometrically). In Fortran order, all data has to be moved anyway, so there is nothing to gain.
+            const bool reserve = !fortran_order_ && old_size > 0 &&
+                                 (file_.file_backed() || !file_.shared_memory_name().empty());
+            file_.resize(reserve ? std::max(required_size, new_offset + num_bytes(2 * old_size))
+                                 : required_size);
+            has_reserved_space_ = has_reserved_space_ || reserve;
+        }
+        char* const file_data = file_.mutable_data();
+        if (new_offset != data_offset_)
+        {
+            // the header has grown, so the data has to be moved
+            std::memmove(file_data + new_offset, file_data + data_offset_, as_size_t(num_bytes(old_size)));
+        }
+        std::memcpy(file_data, header.data(), header.size());
+        data_offset_ = new_offset;
+        if (fortran_order_ && new_size > old_size)
+        {
+            // The distance between the entries of each vector grows, so we move the entries of the j-th
+            // component of all vectors to their new position, starting with the last component.
+            F* const data_ptr = writable_data();
+            for (ssize_t j = dim_ - 1; j >= 0; --j)
+            {
+                std::memmove(data_ptr + (j * new_size), data_ptr + (j * old_size),
+                             as_size_t(old_size) * sizeof(F));
+                std::fill(data_ptr + (j * new_size) + old_size, data_ptr + ((j + 1) * new_size), F(0));
+            }
+        }
+        if (new_size < old_size || !has_reserved_space_)
+        {
+            // does nothing if the size did not change
+            file_.resize(data_offset_ + num_bytes(new_size));
+            has_reserved_space_ = false;
+        }
+        size_ = new_size;
+    }
+
+    // Truncates the file to the used size if resize_vectors reserved room for further vectors
+    void release_reserved_space()
+    {
+        if (has_reserved_space_ && file_.file_backed())
+        {
+            file_.resize(data_offset_ + num_bytes(size_));
+            has_reserved_space_ = false;
+        }
+    }
+
+    MappedFile file_;
+    ssize_t size_ = 0;
+    ssize_t dim_ = 0;
+    bool fortran_order_ = false;
+    ssize_t data_offset_ = 0;
+    ssize_t block_size_ = default_block_size;
+    bool has_reserved_space_ = false;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_VECTORARRAY_MAPPED_NPY_H
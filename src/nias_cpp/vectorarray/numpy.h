@@ -1,7 +1,6 @@
 #ifndef NIAS_CPP_VECTORARRAY_NUMPY_H
 #define NIAS_CPP_VECTORARRAY_NUMPY_H
 
-#include <concepts>
 #include <memory>
 #include <optional>
 #include <set>
@@ -10,6 +9,7 @@
 #include <vector>
 
 #include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
 #include <nias_cpp/exceptions.h>
 #include <nias_cpp/indices.h>
 #include <nias_cpp/interfaces/vector.h>
@@ -21,7 +21,15 @@ namespace nias
 {
 
 
-template <std::floating_point F>
+/**
+ * \brief VectorArray operating on a two-dimensional numpy array (one vector per row)
+ *
+ * The array is stored by reference, i.e., constructing a NumpyVectorArray from a numpy array
+ * does not copy the data and modifications through \c set, \c scal or \c axpy are visible in the
+ * original numpy array. Operations that change the number of vectors (\c append and
+ * \c delete_vectors) allocate a new array.
+ */
+template <floating_point_or_complex F>
 class NumpyVectorArray : public VectorArrayInterface<F>
 {
     using ThisType = NumpyVectorArray;
@@ -29,7 +37,6 @@ class NumpyVectorArray : public VectorArrayInterface<F>
     using InterfaceType = VectorArrayInterface<F>;
 
    public:
-    // TODO: We should be able to pass a numpy array from Python without copy
     explicit NumpyVectorArray(const pybind11::array_t<F>& array)
         : array_(array)
     {
@@ -70,8 +77,10 @@ class NumpyVectorArray : public VectorArrayInterface<F>
         return true;
     }
 
+    /// Counts as a modification of the array (see VectorArrayInterface::version)
     auto& array()
     {
+        this->record_modification();
         return array_;
     }
 
@@ -104,6 +113,7 @@ class NumpyVectorArray : public VectorArrayInterface<F>
     void set(ssize_t i, ssize_t j, F value) override
     {
         this->check_indices(i, j);
+        this->record_modification();
         array_.mutable_at(i, j) = value;
     }
 
@@ -140,6 +150,7 @@ class NumpyVectorArray : public VectorArrayInterface<F>
             other_indices->check_valid(other.size());
         }
         const ssize_t other_size = other_indices ? other_indices->size(other.size()) : other.size();
+        this->record_append();
         pybind11::array_t<F> new_array({size() + other_size, dim()});
         // copy old data
         for (ssize_t i = 0; i < size(); ++i)
@@ -162,7 +173,9 @@ class NumpyVectorArray : public VectorArrayInterface<F>
         array_ = new_array;
         if (remove_from_other)
         {
-            auto& old_array_other = dynamic_cast<ThisType&>(other).array_;
+            auto& other_numpy = dynamic_cast<ThisType&>(other);
+            other_numpy.record_deletion();
+            auto& old_array_other = other_numpy.array_;
             if (!other_indices)
             {
                 old_array_other = pybind11::array_t<F>(std::vector<ssize_t>{0, dim()});
@@ -197,6 +210,7 @@ class NumpyVectorArray : public VectorArrayInterface<F>
 
     void delete_vectors(const std::optional<Indices>& indices) override
     {
+        this->record_deletion();
         std::vector<ssize_t> indices_to_keep;
         ssize_t new_size = 0;
         if (indices)
@@ -0,0 +1,509 @@
+#ifndef NIAS_CPP_VECTORARRAY_PLANAR_COMPLEX_H
+#define NIAS_CPP_VECTORARRAY_PLANAR_COMPLEX_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief VectorArray of complex vectors storing the real and the imaginary parts in separate planes
+ *
+ * The real parts of all vectors are stored one vector after the other in one contiguous buffer, the
+ * imaginary parts in a second one. Compared to interleaved storage (<tt>std::complex<R></tt>), the kernels
+ * for inner products, Gram matrices, \c axpy and \c lincomb then only consist of real multiplications and
+ * additions on contiguous data, which the compiler can vectorize. Reductions (inner products and norms) use
+ * \c simd_width independent partial sums, so they are vectorized without reordering floating point
+ * operations behind the compiler's back.
+ *
+ * Interleaved data (e.g., numpy arrays or a MappedNpyVectorArray) is only converted when an array is
+ * created from it or written back to it (see the constructors, \c append and \c to_interleaved).
+ */
+template <std::floating_point R>
+class PlanarComplexVectorArray : public VectorArrayInterface<std::complex<R>>
+{
+    using F = std::complex<R>;
+    using ThisType = PlanarComplexVectorArray;
+    using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
+
+   public:
+    /// Number of independent partial sums in reductions
+    static constexpr ssize_t simd_width = 8;
+    /// Number of entries per vector processed at once when computing Gram matrices (to keep them in cache)
+    static constexpr ssize_t block_length = 1024;
+
+    /// Create an array of \c size zero vectors of dimension \c dim
+    explicit PlanarComplexVectorArray(ssize_t size, ssize_t dim)
+        : size_(size)
+        , dim_(dim)
+    {
+        check(size >= 0 && dim >= 0, "size and dim must be non-negative.");
+        real_.resize(as_size_t(size * dim));
+        imag_.resize(as_size_t(size * dim));
+    }
+
+    /// Create an array from \c size interleaved vectors of dimension \c dim stored one after the other
+    PlanarComplexVectorArray(const F* data, ssize_t size, ssize_t dim)
+        : PlanarComplexVectorArray(size, dim)
+    {
+        deinterleave(data, size * dim, real_.data(), imag_.data());
+    }
+
+    /// Create an array containing the vectors of \c other
+    explicit PlanarComplexVectorArray(const InterfaceType& other)
+        : PlanarComplexVectorArray(0, other.dim())
+    {
+        append_vectors(other, this->index_vector(std::nullopt, other.size()));
+    }
+
+    [[nodiscard]] ssize_t size() const override
+    {
+        return size_;
+    }
+
+    [[nodiscard]] ssize_t dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] bool is_compatible_array(const InterfaceType& other) const override
+    {
+        return dim() == other.dim();
+    }
+
+    /// Real parts (the real part of entry \c j of vector \c i is stored at position <tt>i * dim() + j</tt>)
+    [[nodiscard]] const R* real_data() const
+    {
+        return real_.data();
+    }
+
+    /// Imaginary parts (stored like the real parts)
+    [[nodiscard]] const R* imag_data() const
+    {
+        return imag_.data();
+    }
+
+    /// Counts as a modification of the array (see VectorArrayInterface::version)
+    [[nodiscard]] R* mutable_real_data()
+    {
+        this->record_modification();
+        return real_.data();
+    }
+
+    /// Counts as a modification of the array (see VectorArrayInterface::version)
+    [[nodiscard]] R* mutable_imag_data()
+    {
+        this->record_modification();
+        return imag_.data();
+    }
+
+    /// Writes the vectors to \c out (<tt>size() * dim()</tt> interleaved entries, one vector after the other)
+    void to_interleaved(F* out) const
+    {
+        const auto count = size_ * dim_;
+        const R* const re = real_.data();
+        const R* const im = imag_.data();
+        for (ssize_t k = 0; k < count; ++k)
+        {
+            out[k] = F(re[k], im[k]);
+        }
+    }
+
+    [[nodiscard]] F get(ssize_t i, ssize_t j) const override
+    {
+        this->check_indices(i, j);
+        const auto offset = as_size_t((i * dim_) + j);
+        return F(real_[offset], imag_[offset]);
+    }
+
+    void set(ssize_t i, ssize_t j, F value) override
+    {
+        this->check_indices(i, j);
+        this->record_modification();
+        const auto offset = as_size_t((i * dim_) + j);
+        real_[offset] = value.real();
+        imag_[offset] = value.imag();
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> copy(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        auto ret = std::make_shared<ThisType>(0, dim_);
+        ret->append_vectors(*this, this->index_vector(indices, size_));
+        return ret;
+    }
+
+    void append(InterfaceType& other, bool remove_from_other = false,
+                const std::optional<Indices>& other_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        this->record_append();
+        if (&other == this)
+        {
+            const auto vectors_to_append = copy(other_indices);
+            append(*vectors_to_append);
+        }
+        else
+        {
+            append_vectors(other, this->index_vector(other_indices, other.size()));
+        }
+        if (remove_from_other)
+        {
+            other.delete_vectors(other_indices);
+        }
+    }
+
+    void delete_vectors(const std::optional<Indices>& indices) override
+    {
+        this->record_deletion();
+        if (!indices)
+        {
+            real_.clear();
+            imag_.clear();
+            size_ = 0;
+            return;
+        }
+        const auto indices_vec = this->index_vector(indices, size_);
+        const std::set<ssize_t> indices_to_delete(indices_vec.begin(), indices_vec.end());
+        ssize_t new_size = 0;
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            if (!indices_to_delete.contains(i))
+            {
+                if (new_size != i)
+                {
+                    std::copy_n(real_.data() + (i * dim_), dim_, real_.data() + (new_size * dim_));
+                    std::copy_n(imag_.data() + (i * dim_), dim_, imag_.data() + (new_size * dim_));
+                }
+                ++new_size;
+            }
+        }
+        size_ = new_size;
+        real_.resize(as_size_t(size_ * dim_));
+        imag_.resize(as_size_t(size_ * dim_));
+    }
+
+    void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        check(alpha.size() == 1 || alpha.size() == index_vec.size(),
+              "alpha must have size 1 or the same size as indices.");
+        this->record_modification();
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto factor = alpha.size() == 1 ? alpha[0] : alpha[i];
+            const R factor_re = factor.real();
+            const R factor_im = factor.imag();
+            R* const re = real_.data() + (index_vec[i] * dim_);
+            R* const im = imag_.data() + (index_vec[i] * dim_);
+            for (ssize_t k = 0; k < dim_; ++k)
+            {
+                const R old_re = re[k];
+                re[k] = (factor_re * old_re) - (factor_im * im[k]);
+                im[k] = (factor_re * im[k]) + (factor_im * old_re);
+            }
+        }
+    }
+
+    void axpy(const std::vector<F>& alpha, const InterfaceType& x,
+              const std::optional<Indices>& indices = std::nullopt,
+              const std::optional<Indices>& x_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(x), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto x_index_vec = this->index_vector(x_indices, x.size());
+        check(x_index_vec.size() == index_vec.size() || x_index_vec.size() == 1,
+              "x must have length 1 or the same length as this");
+        check(alpha.size() == index_vec.size() || alpha.size() == 1,
+              "alpha must be scalar or have the same length as this");
+        this->record_modification();
+        // if x is this array, the vectors of x might be modified before they are used
+        if (&x == this && !index_vec.empty())
+        {
+            axpy(alpha, *copy(x_indices), indices, std::nullopt);
+            return;
+        }
+        const auto* x_planar = dynamic_cast<const ThisType*>(&x);
+        if (x_planar == nullptr)
+        {
+            // convert the vectors of x once instead of for each use
+            axpy(alpha, ThisType(*x.copy(x_indices)), indices, std::nullopt);
+            return;
+        }
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto x_index = x_index_vec[x_index_vec.size() == 1 ? 0 : i];
+            add_scaled(alpha.size() == 1 ? alpha[0] : alpha[i], x_planar->real_.data() + (x_index * dim_),
+                       x_planar->imag_.data() + (x_index * dim_), real_.data() + (index_vec[i] * dim_),
+                       imag_.data() + (index_vec[i] * dim_));
+        }
+    }
+
+    /**
+     * \brief Gram matrix of (a subset of) the vectors with (a subset of) the vectors of \c other
+     *
+     * For two PlanarComplexVectorArrays, the vectors are processed in blocks of \c block_length entries, so
+     * the blocks of all vectors involved stay in cache while they are multiplied with each other.
+     */
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_planar = dynamic_cast<const ThisType*>(&other);
+        if (other_planar == nullptr)
+        {
+            return InterfaceType::inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(other_index_vec.size()));
+        for (ssize_t begin = 0; begin < dim_; begin += block_length)
+        {
+            const auto end = std::min(dim_, begin + block_length);
+            for (size_t i = 0; i < index_vec.size(); ++i)
+            {
+                for (size_t j = 0; j < other_index_vec.size(); ++j)
+                {
+                    ret[i][j] += dot(*other_planar, index_vec[i], other_index_vec[j], begin, end);
+                }
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_planar = dynamic_cast<const ThisType*>(&other);
+        if (other_planar == nullptr)
+        {
+            return InterfaceType::pairwise_inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        check(index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret[i] = dot(*other_planar, index_vec[i], other_index_vec[i], 0, dim_);
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        std::vector<RealType> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const R* const re = real_.data() + (index_vec[i] * dim_);
+            const R* const im = imag_.data() + (index_vec[i] * dim_);
+            std::array<R, simd_width> sums{};
+            ssize_t k = 0;
+            for (; k + simd_width <= dim_; k += simd_width)
+            {
+                for (ssize_t l = 0; l < simd_width; ++l)
+                {
+                    sums[as_size_t(l)] += (re[k + l] * re[k + l]) + (im[k + l] * im[k + l]);
+                }
+            }
+            for (; k < dim_; ++k)
+            {
+                sums[0] += (re[k] * re[k]) + (im[k] * im[k]);
+            }
+            ret[i] = sum(sums);
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        this->check_lincomb_coefficients(coefficients);
+        auto ret = std::make_shared<ThisType>(std::ssize(coefficients), dim_);
+        for (size_t i = 0; i < coefficients.size(); ++i)
+        {
+            for (ssize_t k = 0; k < size_; ++k)
+            {
+                const auto coefficient = coefficients[i][as_size_t(k)];
+                if (coefficient != F(0))
+                {
+                    add_scaled(coefficient, real_.data() + (k * dim_), imag_.data() + (k * dim_),
+                               ret->real_.data() + (as_ssize_t(i) * dim_),
+                               ret->imag_.data() + (as_ssize_t(i) * dim_));
+                }
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(dim_ > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = this->index_vector(indices, size_);
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{std::vector<ssize_t>(index_vec.size(), 0),
+                                                                   std::vector<RealType>(index_vec.size())};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const R* const re = real_.data() + (index_vec[i] * dim_);
+            const R* const im = imag_.data() + (index_vec[i] * dim_);
+            auto& max_index = ret.first[i];
+            auto& max_value = ret.second[i];
+            max_value = std::hypot(re[0], im[0]);
+            for (ssize_t k = 1; k < dim_; ++k)
+            {
+                const RealType value = std::hypot(re[k], im[k]);
+                if (value > max_value)
+                {
+                    max_index = k;
+                    max_value = value;
+                }
+            }
+        }
+        return ret;
+    }
+
+    using InterfaceType::axpy;
+    using InterfaceType::scal;
+
+   private:
+    void check(const bool condition, const std::string& message) const
+    {
+        if (!condition)
+        {
+            throw InvalidArgumentError("PlanarComplexVectorArray: " + message);
+        }
+    }
+
+    static void deinterleave(const F* in, ssize_t count, R* re, R* im)
+    {
+        for (ssize_t k = 0; k < count; ++k)
+        {
+            re[k] = in[k].real();
+            im[k] = in[k].imag();
+        }
+    }
+
+    static R sum(const std::array<R, simd_width>& values)
+    {
+        R ret(0);
+        for (const R value : values)
+        {
+            ret += value;
+        }
+        return ret;
+    }
+
+    // y += alpha * x for the vectors with real parts x_re, y_re and imaginary parts x_im, y_im
+    void add_scaled(F alpha, const R* x_re, const R* x_im, R* y_re, R* y_im) const
+    {
+        const R alpha_re = alpha.real();
+        const R alpha_im = alpha.imag();
+        for (ssize_t k = 0; k < dim_; ++k)
+        {
+            y_re[k] += (alpha_re * x_re[k]) - (alpha_im * x_im[k]);
+            y_im[k] += (alpha_re * x_im[k]) + (alpha_im * x_re[k]);
+        }
+    }
+
+    // Inner product of the entries [begin, end) of vector i (conjugated) with vector j of other
+    [[nodiscard]] F dot(const ThisType& other, ssize_t i, ssize_t j, ssize_t begin, ssize_t end) const
+    {
+        const R* const a_re = real_.data() + (i * dim_);
+        const R* const a_im = imag_.data() + (i * dim_);
+        const R* const b_re = other.real_.data() + (j * dim_);
+        const R* const b_im = other.imag_.data() + (j * dim_);
+        std::array<R, simd_width> sums_re{};
+        std::array<R, simd_width> sums_im{};
+        ssize_t k = begin;
+        for (; k + simd_width <= end; k += simd_width)
+        {
+            for (ssize_t l = 0; l < simd_width; ++l)
+            {
+                sums_re[as_size_t(l)] += (a_re[k + l] * b_re[k + l]) + (a_im[k + l] * b_im[k + l]);
+                sums_im[as_size_t(l)] += (a_re[k + l] * b_im[k + l]) - (a_im[k + l] * b_re[k + l]);
+            }
+        }
+        for (; k < end; ++k)
+        {
+            sums_re[0] += (a_re[k] * b_re[k]) + (a_im[k] * b_im[k]);
+            sums_im[0] += (a_re[k] * b_im[k]) - (a_im[k] * b_re[k]);
+        }
+        return F(sum(sums_re), sum(sums_im));
+    }
+
+    // Appends the vectors other_index_vec of other
+    void append_vectors(const InterfaceType& other, const std::vector<ssize_t>& other_index_vec)
+    {
+        const auto old_size = size_;
+        size_ += std::ssize(other_index_vec);
+        real_.resize(as_size_t(size_ * dim_));
+        imag_.resize(as_size_t(size_ * dim_));
+        const auto* other_planar = dynamic_cast<const ThisType*>(&other);
+        const auto* other_mapped = dynamic_cast<const MappedNpyVectorArray<F>*>(&other);
+        if (other_mapped != nullptr && other_mapped->fortran_order())
+        {
+            other_mapped = nullptr;
+        }
+        for (ssize_t i = 0; i < std::ssize(other_index_vec); ++i)
+        {
+            const auto other_index = other_index_vec[as_size_t(i)];
+            R* const re = real_.data() + ((old_size + i) * dim_);
+            R* const im = imag_.data() + ((old_size + i) * dim_);
+            if (other_planar != nullptr)
+            {
+                std::copy_n(other_planar->real_.data() + (other_index * dim_), dim_, re);
+                std::copy_n(other_planar->imag_.data() + (other_index * dim_), dim_, im);
+            }
+            else if (other_mapped != nullptr)
+            {
+                deinterleave(other_mapped->data() + (other_index * dim_), dim_, re, im);
+            }
+            else
+            {
+                for (ssize_t j = 0; j < dim_; ++j)
+                {
+                    const F value = other.get(other_index, j);
+                    re[j] = value.real();
+                    im[j] = value.imag();
+                }
+            }
+        }
+    }
+
+    ssize_t size_;
+    ssize_t dim_;
+    std::vector<R> real_;
+    std::vector<R> imag_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_VECTORARRAY_PLANAR_COMPLEX_H
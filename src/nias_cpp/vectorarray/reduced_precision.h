@@ -0,0 +1,446 @@
+#ifndef NIAS_CPP_VECTORARRAY_REDUCED_PRECISION_H
+#define NIAS_CPP_VECTORARRAY_REDUCED_PRECISION_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/reduced_precision.h>
+#include <nias_cpp/type_traits.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief VectorArray storing its entries in a lower precision than it computes in
+ *
+ * The vectors are stored one after the other in a contiguous buffer of scalars of type \c S (e.g.,
+ * float16 or bfloat16), while the interface and all computations use \c F. Since most operations on
+ * large vector arrays are limited by memory bandwidth, storing the entries in half precision halves (or,
+ * for \c F = double, quarters) the memory traffic.
+ *
+ * The bulk operations convert blocks of \c block_length entries to \c F and compute on these blocks. Inner
+ * products and norms sum the results of the blocks in double precision (at least), so the accumulation
+ * error does not grow with the dimension as in naive summation. The result of \c axpy, \c scal and
+ * \c lincomb is rounded to \c S when it is stored, i.e., only these operations (and \c set) introduce
+ * rounding errors of the storage precision.
+ */
+template <std::floating_point F, storage_scalar S>
+class ReducedPrecisionVectorArray : public VectorArrayInterface<F>
+{
+    using ThisType = ReducedPrecisionVectorArray;
+    using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
+    // type used for summing up the results of the blocks
+    using AccumulationType = std::conditional_t<(sizeof(F) < sizeof(double)), double, F>;
+
+   public:
+    using StorageType = S;
+    static constexpr ssize_t block_length = 256;
+
+    /// Create an array of \c size zero vectors of dimension \c dim
+    explicit ReducedPrecisionVectorArray(ssize_t size, ssize_t dim)
+        : size_(size)
+        , dim_(dim)
+    {
+        check(size >= 0 && dim >= 0, "size and dim must be non-negative.");
+        data_.resize(as_size_t(size * dim), narrow<S>(F(0)));
+    }
+
+    /// Create an array containing the vectors of \c other, rounded to the storage precision
+    explicit ReducedPrecisionVectorArray(const InterfaceType& other)
+        : ReducedPrecisionVectorArray(0, other.dim())
+    {
+        append_vectors(other, this->index_vector(std::nullopt, other.size()));
+    }
+
+    [[nodiscard]] ssize_t size() const override
+    {
+        return size_;
+    }
+
+    [[nodiscard]] ssize_t dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] bool is_compatible_array(const InterfaceType& other) const override
+    {
+        return dim() == other.dim();
+    }
+
+    /// Pointer to the data (entry \c j of vector \c i is stored at position <tt>i * dim() + j</tt>)
+    [[nodiscard]] const S* data() const
+    {
+        return data_.data();
+    }
+
+    /// Counts as a modification of the array (see VectorArrayInterface::version)
+    [[nodiscard]] S* mutable_data()
+    {
+        this->record_modification();
+        return data_.data();
+    }
+
+    [[nodiscard]] F get(ssize_t i, ssize_t j) const override
+    {
+        this->check_indices(i, j);
+        return widen<F>(data_[as_size_t((i * dim_) + j)]);
+    }
+
+    void set(ssize_t i, ssize_t j, F value) override
+    {
+        this->check_indices(i, j);
+        this->record_modification();
+        data_[as_size_t((i * dim_) + j)] = narrow<S>(value);
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> copy(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        auto ret = std::make_shared<ThisType>(0, dim_);
+        ret->append_vectors(*this, this->index_vector(indices, size_));
+        return ret;
+    }
+
+    void append(InterfaceType& other, bool remove_from_other = false,
+                const std::optional<Indices>& other_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        this->record_append();
+        if (&other == this)
+        {
+            const auto vectors_to_append = copy(other_indices);
+            append(*vectors_to_append);
+        }
+        else
+        {
+            append_vectors(other, this->index_vector(other_indices, other.size()));
+        }
+        if (remove_from_other)
+        {
+            other.delete_vectors(other_indices);
+        }
+    }
+
+    void delete_vectors(const std::optional<Indices>& indices) override
+    {
+        this->record_deletion();
+        if (!indices)
+        {
+            data_.clear();
+            size_ = 0;
+            return;
+        }
+        const auto indices_vec = this->index_vector(indices, size_);
+        const std::set<ssize_t> indices_to_delete(indices_vec.begin(), indices_vec.end());
+        ssize_t new_size = 0;
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            if (!indices_to_delete.contains(i))
+            {
+                if (new_size != i)
+                {
+                    std::copy_n(vector_data(i), dim_, mutable_vector_data(new_size));
+                }
+                ++new_size;
+            }
+        }
+        size_ = new_size;
+        data_.resize(as_size_t(size_ * dim_));
+    }
+
+    void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        check(alpha.size() == 1 || alpha.size() == index_vec.size(),
+              "alpha must have size 1 or the same size as indices.");
+        this->record_modification();
+        std::array<F, block_length> block{};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto factor = alpha.size() == 1 ? alpha[0] : alpha[i];
+            S* const row = mutable_vector_data(index_vec[i]);
+            for_each_block(
+                [&](ssize_t begin, ssize_t count)
+                {
+                    widen(row + begin, count, block.data());
+                    for (ssize_t k = 0; k < count; ++k)
+                    {
+                        block[as_size_t(k)] *= factor;
+                    }
+                    narrow(block.data(), count, row + begin);
+                });
+        }
+    }
+
+    void axpy(const std::vector<F>& alpha, const InterfaceType& x,
+              const std::optional<Indices>& indices = std::nullopt,
+              const std::optional<Indices>& x_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(x), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto x_index_vec = this->index_vector(x_indices, x.size());
+        check(x_index_vec.size() == index_vec.size() || x_index_vec.size() == 1,
+              "x must have length 1 or the same length as this");
+        check(alpha.size() == index_vec.size() || alpha.size() == 1,
+              "alpha must be scalar or have the same length as this");
+        this->record_modification();
+        // if x is this array, the vectors of x might be modified before they are used
+        if (&x == this && !index_vec.empty())
+        {
+            axpy(alpha, *copy(x_indices), indices, std::nullopt);
+            return;
+        }
+        const auto* x_reduced = dynamic_cast<const ThisType*>(&x);
+        std::array<F, block_length> block{};
+        std::array<F, block_length> x_block{};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto factor = alpha.size() == 1 ? alpha[0] : alpha[i];
+            const auto x_index = x_index_vec[x_index_vec.size() == 1 ? 0 : i];
+            S* const row = mutable_vector_data(index_vec[i]);
+            for_each_block(
+                [&](ssize_t begin, ssize_t count)
+                {
+                    widen(row + begin, count, block.data());
+                    if (x_reduced != nullptr)
+                    {
+                        widen(x_reduced->vector_data(x_index) + begin, count, x_block.data());
+                    }
+                    else
+                    {
+                        for (ssize_t k = 0; k < count; ++k)
+                        {
+                            x_block[as_size_t(k)] = x.get(x_index, begin + k);
+                        }
+                    }
+                    for (ssize_t k = 0; k < count; ++k)
+                    {
+                        block[as_size_t(k)] += factor * x_block[as_size_t(k)];
+                    }
+                    narrow(block.data(), count, row + begin);
+                });
+        }
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_reduced = dynamic_cast<const ThisType*>(&other);
+        if (other_reduced == nullptr)
+        {
+            return InterfaceType::inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(other_index_vec.size()));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (size_t j = 0; j < other_index_vec.size(); ++j)
+            {
+                ret[i][j] = dot(vector_data(index_vec[i]), other_reduced->vector_data(other_index_vec[j]));
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        const auto* other_reduced = dynamic_cast<const ThisType*>(&other);
+        if (other_reduced == nullptr)
+        {
+            return InterfaceType::pairwise_inner(other, indices, other_indices);
+        }
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        check(index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret[i] = dot(vector_data(index_vec[i]), other_reduced->vector_data(other_index_vec[i]));
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        std::vector<RealType> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret[i] = dot(vector_data(index_vec[i]), vector_data(index_vec[i]));
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        this->check_lincomb_coefficients(coefficients);
+        auto ret = std::make_shared<ThisType>(std::ssize(coefficients), dim_);
+        // the linear combinations are accumulated in full precision and rounded once at the end
+        std::vector<F> result(as_size_t(dim_));
+        std::array<F, block_length> block{};
+        for (size_t i = 0; i < coefficients.size(); ++i)
+        {
+            std::ranges::fill(result, F(0));
+            for (ssize_t k = 0; k < size_; ++k)
+            {
+                const auto coefficient = coefficients[i][as_size_t(k)];
+                if (coefficient == F(0))
+                {
+                    continue;
+                }
+                for_each_block(
+                    [&](ssize_t begin, ssize_t count)
+                    {
+                        widen(vector_data(k) + begin, count, block.data());
+                        for (ssize_t j = 0; j < count; ++j)
+                        {
+                            result[as_size_t(begin + j)] += coefficient * block[as_size_t(j)];
+                        }
+                    });
+            }
+            narrow(result.data(), dim_, ret->mutable_vector_data(as_ssize_t(i)));
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(dim_ > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = this->index_vector(indices, size_);
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{std::vector<ssize_t>(index_vec.size(), 0),
+                                                                   std::vector<RealType>(index_vec.size())};
+        std::array<F, block_length> block{};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            auto& max_index = ret.first[i];
+            auto& max_value = ret.second[i];
+            max_value = std::abs(get(index_vec[i], 0));
+            for_each_block(
+                [&](ssize_t begin, ssize_t count)
+                {
+                    widen(vector_data(index_vec[i]) + begin, count, block.data());
+                    for (ssize_t k = 0; k < count; ++k)
+                    {
+                        const RealType value = std::abs(block[as_size_t(k)]);
+                        if (value > max_value)
+                        {
+                            max_index = begin + k;
+                            max_value = value;
+                        }
+                    }
+                });
+        }
+        return ret;
+    }
+
+    using InterfaceType::axpy;
+    using InterfaceType::scal;
+
+   private:
+    void check(const bool condition, const std::string& message) const
+    {
+        if (!condition)
+        {
+            throw InvalidArgumentError("ReducedPrecisionVectorArray: " + message);
+        }
+    }
+
+    [[nodiscard]] const S* vector_data(ssize_t i) const
+    {
+        return data_.data() + (i * dim_);
+    }
+
+    [[nodiscard]] S* mutable_vector_data(ssize_t i)
+    {
+        return data_.data() + (i * dim_);
+    }
+
+    // Calls func(begin, count) for consecutive blocks of at most block_length entries covering a vector
+    template <class Func>
+    void for_each_block(Func&& func) const
+    {
+        for (ssize_t begin = 0; begin < dim_; begin += block_length)
+        {
+            func(begin, std::min(block_length, dim_ - begin));
+        }
+    }
+
+    [[nodiscard]] F dot(const S* lhs, const S* rhs) const
+    {
+        std::array<F, block_length> lhs_block{};
+        std::array<F, block_length> rhs_block{};
+        AccumulationType ret(0);
+        for_each_block(
+            [&](ssize_t begin, ssize_t count)
+            {
+                widen(lhs + begin, count, lhs_block.data());
+                widen(rhs + begin, count, rhs_block.data());
+                F block_result(0);
+                for (ssize_t k = 0; k < count; ++k)
+                {
+                    block_result += lhs_block[as_size_t(k)] * rhs_block[as_size_t(k)];
+                }
+                ret += block_result;
+            });
+        return static_cast<F>(ret);
+    }
+
+    // Appends the vectors other_index_vec of other (rounded to the storage precision)
+    void append_vectors(const InterfaceType& other, const std::vector<ssize_t>& other_index_vec)
+    {
+        const auto old_size = size_;
+        size_ += std::ssize(other_index_vec);
+        data_.resize(as_size_t(size_ * dim_));
+        const auto* other_reduced = dynamic_cast<const ThisType*>(&other);
+        std::vector<F> row(as_size_t(dim_));
+        for (ssize_t i = 0; i < std::ssize(other_index_vec); ++i)
+        {
+            const auto other_index = other_index_vec[as_size_t(i)];
+            if (other_reduced != nullptr)
+            {
+                std::copy_n(other_reduced->vector_data(other_index), dim_, mutable_vector_data(old_size + i));
+                continue;
+            }
+            for (ssize_t j = 0; j < dim_; ++j)
+            {
+                row[as_size_t(j)] = other.get(other_index, j);
+            }
+            narrow(row.data(), dim_, mutable_vector_data(old_size + i));
+        }
+    }
+
+    std::vector<S> data_;
+    ssize_t size_;
+    ssize_t dim_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_VECTORARRAY_REDUCED_PRECISION_H
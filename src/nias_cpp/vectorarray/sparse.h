@@ -0,0 +1,660 @@
+#ifndef NIAS_CPP_VECTORARRAY_SPARSE_H
+#define NIAS_CPP_VECTORARRAY_SPARSE_H
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+namespace nias
+{
+
+
+/**
+ * \brief VectorArray storing only the nonzero entries of its vectors (compressed sparse rows)
+ *
+ * Each vector is one row of a CSR matrix: the column indices of the nonzero entries of vector \c i are
+ * <tt>column_indices()[row_offsets()[i]:row_offsets()[i + 1]]</tt> (in increasing order) and the
+ * corresponding values are stored at the same positions in <tt>values()</tt>. Exact zeros are never stored,
+ * entries that become zero (e.g., by \c set, \c scal or cancellation in \c axpy) are removed.
+ *
+ * Memory and the cost of all bulk operations scale with the number of nonzeros, not with the dimension:
+ * inner products of two sparse arrays merge the sorted column indices, inner products with dense arrays
+ * only read the entries of the dense vectors at the nonzero positions, and \c add_to adds a sparse vector
+ * to a dense one entry by entry. Arrays of other types are converted (keeping only their nonzero entries)
+ * before they are used in \c axpy or \c append, which costs <tt>O(dim)</tt> per vector.
+ *
+ * \note \c set is cheap for existing entries but inserting a new nonzero entry moves all entries behind it.
+ * To assemble a sparse array, use the CSR constructor instead.
+ */
+template <floating_point_or_complex F>
+class SparseVectorArray : public VectorArrayInterface<F>
+{
+    using ThisType = SparseVectorArray;
+    using InterfaceType = VectorArrayInterface<F>;
+    using RealType = typename InterfaceType::RealType;
+
+   public:
+    /// Create an array of \c size zero vectors of dimension \c dim
+    explicit SparseVectorArray(ssize_t size, ssize_t dim)
+        : size_(size)
+        , dim_(dim)
+    {
+        check(size >= 0 && dim >= 0, "size and dim must be non-negative.");
+        row_offsets_.resize(as_size_t(size + 1), 0);
+    }
+
+    /**
+     * \brief Create an array from CSR data (e.g., the \c indptr, \c indices and \c data of a scipy
+     * csr_matrix)
+     *
+     * The array contains <tt>row_offsets.size() - 1</tt> vectors. The column indices of each row have to
+     * be strictly increasing and smaller than \c dim. Stored zeros are removed.
+     */
+    SparseVectorArray(ssize_t dim, std::vector<ssize_t> row_offsets, std::vector<ssize_t> column_indices,
+                      std::vector<F> values)
+        : size_(std::ssize(row_offsets) - 1)
+        , dim_(dim)
+        , row_offsets_(std::move(row_offsets))
+        , column_indices_(std::move(column_indices))
+        , values_(std::move(values))
+    {
+        check(dim >= 0, "dim must be non-negative.");
+        check(!row_offsets_.empty() && row_offsets_.front() == 0 &&
+                  row_offsets_.back() == std::ssize(column_indices_) &&
+                  column_indices_.size() == values_.size(),
+              "row_offsets, column_indices and values do not describe a CSR matrix.");
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            const auto begin = row_offsets_[as_size_t(i)];
+            const auto end = row_offsets_[as_size_t(i + 1)];
+            check(begin <= end, std::format("row_offsets must be non-decreasing (row {}).", i));
+            for (ssize_t k = begin; k < end; ++k)
+            {
+                const auto column = column_indices_[as_size_t(k)];
+                const bool increasing = k == begin || column > column_indices_[as_size_t(k - 1)];
+                check(column >= 0 && column < dim && increasing,
+                      std::format("column indices of row {} must be increasing and smaller than dim.", i));
+            }
+        }
+        remove_zeros();
+    }
+
+    /// Create an array containing the nonzero entries of the vectors of \c other
+    explicit SparseVectorArray(const InterfaceType& other)
+        : SparseVectorArray(0, other.dim())
+    {
+        append_vectors(other, this->index_vector(std::nullopt, other.size()));
+    }
+
+    [[nodiscard]] ssize_t size() const override
+    {
+        return size_;
+    }
+
+    [[nodiscard]] ssize_t dim() const override
+    {
+        return dim_;
+    }
+
+    [[nodiscard]] bool is_compatible_array(const InterfaceType& other) const override
+    {
+        return dim() == other.dim();
+    }
+
+    /// Number of nonzero entries of all vectors
+    [[nodiscard]] ssize_t nnz() const
+    {
+        return std::ssize(values_);
+    }
+
+    /// Number of nonzero entries of vector \c i
+    [[nodiscard]] ssize_t nnz(ssize_t i) const
+    {
+        this->check_first_index(i);
+        return row_end(i) - row_begin(i);
+    }
+
+    [[nodiscard]] const std::vector<ssize_t>& row_offsets() const
+    {
+        return row_offsets_;
+    }
+
+    [[nodiscard]] const std::vector<ssize_t>& column_indices() const
+    {
+        return column_indices_;
+    }
+
+    [[nodiscard]] const std::vector<F>& values() const
+    {
+        return values_;
+    }
+
+    [[nodiscard]] F get(ssize_t i, ssize_t j) const override
+    {
+        this->check_indices(i, j);
+        const auto position = find(i, j);
+        return position < row_end(i) && column_indices_[as_size_t(position)] == j
+                   ? values_[as_size_t(position)]
+                   : F(0);
+    }
+
+    void set(ssize_t i, ssize_t j, F value) override
+    {
+        this->check_indices(i, j);
+        this->record_modification();
+        const auto position = find(i, j);
+        const bool exists = position < row_end(i) && column_indices_[as_size_t(position)] == j;
+        if (exists && value != F(0))
+        {
+            values_[as_size_t(position)] = value;
+        }
+        else if (exists)
+        {
+            column_indices_.erase(column_indices_.begin() + position);
+            values_.erase(values_.begin() + position);
+            shift_row_offsets(i, -1);
+        }
+        else if (value != F(0))
+        {
+            column_indices_.insert(column_indices_.begin() + position, j);
+            values_.insert(values_.begin() + position, value);
+            shift_row_offsets(i, 1);
+        }
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> copy(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        auto ret = std::make_shared<ThisType>(0, dim_);
+        ret->append_vectors(*this, this->index_vector(indices, size_));
+        return ret;
+    }
+
+    void append(InterfaceType& other, bool remove_from_other = false,
+                const std::optional<Indices>& other_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        this->record_append();
+        if (&other == this)
+        {
+            const auto vectors_to_append = copy(other_indices);
+            append(*vectors_to_append);
+        }
+        else
+        {
+            append_vectors(other, this->index_vector(other_indices, other.size()));
+        }
+        if (remove_from_other)
+        {
+            other.delete_vectors(other_indices);
+        }
+    }
+
+    void delete_vectors(const std::optional<Indices>& indices) override
+    {
+        this->record_deletion();
+        if (!indices)
+        {
+            row_offsets_.assign(1, 0);
+            column_indices_.clear();
+            values_.clear();
+            size_ = 0;
+            return;
+        }
+        const auto indices_vec = this->index_vector(indices, size_);
+        const std::set<ssize_t> indices_to_delete(indices_vec.begin(), indices_vec.end());
+        ssize_t new_size = 0;
+        ssize_t new_nnz = 0;
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            const auto begin = row_begin(i);
+            const auto end = row_end(i);
+            if (!indices_to_delete.contains(i))
+            {
+                // entries are only moved to the front, so entries that have not been moved yet are kept
+                std::copy(column_indices_.begin() + begin, column_indices_.begin() + end,
+                          column_indices_.begin() + new_nnz);
+                std::copy(values_.begin() + begin, values_.begin() + end, values_.begin() + new_nnz);
+                new_nnz += end - begin;
+                ++new_size;
+                row_offsets_[as_size_t(new_size)] = new_nnz;
+            }
+        }
+        size_ = new_size;
+        row_offsets_.resize(as_size_t(size_ + 1));
+        column_indices_.resize(as_size_t(new_nnz));
+        values_.resize(as_size_t(new_nnz));
+    }
+
+    void scal(const std::vector<F>& alpha, const std::optional<Indices>& indices = std::nullopt) override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        check(alpha.size() == 1 || alpha.size() == index_vec.size(),
+              "alpha must have size 1 or the same size as indices.");
+        this->record_modification();
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            const auto factor = alpha.size() == 1 ? alpha[0] : alpha[i];
+            for (ssize_t k = row_begin(index_vec[i]); k < row_end(index_vec[i]); ++k)
+            {
+                values_[as_size_t(k)] *= factor;
+            }
+        }
+        remove_zeros();
+    }
+
+    /**
+     * \brief Adds (a subset of) the vectors of \c x, multiplied by \c alpha, to (a subset of) the vectors
+     *
+     * The rows of this array are rebuilt once, merging the sorted nonzero entries. Vectors of \c x that are
+     * not stored in a SparseVectorArray are converted first (see the class documentation).
+     */
+    void axpy(const std::vector<F>& alpha, const InterfaceType& x,
+              const std::optional<Indices>& indices = std::nullopt,
+              const std::optional<Indices>& x_indices = std::nullopt) override
+    {
+        check(this->is_compatible_array(x), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto x_index_vec = this->index_vector(x_indices, x.size());
+        check(x_index_vec.size() == index_vec.size() || x_index_vec.size() == 1,
+              "x must have length 1 or the same length as this");
+        check(alpha.size() == index_vec.size() || alpha.size() == 1,
+              "alpha must be scalar or have the same length as this");
+        this->record_modification();
+        const auto* x_sparse = dynamic_cast<const ThisType*>(&x);
+        // if x is this array, the vectors of x are modified while they are used
+        if (!index_vec.empty() && (&x == this || x_sparse == nullptr))
+        {
+            axpy(alpha, ThisType(*x.copy(x_indices)), indices, std::nullopt);
+            return;
+        }
+        // updates[i] lists the (factor, vector of x) pairs added to vector i
+        std::vector<std::vector<std::pair<F, ssize_t>>> updates(as_size_t(size_));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            updates[as_size_t(index_vec[i])].emplace_back(alpha.size() == 1 ? alpha[0] : alpha[i],
+                                                          x_index_vec[x_index_vec.size() == 1 ? 0 : i]);
+        }
+        std::vector<ssize_t> new_row_offsets(1, 0);
+        std::vector<ssize_t> new_column_indices;
+        std::vector<F> new_values;
+        new_row_offsets.reserve(as_size_t(size_ + 1));
+        std::vector<std::pair<ssize_t, F>> row;
+        std::vector<std::pair<ssize_t, F>> merged;
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            row.clear();
+            for (ssize_t k = row_begin(i); k < row_end(i); ++k)
+            {
+                row.emplace_back(column_indices_[as_size_t(k)], values_[as_size_t(k)]);
+            }
+            for (const auto& [factor, x_index] : updates[as_size_t(i)])
+            {
+                merge_scaled(row, factor, *x_sparse, x_index, merged);
+                std::swap(row, merged);
+            }
+            for (const auto& [column, value] : row)
+            {
+                if (value != F(0))
+                {
+                    new_column_indices.push_back(column);
+                    new_values.push_back(value);
+                }
+            }
+            new_row_offsets.push_back(std::ssize(new_values));
+        }
+        row_offsets_ = std::move(new_row_offsets);
+        column_indices_ = std::move(new_column_indices);
+        values_ = std::move(new_values);
+    }
+
+    /**
+     * \brief Adds (a subset of) the vectors, multiplied by \c alpha, to (a subset of) the vectors of \c y
+     *
+     * Computes <tt>y[y_indices] += alpha * this[indices]</tt> like <tt>y.axpy(alpha, *this, y_indices,
+     * indices)</tt>, but only touches the entries of \c y at the nonzero positions (using \c get and \c set),
+     * so \c y may be any (dense) vector array.
+     */
+    void add_to(InterfaceType& y, const std::vector<F>& alpha,
+                const std::optional<Indices>& y_indices = std::nullopt,
+                const std::optional<Indices>& indices = std::nullopt) const
+    {
+        check(this->is_compatible_array(y), "incompatible dimensions.");
+        const auto y_index_vec = this->index_vector(y_indices, y.size());
+        const auto index_vec = this->index_vector(indices, size_);
+        check(index_vec.size() == y_index_vec.size() || index_vec.size() == 1,
+              "add_to: this must have length 1 or the same length as y");
+        check(alpha.size() == y_index_vec.size() || alpha.size() == 1,
+              "add_to: alpha must be scalar or have the same length as y");
+        if (&y == this && !y_index_vec.empty())
+        {
+            y.axpy(alpha, *copy(indices), y_indices, std::nullopt);
+            return;
+        }
+        for (size_t i = 0; i < y_index_vec.size(); ++i)
+        {
+            const auto factor = alpha.size() == 1 ? alpha[0] : alpha[i];
+            const auto index = index_vec[index_vec.size() == 1 ? 0 : i];
+            for (ssize_t k = row_begin(index); k < row_end(index); ++k)
+            {
+                const auto column = column_indices_[as_size_t(k)];
+                const auto y_value = y.get(y_index_vec[i], column);
+                y.set(y_index_vec[i], column, y_value + (factor * values_[as_size_t(k)]));
+            }
+        }
+    }
+
+    void add_to(InterfaceType& y, F alpha, const std::optional<Indices>& y_indices = std::nullopt,
+                const std::optional<Indices>& indices = std::nullopt) const
+    {
+        add_to(y, std::vector<F>{alpha}, y_indices, indices);
+    }
+
+    /**
+     * \brief Inner products with (a subset of) the vectors of \c other
+     *
+     * For two SparseVectorArrays, the sorted column indices of both vectors are merged. For all other arrays,
+     * only the entries of the vectors of \c other at the nonzero positions are read. EuclideanInnerProduct
+     * also uses these kernels if only the right-hand side is sparse (see prefers_computing_inner_products).
+     */
+    [[nodiscard]] bool prefers_computing_inner_products() const override
+    {
+        return true;
+    }
+
+    [[nodiscard]] std::vector<std::vector<F>> inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        std::vector<std::vector<F>> ret(index_vec.size(), std::vector<F>(other_index_vec.size()));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (size_t j = 0; j < other_index_vec.size(); ++j)
+            {
+                ret[i][j] = dot(index_vec[i], other, other_index_vec[j]);
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<F> pairwise_inner(
+        const InterfaceType& other, const std::optional<Indices>& indices = std::nullopt,
+        const std::optional<Indices>& other_indices = std::nullopt) const override
+    {
+        check(this->is_compatible_array(other), "incompatible dimensions.");
+        const auto index_vec = this->index_vector(indices, size_);
+        const auto other_index_vec = this->index_vector(other_indices, other.size());
+        check(index_vec.size() == other_index_vec.size(),
+              "pairwise_inner: both arrays must have the same number of vectors.");
+        std::vector<F> ret(index_vec.size());
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            ret[i] = dot(index_vec[i], other, other_index_vec[i]);
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::vector<RealType> norm2(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        const auto index_vec = this->index_vector(indices, size_);
+        std::vector<RealType> ret(index_vec.size(), RealType(0));
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (ssize_t k = row_begin(index_vec[i]); k < row_end(index_vec[i]); ++k)
+            {
+                ret[i] += this->abs2(values_[as_size_t(k)]);
+            }
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::shared_ptr<InterfaceType> lincomb(
+        const std::vector<std::vector<F>>& coefficients) const override
+    {
+        this->check_lincomb_coefficients(coefficients);
+        auto ret = std::make_shared<ThisType>(0, dim_);
+        std::vector<std::pair<ssize_t, F>> entries;
+        for (const auto& row_coefficients : coefficients)
+        {
+            // collect the scaled entries of all vectors and sum up the entries in the same column
+            entries.clear();
+            for (ssize_t k = 0; k < size_; ++k)
+            {
+                const auto coefficient = row_coefficients[as_size_t(k)];
+                if (coefficient == F(0))
+                {
+                    continue;
+                }
+                for (ssize_t l = row_begin(k); l < row_end(k); ++l)
+                {
+                    entries.emplace_back(column_indices_[as_size_t(l)], coefficient * values_[as_size_t(l)]);
+                }
+            }
+            std::ranges::stable_sort(entries, {}, &std::pair<ssize_t, F>::first);
+            for (size_t l = 0; l < entries.size();)
+            {
+                const auto column = entries[l].first;
+                F value(0);
+                for (; l < entries.size() && entries[l].first == column; ++l)
+                {
+                    value += entries[l].second;
+                }
+                if (value != F(0))
+                {
+                    ret->column_indices_.push_back(column);
+                    ret->values_.push_back(value);
+                }
+            }
+            ret->row_offsets_.push_back(ret->nnz());
+            ++ret->size_;
+        }
+        return ret;
+    }
+
+    [[nodiscard]] std::pair<std::vector<ssize_t>, std::vector<RealType>> amax(
+        const std::optional<Indices>& indices = std::nullopt) const override
+    {
+        check(dim_ > 0, "amax is not defined for vectors of dimension 0.");
+        const auto index_vec = this->index_vector(indices, size_);
+        // since only nonzero entries are stored, a vector without entries is zero (maximum at position 0)
+        std::pair<std::vector<ssize_t>, std::vector<RealType>> ret{
+            std::vector<ssize_t>(index_vec.size(), 0), std::vector<RealType>(index_vec.size(), 0)};
+        for (size_t i = 0; i < index_vec.size(); ++i)
+        {
+            for (ssize_t k = row_begin(index_vec[i]); k < row_end(index_vec[i]); ++k)
+            {
+                const RealType value = std::abs(values_[as_size_t(k)]);
+                if (value > ret.second[i])
+                {
+                    ret.first[i] = column_indices_[as_size_t(k)];
+                    ret.second[i] = value;
+                }
+            }
+        }
+        return ret;
+    }
+
+    using InterfaceType::axpy;
+    using InterfaceType::scal;
+
+   private:
+    void check(const bool condition, const std::string& message) const
+    {
+        if (!condition)
+        {
+            throw InvalidArgumentError("SparseVectorArray: " + message);
+        }
+    }
+
+    [[nodiscard]] ssize_t row_begin(ssize_t i) const
+    {
+        return row_offsets_[as_size_t(i)];
+    }
+
+    [[nodiscard]] ssize_t row_end(ssize_t i) const
+    {
+        return row_offsets_[as_size_t(i + 1)];
+    }
+
+    // Position of the first entry of row i with column index >= j
+    [[nodiscard]] ssize_t find(ssize_t i, ssize_t j) const
+    {
+        const auto begin = column_indices_.begin() + row_begin(i);
+        const auto end = column_indices_.begin() + row_end(i);
+        return std::distance(column_indices_.begin(), std::lower_bound(begin, end, j));
+    }
+
+    // Adds offset to the end offsets of the rows i, i + 1, ...
+    void shift_row_offsets(ssize_t i, ssize_t offset)
+    {
+        for (ssize_t k = i + 1; k <= size_; ++k)
+        {
+            row_offsets_[as_size_t(k)] += offset;
+        }
+    }
+
+    // Removes all stored zeros
+    void remove_zeros()
+    {
+        ssize_t new_nnz = 0;
+        for (ssize_t i = 0; i < size_; ++i)
+        {
+            const auto begin = row_begin(i);
+            const auto end = row_end(i);
+            for (ssize_t k = begin; k < end; ++k)
+            {
+                if (values_[as_size_t(k)] != F(0))
+                {
+                    column_indices_[as_size_t(new_nnz)] = column_indices_[as_size_t(k)];
+                    values_[as_size_t(new_nnz)] = values_[as_size_t(k)];
+                    ++new_nnz;
+                }
+            }
+            row_offsets_[as_size_t(i + 1)] = new_nnz;
+        }
+        column_indices_.resize(as_size_t(new_nnz));
+        values_.resize(as_size_t(new_nnz));
+    }
+
+    // Stores the entries of row + factor * (vector x_index of x) in merged (both are sorted by column)
+    static void merge_scaled(const std::vector<std::pair<ssize_t, F>>& row, F factor, const ThisType& x,
+                             ssize_t x_index, std::vector<std::pair<ssize_t, F>>& merged)
+    {
+        merged.clear();
+        auto it = row.begin();
+        for (ssize_t k = x.row_begin(x_index); k < x.row_end(x_index); ++k)
+        {
+            const auto column = x.column_indices_[as_size_t(k)];
+            for (; it != row.end() && it->first < column; ++it)
+            {
+                merged.push_back(*it);
+            }
+            const auto x_value = factor * x.values_[as_size_t(k)];
+            if (it != row.end() && it->first == column)
+            {
+                merged.emplace_back(column, it->second + x_value);
+                ++it;
+            }
+            else
+            {
+                merged.emplace_back(column, x_value);
+            }
+        }
+        merged.insert(merged.end(), it, row.end());
+    }
+
+    // Inner product of vector i (conjugated) with vector j of other
+    [[nodiscard]] F dot(ssize_t i, const InterfaceType& other, ssize_t j) const
+    {
+        F ret(0);
+        if (const auto* other_sparse = dynamic_cast<const ThisType*>(&other); other_sparse != nullptr)
+        {
+            ssize_t l = other_sparse->row_begin(j);
+            const auto other_end = other_sparse->row_end(j);
+            for (ssize_t k = row_begin(i); k < row_end(i) && l < other_end;)
+            {
+                const auto column = column_indices_[as_size_t(k)];
+                const auto other_column = other_sparse->column_indices_[as_size_t(l)];
+                if (column == other_column)
+                {
+                    ret += conj_if_complex(values_[as_size_t(k)]) * other_sparse->values_[as_size_t(l)];
+                }
+                k += column <= other_column ? 1 : 0;
+                l += other_column <= column ? 1 : 0;
+            }
+            return ret;
+        }
+        const auto* other_mapped = dynamic_cast<const MappedNpyVectorArray<F>*>(&other);
+        const bool c_order = other_mapped != nullptr && !other_mapped->fortran_order();
+        const F* const other_row = c_order ? other_mapped->data() + (j * dim_) : nullptr;
+        for (ssize_t k = row_begin(i); k < row_end(i); ++k)
+        {
+            const auto column = column_indices_[as_size_t(k)];
+            const F other_value = other_row != nullptr ? other_row[column] : other.get(j, column);
+            ret += conj_if_complex(values_[as_size_t(k)]) * other_value;
+        }
+        return ret;
+    }
+
+    // Appends the vectors other_index_vec of other (only their nonzero entries)
+    void append_vectors(const InterfaceType& other, const std::vector<ssize_t>& other_index_vec)
+    {
+        const auto* other_sparse = dynamic_cast<const ThisType*>(&other);
+        for (const auto other_index : other_index_vec)
+        {
+            if (other_sparse != nullptr)
+            {
+                const auto begin = other_sparse->row_begin(other_index);
+                const auto end = other_sparse->row_end(other_index);
+                column_indices_.insert(column_indices_.end(), other_sparse->column_indices_.begin() + begin,
+                                       other_sparse->column_indices_.begin() + end);
+                values_.insert(values_.end(), other_sparse->values_.begin() + begin,
+                               other_sparse->values_.begin() + end);
+            }
+            else
+            {
+                for (ssize_t j = 0; j < dim_; ++j)
+                {
+                    const F value = other.get(other_index, j);
+                    if (value != F(0))
+                    {
+                        column_indices_.push_back(j);
+                        values_.push_back(value);
+                    }
+                }
+            }
+            row_offsets_.push_back(nnz());
+            ++size_;
+        }
+    }
+
+    ssize_t size_;
+    ssize_t dim_;
+    std::vector<ssize_t> row_offsets_;
+    std::vector<ssize_t> column_indices_;
+    std::vector<F> values_;
+};
+
+
+}  // namespace nias
+
+#endif  // NIAS_CPP_VECTORARRAY_SPARSE_H
@@ -0,0 +1,59 @@
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <bindings/bindings.h>
+#include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/inner_products/function_based.h>
+#include <nias_cpp/interfaces/vector.h>
+#include <nias_cpp/interpreter.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+#include <pybind11/numpy.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../vectorarray/common.h"
+
+int main()
+{
+    ensure_interpreter_and_venv_are_active();
+
+    "py_apply_inner_product (pairwise)"_test = []<std::floating_point F>()
+    {
+        const ssize_t dim = 10;
+        std::atomic<ssize_t> num_calls = 0;
+        const auto inner_product = VectorFunctionBasedInnerProduct<F>(
+            [&num_calls](const VectorInterface<F>& lhs, const VectorInterface<F>& rhs)
+            {
+                ++num_calls;
+                return dot_product(lhs, rhs);
+            });
+
+        // The pairwise application has to scale linearly in the number of vectors, i.e., it must not
+        // compute (and then throw away) the full Gram matrix.
+        for (const ssize_t size : {10, 100, 1000, 10000})
+        {
+            const auto vec_array = TestVectorArrayFactory<ListVectorArray<F>>::iota(size, dim);
+            num_calls = 0;
+            const auto result = py_apply_inner_product<F>(inner_product, *vec_array, *vec_array, true);
+            expect(num_calls == size)
+                << "pairwise application has to evaluate exactly one inner product per vector";
+            expect(result.ndim() == 1) << "result has to be one-dimensional";
+            expect(result.shape(0) == size);
+            for (ssize_t i = 0; i < size; ++i)
+            {
+                expect(exactly_equal(result.at(i), dot_product(vec_array->vector(i), vec_array->vector(i))));
+            }
+        }
+
+        // non-pairwise application still returns the full Gram matrix
+        const auto vec_array = TestVectorArrayFactory<ListVectorArray<F>>::iota(4, dim);
+        const auto gram_matrix = py_apply_inner_product<F>(inner_product, *vec_array, *vec_array, false);
+        expect(gram_matrix.ndim() == 2);
+        expect(gram_matrix.shape(0) == 4 && gram_matrix.shape(1) == 4);
+    } | std::tuple<float, double>{};
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <complex>
+#include <format>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/interpreter.h>
+#include <nias_cpp/io/mapped_file.h>
+#include <nias_cpp/io/npy.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/numpy.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../vectorarray/common.h"
+
+int main()
+{
+    namespace py = pybind11;
+    using namespace pybind11::literals;  // for the _a literal
+    ensure_interpreter_and_venv_are_active();
+    static_cast<void>(py::module_::import("nias_cpp_bindings"));
+    const auto pickle = py::module_::import("pickle");
+
+    "Pickling vector arrays"_test = [&]<floating_point_or_complex F>()
+    {
+        const auto reference = create_test_array<F>(7, 5);
+        // pickles obj with protocol 5 and returns the unpickled object and the number of out-of-band buffers
+        const auto round_trip = [&](const py::object& obj)
+        {
+            py::list buffers;
+            const auto data =
+                pickle.attr("dumps")(obj, "protocol"_a = 5, "buffer_callback"_a = buffers.attr("append"));
+            return std::make_pair(pickle.attr("loads")(data, "buffers"_a = buffers), buffers.size());
+        };
+
+        // the data of numpy-based and in-memory arrays is transferred out-of-band with protocol 5
+        const auto numpy_array = std::make_shared<NumpyVectorArray<F>>(7, 5);
+        fill_test_array(*numpy_array);
+        const auto [numpy_loaded, numpy_buffers] = round_trip(py::cast(numpy_array));
+        expect(numpy_buffers == 1);
+        const auto numpy_unpickled = numpy_loaded.template cast<std::shared_ptr<NumpyVectorArray<F>>>();
+        expect(exactly_equal(*numpy_unpickled, *reference));
+        const auto [mapped_loaded, mapped_buffers] = round_trip(py::cast(reference));
+        expect(mapped_buffers == 1);
+        const auto mapped_unpickled = mapped_loaded.template cast<std::shared_ptr<NumpyVectorArray<F>>>();
+        expect(exactly_equal(*mapped_unpickled, *reference));
+        // older protocols copy the data into the pickle stream
+        const auto in_band =
+            pickle.attr("loads")(pickle.attr("dumps")(py::cast(reference), "protocol"_a = 2));
+        expect(exactly_equal(*in_band.template cast<std::shared_ptr<NumpyVectorArray<F>>>(), *reference));
+
+        // arrays in shared memory are pickled by name, the unpickled array attaches to the same memory
+        const auto name = std::format("/nias_cpp_test_bindings_pickle_{}", npy_descr<F>().substr(1));
+        const auto shared = MappedNpyVectorArray<F>::create_shared_memory(name, 7, 5);
+        fill_test_array(*shared);
+        const auto [shared_obj, shared_buffers] = round_trip(py::cast(shared));
+        expect(shared_buffers == 0);
+        const auto attached = shared_obj.template cast<std::shared_ptr<MappedNpyVectorArray<F>>>();
+        expect(attached->shared_memory_name() == name);
+        expect(exactly_equal(*attached, *reference));
+        attached->set(0, 0, F(42));
+        expect(shared->get(0, 0) == F(42));
+        MappedFile::unlink_shared_memory(name);
+    } | std::tuple<float, double, std::complex<double>>{};
+
+    "to_numpy copies MappedNpyVectorArrays"_test = [&]<floating_point_or_complex F>()
+    {
+        const auto reference = create_test_array<F>(3, 4);
+        const auto array = create_test_array<F>(3, 4);
+        const auto numpy_data = py::cast(array).attr("to_numpy")().template cast<py::array_t<F>>();
+        // appending remaps the data, the numpy array has to stay valid
+        array->append(*reference);
+        array->scal(F(2));
+        expect(exactly_equal(NumpyVectorArray<F>(numpy_data), *reference));
+    } | std::tuple<float, std::complex<double>>{};
+
+    return 0;
+}
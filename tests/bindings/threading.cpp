@@ -0,0 +1,139 @@
+#include <memory>
+#include <vector>
+
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/inner_products/operator_based.h>
+#include <nias_cpp/interpreter.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/operators/identity.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/numpy.h>
+#include <pybind11/eval.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../operators/common.h"
+#include "../vectorarray/common.h"
+
+int main()
+{
+    namespace py = pybind11;
+    using namespace pybind11::literals;  // for the _a literal
+    ensure_interpreter_and_venv_are_active();
+    const auto bindings = py::module_::import("nias_cpp_bindings");
+    py::exec(R"(
+import nias_cpp_bindings
+
+class PythonOperator(nias_cpp_bindings.DoubleOperatorInterface):
+    def source_dim(self):
+        return 30
+
+    def range_dim(self):
+        return 30
+)");
+    const auto python_operator = py::module_::import("__main__").attr("PythonOperator")();
+
+    // NumpyVectorArrays are copied before the GIL is released, Python implementations are rejected
+    "Eigensolvers"_test = [&]()
+    {
+        const auto op = py::cast(std::make_shared<CsrMatrixOperator<double>>(
+            tridiagonal_operator<double>(std::vector<double>(50, 2.), -1., -1.)));
+        const auto inner_product = py::cast(std::make_shared<EuclideanInnerProduct<double>>());
+        const auto initial_vectors = std::make_shared<NumpyVectorArray<double>>(0, 50);
+        initial_vectors->append(*create_random_test_array<double>(3, 50));
+        for (const auto* name : {"lobpcg", "lanczos"})
+        {
+            const auto solve = [&](ssize_t num_threads)
+            {
+                const auto result = bindings.attr(name)(op, initial_vectors, inner_product,
+                                                        "num_eigenvalues"_a = 2,
+                                                        "num_threads"_a = num_threads);
+                expect(result["converged"].cast<bool>());
+                return std::vector<std::vector<double>>{result["eigenvalues"].cast<std::vector<double>>()};
+            };
+            expect(approx_equal(solve(2), solve(1), 1e-8));
+            expect(throws<py::error_already_set>(
+                [&]()
+                {
+                    return bindings.attr(name)(python_operator, initial_vectors, inner_product,
+                                               "num_threads"_a = 2);
+                }));
+        }
+    };
+
+    "DEIM"_test = [&]()
+    {
+        const auto basis = std::make_shared<NumpyVectorArray<double>>(0, 40);
+        basis->append(*create_random_test_array<double>(6, 40));
+        for (const auto* name : {"deim", "qdeim"})
+        {
+            const auto dofs = [&](ssize_t num_threads)
+            {
+                const auto result = bindings.attr(name)(basis, "num_threads"_a = num_threads);
+                return result["interpolation_dofs"].cast<Indices>().as_vec(40);
+            };
+            expect(dofs(2) == dofs(1));
+        }
+    };
+
+    "Galerkin projection"_test = [&]()
+    {
+        const auto identity = py::cast(std::make_shared<IdentityOperator<double>>(30));
+        const auto basis = std::make_shared<NumpyVectorArray<double>>(0, 30);
+        basis->append(*create_test_array<double>(5, 30));
+        const auto left_basis = std::make_shared<NumpyVectorArray<double>>(0, 30);
+        left_basis->append(*create_test_array<double>(3, 30, 7));
+        const auto expected = left_basis->inner(*basis);
+        const auto projector_type = bindings.attr("DoubleGalerkinProjector");
+        const auto projector = projector_type(py::make_tuple(identity), basis, "num_threads"_a = 2,
+                                              "block_size"_a = 2);
+        const auto matrices =
+            projector.attr("project")(left_basis).cast<std::vector<py::array_t<double>>>();
+        expect(matrices.size() == 1 && matrices[0].shape(0) == 3 && matrices[0].shape(1) == 5);
+        for (ssize_t i = 0; i < 3; ++i)
+        {
+            for (ssize_t j = 0; j < 5; ++j)
+            {
+                expect(matrices[0].at(i, j) == expected[as_size_t(i)][as_size_t(j)]);
+            }
+        }
+        const auto projected = bindings.attr("project_vectors")(left_basis, py::make_tuple(basis),
+                                                                "num_threads"_a = 2);
+        expect(projected.cast<std::vector<py::array_t<double>>>()[0].at(2, 4) == expected[2][4]);
+        expect(throws<py::error_already_set>(
+            [&]()
+            {
+                return projector_type(py::make_tuple(python_operator), basis, "num_threads"_a = 2);
+            }));
+    };
+
+    "Gram cache"_test = [&]()
+    {
+        const auto inner_product = py::cast(std::make_shared<OperatorBasedInnerProduct<double>>(
+            std::make_shared<IdentityOperator<double>>(30)));
+        const auto vec_array = std::make_shared<MappedNpyVectorArray<double>>(0, 30);
+        vec_array->append(*create_test_array<double>(4, 30));
+        const auto cache_type = bindings.attr("DoubleGramCache");
+        const auto cache = cache_type(vec_array, inner_product, "num_threads"_a = 2);
+        const auto matrix = cache.attr("gram_matrix")().cast<py::array_t<double>>();
+        const auto expected = vec_array->inner(*vec_array);
+        expect(matrix.shape(0) == 4 && matrix.at(1, 3) == expected[1][3]);
+        // the cache cannot copy the array it tracks
+        const auto numpy_array = std::make_shared<NumpyVectorArray<double>>(0, 30);
+        numpy_array->append(*vec_array);
+        expect(throws<py::error_already_set>(
+            [&]()
+            {
+                return cache_type(numpy_array, inner_product, "num_threads"_a = 2);
+            }));
+        const auto python_inner_product = bindings.attr("DoubleOperatorBasedInnerProduct")(python_operator);
+        expect(throws<py::error_already_set>(
+            [&]()
+            {
+                return cache_type(vec_array, python_inner_product, "num_threads"_a = 2);
+            }));
+    };
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <complex>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/interpreter.h>
+#include <nias_cpp/io/npy.h>
+#include <nias_cpp/io/vectorarray_file.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/numpy.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../vectorarray/common.h"
+
+int main()
+{
+    namespace py = pybind11;
+    using namespace pybind11::literals;  // for the _a literal
+    ensure_interpreter_and_venv_are_active();
+    const auto bindings = py::module_::import("nias_cpp_bindings");
+
+    "save_vector_array and load_vector_array (Python)"_test = [&]<floating_point_or_complex F>()
+    {
+        const auto file_name =
+            std::format("nias_cpp_test_bindings_vectorarray_file_{}.bin", npy_descr<F>().substr(1));
+        const auto path = (std::filesystem::temp_directory_path() / file_name).string();
+        const auto reference = create_test_array<F>(7, 5);
+        const auto save_and_load = [&](const py::object& array)
+        {
+            bindings.attr("save_vector_array")(array, path, "num_threads"_a = 2);
+            expect(std::filesystem::file_size(path) ==
+                   as_size_t(vector_array_file_header_size + (7 * 5 * ssize_t(sizeof(F)))));
+            const auto loaded = bindings.attr("load_vector_array")(path, "num_threads"_a = 2);
+            return loaded.template cast<std::shared_ptr<NumpyVectorArray<F>>>();
+        };
+
+        // numpy arrays in C order are written directly from memory
+        const auto c_array = std::make_shared<NumpyVectorArray<F>>(7, 5);
+        fill_test_array(*c_array);
+        expect(exactly_equal(*save_and_load(py::cast(c_array)), *reference));
+
+        // all other arrays are written entry by entry
+        const auto fortran_data = py::module_::import("numpy").attr("zeros")(
+            py::make_tuple(7, 5), "dtype"_a = py::dtype::of<F>(), "order"_a = "F");
+        const auto fortran_array =
+            std::make_shared<NumpyVectorArray<F>>(fortran_data.template cast<py::array_t<F>>());
+        fill_test_array(*fortran_array);
+        expect((fortran_array->array().flags() & py::array::c_style) == 0);
+        expect(exactly_equal(*save_and_load(py::cast(fortran_array)), *reference));
+        expect(exactly_equal(*save_and_load(py::cast(reference)), *reference));
+
+        // errors are passed on to Python
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        expect(throws<py::error_already_set>(
+            [&]()
+            {
+                return bindings.attr("load_vector_array")(path);
+            }));
+        std::filesystem::remove(path);
+    } | std::tuple<float, double, std::complex<double>>{};
+
+    return 0;
+}
@@ -54,9 +54,11 @@ struct FloatingPointApproxEqualOp
 
     [[nodiscard]] constexpr explicit operator bool() const
     {
-        constexpr F abs_tol = std::numeric_limits<F>::epsilon() * 10;
-        constexpr F rel_tol = abs_tol;
-        return std::abs(lhs_ - rhs_) < abs_tol + std::max(std::abs(lhs_), std::abs(lhs_)) * rel_tol;
+        // tolerances are real numbers, also for complex F
+        using R = decltype(std::abs(lhs_));
+        constexpr R abs_tol = std::numeric_limits<R>::epsilon() * 10;
+        constexpr R rel_tol = abs_tol;
+        return std::abs(lhs_ - rhs_) < abs_tol + std::max(std::abs(lhs_), std::abs(rhs_)) * rel_tol;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const FloatingPointApproxEqualOp& eq)
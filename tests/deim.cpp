@@ -0,0 +1,127 @@
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/deim.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+// array with the given vectors, scaled by a (complex for complex F) factor which does not change the dofs
+template <floating_point_or_complex F>
+std::shared_ptr<MappedNpyVectorArray<F>> create_array(const std::vector<std::vector<double>>& vectors)
+{
+    F factor(1);
+    if constexpr (complex<F>)
+    {
+        factor = F(0.6, -0.8);
+    }
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(std::ssize(vectors), std::ssize(vectors[0]));
+    for (ssize_t i = 0; i < ret->size(); ++i)
+    {
+        for (ssize_t j = 0; j < ret->dim(); ++j)
+        {
+            ret->set(i, j, factor * F(real_type_t<F>(vectors[as_size_t(i)][as_size_t(j)])));
+        }
+    }
+    return ret;
+}
+
+// the first size sine modes on dim equidistant points
+std::vector<std::vector<double>> sine_modes(ssize_t size, ssize_t dim)
+{
+    std::vector<std::vector<double>> ret(as_size_t(size), std::vector<double>(as_size_t(dim)));
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            ret[as_size_t(i)][as_size_t(j)] =
+                std::sin(double(i + 1) * std::numbers::pi * double(j + 1) / double(dim + 1));
+        }
+    }
+    return ret;
+}
+}  // namespace
+
+int main()
+{
+    "DEIM"_test = []<floating_point_or_complex F>()
+    {
+        // the third vector is the sum of the first two and is skipped
+        const auto basis = create_array<F>(
+            {{1, 2, 5, 3, 0}, {0, 1, 1, 4, 2}, {1, 3, 6, 7, 2}, {1, 0, 0, 0, 0}});
+        for (const ssize_t num_threads : {1, 3})
+        {
+            const auto result = deim(*basis, {.num_threads = num_threads});
+            expect(result.interpolation_dofs.as_vec(5) == std::vector<ssize_t>{2, 3, 0});
+            expect(result.collateral_basis->size() == 3);
+            expect(result.collateral_basis->dofs({0, 1, 2, 3, 4}) ==
+                   basis->dofs({0, 1, 2, 3, 4}, Indices{0, 1, 3}));
+        }
+    } | std::tuple<float, double, std::complex<double>>{};
+
+    "Q-DEIM"_test = []<floating_point_or_complex F>()
+    {
+        const auto basis = create_array<F>({{1, 2, 5, 3, 0}, {0, 1, 1, 4, 2}});
+        const auto result = qdeim(*basis);
+        expect(result.interpolation_dofs.as_vec(5) == std::vector<ssize_t>{2, 3});
+        expect(result.collateral_basis->dofs({0, 1, 2, 3, 4}) == basis->dofs({0, 1, 2, 3, 4}));
+    } | std::tuple<float, double, std::complex<double>>{};
+
+    "Multithreading"_test = []()
+    {
+        // several dof blocks for qdeim
+        const auto basis = create_array<double>(sine_modes(8, 1000));
+        const auto deim_result = deim(*basis);
+        const auto qdeim_result = qdeim(*basis);
+        for (const auto* result : {&deim_result, &qdeim_result})
+        {
+            const auto dofs = result->interpolation_dofs.as_vec(1000);
+            expect(dofs.size() == 8 && std::set<ssize_t>(dofs.begin(), dofs.end()).size() == 8);
+        }
+        for (const ssize_t num_threads : {0, 4})
+        {
+            expect(deim(*basis, {.num_threads = num_threads}).interpolation_dofs.as_vec(1000) ==
+                   deim_result.interpolation_dofs.as_vec(1000));
+            expect(qdeim(*basis, {.num_threads = num_threads}).interpolation_dofs.as_vec(1000) ==
+                   qdeim_result.interpolation_dofs.as_vec(1000));
+        }
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        const auto dependent = create_array<double>({{1, 2, 3}, {2, 4, 6}});
+        expect(deim(*dependent).collateral_basis->size() == 1);
+        const auto random_dependent = create_random_test_array<double>(5, 20, {2});
+        expect(deim(*random_dependent).interpolation_dofs.size(20) == 4);
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return qdeim(*dependent);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return qdeim(*create_array<double>({{1, 0}, {0, 1}, {1, 1}}));
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return deim(*dependent, {.tolerance = -1.});
+            }));
+    };
+
+    return 0;
+}
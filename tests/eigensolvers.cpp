@@ -0,0 +1,197 @@
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/eigensolvers.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/inner_products/weighted_euclidean.h>
+#include <nias_cpp/interfaces/inner_products.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "operators/common.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+constexpr ssize_t dim = 80;
+
+// tridiagonal matrix with diagonal 2 and off-diagonal entries b (above) and conj(b) (below), each row is
+// divided by the corresponding weight
+template <floating_point_or_complex F>
+CsrMatrixOperator<F> weighted_tridiagonal(F b, const std::vector<double>& weights)
+{
+    return tridiagonal_operator<F>(std::vector<F>(dim, F(2)), conj_if_complex(b), b, weights);
+}
+
+// the k-th smallest eigenvalue (starting at 0) of the (unweighted) tridiagonal matrix
+double exact_eigenvalue(ssize_t k)
+{
+    return 2. - (2. * std::cos(double(k + 1) * std::numbers::pi / double(dim + 1)));
+}
+
+// true if the eigenpairs in result are orthonormal and have small residuals
+template <floating_point_or_complex F>
+bool are_eigenpairs(const OperatorInterface<F>& op, const InnerProductInterface<F>& inner_product,
+                    const EigensolverResult<F>& result, double tolerance)
+{
+    const auto& eigenvectors = *result.eigenvectors;
+    const auto residual = eigenvectors.copy();
+    std::vector<F> scaling;
+    for (const auto eigenvalue : result.eigenvalues)
+    {
+        scaling.push_back(F(-eigenvalue));
+    }
+    residual->scal(scaling);
+    residual->axpy(F(1), *op.apply(eigenvectors));
+    const auto residual_norms2 = inner_product.apply_pairwise(*residual, *residual);
+    const auto gram = inner_product.apply(eigenvectors, eigenvectors);
+    for (size_t i = 0; i < gram.size(); ++i)
+    {
+        if (!(std::sqrt(std::abs(residual_norms2[i])) <= tolerance))
+        {
+            return false;
+        }
+        for (size_t j = 0; j < gram.size(); ++j)
+        {
+            if (!(std::abs(gram[i][j] - F(i == j ? 1 : 0)) <= 1e-10))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main()
+{
+    "hermitian_eigenpairs"_test = []()
+    {
+        using F = std::complex<double>;
+        const std::vector<std::vector<F>> a{
+            {F(2), F(0, 1), F(0)}, {F(0, -1), F(2), F(0)}, {F(0), F(0), F(5)}};
+        const auto [values, vectors] = hermitian_eigenpairs(a);
+        expect(values.size() == 3 && std::abs(values[0] - 1) < 1e-14 && std::abs(values[1] - 3) < 1e-14 &&
+               std::abs(values[2] - 5) < 1e-14);
+        for (size_t k = 0; k < 3; ++k)
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                F product(0);
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    product += a[i][j] * vectors[k][j];
+                }
+                expect(std::abs(product - (values[k] * vectors[k][i])) < 1e-14);
+            }
+        }
+    };
+
+    "Euclidean inner product"_test = []<floating_point_or_complex F>()
+    {
+        const std::vector<double> weights(dim, 1.);
+        const auto op = weighted_tridiagonal<F>(off_diagonal<F>(), weights);
+        const EuclideanInnerProduct<F> inner_product;
+        for (const ssize_t num_threads : {1, 4})
+        {
+            const EigensolverOptions smallest{.num_eigenvalues = 3, .num_threads = num_threads};
+            const auto lobpcg_result =
+                lobpcg(op, *create_random_test_array<F>(4, dim), inner_product, smallest);
+            const auto lanczos_result =
+                lanczos(op, *create_random_test_array<F>(1, dim), inner_product, smallest);
+            for (const auto* result : {&lobpcg_result, &lanczos_result})
+            {
+                expect(result->converged && result->eigenvalues.size() == 3);
+                expect(are_eigenpairs(op, inner_product, *result, 1e-6));
+                for (ssize_t k = 0; k < 3; ++k)
+                {
+                    expect(std::abs(result->eigenvalues[as_size_t(k)] - exact_eigenvalue(k)) < 1e-10);
+                }
+            }
+            // lanczos needs restarts with the default Krylov space dimension
+            expect(lanczos_result.num_iterations > 1);
+            const EigensolverOptions largest{
+                .num_eigenvalues = 2, .which = EigenvalueSelection::largest, .num_threads = num_threads};
+            const auto initial_vectors = create_random_test_array<F>(2, dim);
+            const auto initial_vector = initial_vectors->copy(Indices{0});
+            for (const auto& result : {lobpcg(op, *initial_vectors, inner_product, largest),
+                                       lanczos(op, *initial_vector, inner_product, largest)})
+            {
+                expect(result.converged);
+                expect(std::abs(result.eigenvalues[0] - exact_eigenvalue(dim - 1)) < 1e-10);
+                expect(std::abs(result.eigenvalues[1] - exact_eigenvalue(dim - 2)) < 1e-10);
+            }
+        }
+    } | std::tuple<double, std::complex<double>>{};
+
+    "Weighted inner product"_test = []()
+    {
+        // W^{-1} K is self-adjoint with respect to the inner product given by W
+        std::vector<double> weights;
+        for (ssize_t i = 0; i < dim; ++i)
+        {
+            weights.push_back(double(1 + (i % 3)));
+        }
+        const auto op = weighted_tridiagonal<double>(-1., weights);
+        const WeightedEuclideanInnerProduct<double> inner_product(weights);
+        const EigensolverOptions options{.num_eigenvalues = 2, .tolerance = 1e-10};
+        const auto initial_vectors = create_random_test_array<double>(3, dim);
+        const auto lobpcg_result = lobpcg(op, *initial_vectors, inner_product, options);
+        const auto lanczos_result = lanczos(op, *initial_vectors->copy(Indices{0}), inner_product, options);
+        expect(lobpcg_result.converged && lanczos_result.converged);
+        expect(are_eigenpairs(op, inner_product, lobpcg_result, 1e-8));
+        expect(are_eigenpairs(op, inner_product, lanczos_result, 1e-8));
+        for (size_t k = 0; k < 2; ++k)
+        {
+            expect(std::abs(lobpcg_result.eigenvalues[k] - lanczos_result.eigenvalues[k]) < 1e-10);
+        }
+        // the iteration limit is respected
+        const auto result = lobpcg(op, *create_random_test_array<double>(3, dim), inner_product,
+                                   EigensolverOptions{.num_eigenvalues = 2, .max_iterations = 2});
+        expect(!result.converged && result.num_iterations == 2);
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        const auto op = weighted_tridiagonal<double>(-1., std::vector<double>(dim, 1.));
+        const EuclideanInnerProduct<double> inner_product;
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return lobpcg(op, *create_random_test_array<double>(1, dim), inner_product,
+                              EigensolverOptions{.num_eigenvalues = 2});
+            }));
+        const auto dependent = create_random_test_array<double>(1, dim);
+        dependent->append(*dependent->copy());
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return lobpcg(op, *dependent, inner_product, EigensolverOptions{.num_eigenvalues = 2});
+            }));
+        const auto zero = create_random_test_array<double>(1, dim);
+        zero->scal(0.);
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return lanczos(op, *zero, inner_product);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return lanczos(op, *create_random_test_array<double>(1, dim), inner_product,
+                               EigensolverOptions{.num_eigenvalues = 3, .krylov_dim = 3});
+            }));
+    };
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <complex>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_cache.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/weighted_euclidean.h>
+#include <nias_cpp/interfaces/vector.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "test_vector.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+constexpr ssize_t dim = 20;
+
+template <floating_point_or_complex F>
+std::shared_ptr<const InnerProductInterface<F>> weighted_inner_product()
+{
+    std::vector<real_type_t<F>> weights;
+    for (ssize_t j = 0; j < dim; ++j)
+    {
+        weights.push_back(real_type_t<F>(1 + (j % 4)));
+    }
+    return std::make_shared<WeightedEuclideanInnerProduct<F>>(weights);
+}
+}  // namespace
+
+int main()
+{
+    "Incremental updates"_test = []<floating_point_or_complex F>()
+    {
+        const auto inner_product = weighted_inner_product<F>();
+        for (const ssize_t num_threads : {1, 3})
+        {
+            const auto vec_array = create_test_array<F>(3, dim);
+            GramCache<F> cache(vec_array, inner_product, num_threads);
+            expect(cache.num_threads() == num_threads);
+            expect(approx_equal(cache.gram_matrix(), inner_product->apply(*vec_array, *vec_array)));
+            vec_array->append(*create_test_array<F>(6, dim, 1));
+            expect(approx_equal(cache.gram_matrix(), inner_product->apply(*vec_array, *vec_array)));
+            vec_array->append(*create_test_array<F>(1, dim, 2));
+            expect(approx_equal(cache.gram_matrix(), inner_product->apply(*vec_array, *vec_array)));
+            // no changes, nothing to do
+            static_cast<void>(cache.gram_matrix());
+            expect(cache.num_full_updates() == 1 && cache.num_incremental_updates() == 2);
+        }
+    } | std::tuple<double, std::complex<double>>{};
+
+    "Deletion"_test = []<floating_point_or_complex F>()
+    {
+        const auto inner_product = weighted_inner_product<F>();
+        const auto vec_array = create_test_array<F>(10, dim);
+        GramCache<F> cache(vec_array, inner_product);
+        cache.delete_vectors(Indices{1, 4, -1, 4});
+        expect(vec_array->size() == 7);
+        expect(approx_equal(cache.gram_matrix(), inner_product->apply(*vec_array, *vec_array)));
+        vec_array->append(*create_test_array<F>(2, dim, 3));
+        expect(approx_equal(cache.gram_matrix(), inner_product->apply(*vec_array, *vec_array)));
+        expect(cache.num_full_updates() == 1 && cache.num_incremental_updates() == 1);
+        cache.delete_vectors(std::nullopt);
+        expect(vec_array->size() == 0 && cache.gram_matrix().empty());
+        expect(cache.num_full_updates() == 1);
+        expect(throws<InvalidIndexError>(
+            [&]()
+            {
+                cache.delete_vectors(Indices{0});
+            }));
+    } | std::tuple<double, std::complex<double>>{};
+
+    "Invalidation"_test = []()
+    {
+        const auto vec_array = create_test_array<double>(5, dim);
+        GramCache<double> cache(vec_array);
+        static_cast<void>(cache.gram_matrix());
+        // deletions which do not go through the cache
+        vec_array->delete_vectors(Indices{0});
+        expect(approx_equal(cache.gram_matrix(), vec_array->inner(*vec_array)));
+        expect(cache.num_full_updates() == 2);
+        // modifications, even if the array grows at the same time
+        vec_array->scal(2., Indices{1});
+        vec_array->append(*create_test_array<double>(1, dim, 1));
+        expect(approx_equal(cache.gram_matrix(), vec_array->inner(*vec_array)));
+        expect(cache.num_full_updates() == 3 && cache.num_incremental_updates() == 0);
+        cache.invalidate();
+        static_cast<void>(cache.gram_matrix());
+        expect(cache.num_full_updates() == 4);
+        // non-const accessors count as modifications when they are called
+        static_cast<void>(vec_array->mutable_data());
+        static_cast<void>(cache.gram_matrix());
+        expect(cache.num_full_updates() == 5);
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return GramCache<double>(nullptr);
+            }));
+    };
+
+    "Version counters"_test = []()
+    {
+        ListVectorArray<double> list(dim);
+        list.append(std::shared_ptr<VectorInterface<double>>(std::make_shared<DynamicVector<double>>(dim)));
+        list.append(std::shared_ptr<VectorInterface<double>>(std::make_shared<DynamicVector<double>>(dim)));
+        expect(list.version() == VectorArrayVersion{.appends = 2, .deletions = 0, .modifications = 0});
+        const auto& const_list = list;
+        static_cast<void>(const_list.vector(0));
+        expect(list.version().modifications == 0);
+        list.vector(0).scal(2.);
+        list.delete_vectors(Indices{1});
+        expect(list.version() == VectorArrayVersion{.appends = 2, .deletions = 1, .modifications = 1});
+        // views report the version of the viewed array, writes through views modify the viewed array
+        auto view = list[Indices{0}];
+        view.scal({3.});
+        expect(view.version() == list.version() && list.version().modifications == 2);
+
+        MappedNpyVectorArray<double> mapped(2, dim);
+        static_cast<void>(mapped.data());
+        expect(mapped.version() == VectorArrayVersion{});
+        static_cast<void>(mapped.mutable_data());
+        MappedNpyVectorArray<double> other(1, dim);
+        mapped.append(other, true);
+        expect(mapped.version() == VectorArrayVersion{.appends = 1, .deletions = 0, .modifications = 1});
+        expect(other.version().deletions == 1 && other.size() == 0);
+    };
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <format>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/type_traits.h>
+
+#include "boost_ext_ut_no_module.h"
+
+int main()
+{
+    using namespace boost::ut;
+    using namespace nias;
+
+    "Indices (vector)"_test = []()
+    {
+        const Indices indices({3, -1, 0});
+        expect(indices.size(10) == 3);
+        expect(indices.as_vec(10) == std::vector<ssize_t>{3, 9, 0});
+        expect(indices.get(1, 10) == 9);
+        expect(indices.unique_indices(10) == std::set<ssize_t>{0, 3, 9});
+        expect(nothrow(
+            [&]()
+            {
+                indices.check_valid(10);
+            }));
+        expect(throws<InvalidIndexError>(
+            [&]()
+            {
+                indices.check_valid(3);
+            }));
+    };
+
+    "Indices (slice)"_test = []()
+    {
+        constexpr ssize_t length = 10;
+        // expected results have been computed with Python, i.e., list(range(10))[start:stop:step]
+        const std::vector<std::tuple<SliceData, std::vector<ssize_t>>> cases{
+            {{std::nullopt, std::nullopt, std::nullopt}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}},
+            {{2, 8, 3}, {2, 5}},
+            {{-3, std::nullopt, std::nullopt}, {7, 8, 9}},
+            {{8, 2, -2}, {8, 6, 4}},
+            {{std::nullopt, std::nullopt, -1}, {9, 8, 7, 6, 5, 4, 3, 2, 1, 0}},
+            {{std::nullopt, std::nullopt, -3}, {9, 6, 3, 0}},
+            {{20, 30, std::nullopt}, {}},
+            {{-100, 100, std::nullopt}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}},
+            {{5, -12, -1}, {5, 4, 3, 2, 1, 0}},
+            {{3, 3, std::nullopt}, {}},
+        };
+        for (const auto& [slice, expected] : cases)
+        {
+            const Indices indices(slice);
+            test(std::format("{}:{}:{}", slice.start.value_or(0), slice.stop.value_or(0),
+                             slice.step.value_or(1))) = [&]()
+            {
+                expect(indices.size(length) == std::ssize(expected));
+                expect(indices.as_vec(length) == expected);
+                std::vector<ssize_t> visited;
+                indices.for_each(
+                    [&](ssize_t index)
+                    {
+                        visited.push_back(index);
+                    },
+                    length);
+                expect(visited == expected);
+                for (ssize_t i = 0; i < std::ssize(expected); ++i)
+                {
+                    expect(indices.get(i, length) == expected[as_size_t(i)]);
+                }
+            };
+        }
+
+        test("empty sequence") = []()
+        {
+            expect(Slice(std::nullopt, std::nullopt, -1).size(0) == 0);
+            expect(Slice(std::nullopt, std::nullopt).as_vec(0).empty());
+        };
+
+        test("zero step") = []()
+        {
+            expect(throws<InvalidArgumentError>(
+                []()
+                {
+                    static_cast<void>(Slice(0, 10, 0));
+                }));
+        };
+    };
+
+    return 0;
+}
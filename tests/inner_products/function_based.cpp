@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <complex>
+#include <format>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/function_based.h>
+#include <nias_cpp/interfaces/vector.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../common.h"
+#include "../test_vector.h"
+
+namespace
+{
+// weighted inner product (u, v) = sum_i conj(u_i) * (i + 1) * v_i
+template <floating_point_or_complex F>
+F weighted_inner_product(const VectorInterface<F>& lhs, const VectorInterface<F>& rhs)
+{
+    F ret = 0;
+    for (ssize_t i = 0; i < lhs.dim(); ++i)
+    {
+        if constexpr (complex<F>)
+        {
+            ret += std::conj(lhs.get(i)) * F(i + 1) * rhs.get(i);
+        }
+        else
+        {
+            ret += lhs.get(i) * F(i + 1) * rhs.get(i);
+        }
+    }
+    return ret;
+}
+
+template <floating_point_or_complex F>
+std::shared_ptr<ListVectorArray<F>> create_test_array(ssize_t size, ssize_t dim)
+{
+    auto vec_array = std::make_shared<ListVectorArray<F>>(dim);
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        auto vec = std::make_shared<DynamicVector<F>>(dim);
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            if constexpr (complex<F>)
+            {
+                vec->get(j) = F(i + j, i - (2 * j));
+            }
+            else
+            {
+                vec->get(j) = F(i + j) / F(size);
+            }
+        }
+        vec_array->append(vec);
+    }
+    return vec_array;
+}
+
+// The results of the different code paths may differ by rounding errors (e.g., if entries are
+// computed as conj((v, u)) instead of (u, v)), so we compare with a tolerance relative to the
+// largest entry of the expected result.
+template <floating_point_or_complex F>
+struct TileComparison
+{
+    explicit TileComparison(const std::vector<std::vector<F>>& expected)
+    {
+        for (const auto& row : expected)
+        {
+            for (const auto& entry : row)
+            {
+                scale = std::max(scale, static_cast<double>(std::abs(entry)));
+            }
+        }
+    }
+
+    [[nodiscard]] bool operator()(F lhs, F rhs) const
+    {
+        using R = decltype(std::abs(lhs));
+        return static_cast<double>(std::abs(lhs - rhs)) <=
+               100. * static_cast<double>(std::numeric_limits<R>::epsilon()) * scale;
+    }
+
+    [[nodiscard]] bool operator()(const std::vector<std::vector<F>>& lhs,
+                                  const std::vector<std::vector<F>>& rhs) const
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            if (lhs[i].size() != rhs[i].size())
+            {
+                return false;
+            }
+            for (size_t j = 0; j < lhs[i].size(); ++j)
+            {
+                if (!(*this)(lhs[i][j], rhs[i][j]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    double scale = 0.;
+};
+}  // namespace
+
+int main()
+{
+    using namespace boost::ut;
+    using namespace nias;
+
+    "VectorFunctionBasedInnerProduct"_test = []<floating_point_or_complex F>()
+    {
+        const ssize_t size = 37;
+        const ssize_t dim = 5;
+        const auto vec_array = create_test_array<F>(size, dim);
+        const auto other_array = create_test_array<F>(size - 3, dim);
+
+        // reference result computed entry by entry
+        std::vector<std::vector<F>> expected(as_size_t(size), std::vector<F>(as_size_t(size)));
+        for (ssize_t i = 0; i < size; ++i)
+        {
+            for (ssize_t j = 0; j < size; ++j)
+            {
+                expected[as_size_t(i)][as_size_t(j)] =
+                    weighted_inner_product(vec_array->vector(i), vec_array->vector(j));
+            }
+        }
+
+        const auto close = TileComparison<F>(expected);
+
+        const auto block_function =
+            [](const VectorArrayInterface<F>& left, const VectorArrayInterface<F>& right)
+        {
+            std::vector<std::vector<F>> ret(as_size_t(left.size()),
+                                            std::vector<F>(as_size_t(right.size())));
+            for (ssize_t i = 0; i < left.size(); ++i)
+            {
+                for (ssize_t j = 0; j < right.size(); ++j)
+                {
+                    ret[as_size_t(i)][as_size_t(j)] =
+                        weighted_inner_product(left.vector(i), right.vector(j));
+                }
+            }
+            return ret;
+        };
+
+        for (const ssize_t num_threads : {1, 0, 3})
+        {
+            for (const ssize_t tile_size : {1, 4, 64})
+            {
+                const auto vector_based =
+                    VectorFunctionBasedInnerProduct<F>(weighted_inner_product<F>, num_threads, tile_size);
+                const auto block_based = VectorFunctionBasedInnerProduct<F>::from_block_function(
+                    block_function, num_threads, tile_size);
+
+                test(std::format("{} threads, tile size {}", num_threads, tile_size)) = [&]()
+                {
+                    for (const auto* inner_product : {&vector_based, &block_based})
+                    {
+                        // symmetric case (only the upper triangle is computed)
+                        expect(close(inner_product->apply(*vec_array, *vec_array), expected));
+
+                        // non-symmetric case
+                        const auto result = inner_product->apply(*vec_array, *other_array);
+                        expect(result.size() == as_size_t(size));
+                        for (ssize_t i = 0; i < size; ++i)
+                        {
+                            for (ssize_t j = 0; j < other_array->size(); ++j)
+                            {
+                                expect(close(result[as_size_t(i)][as_size_t(j)],
+                                             weighted_inner_product(vec_array->vector(i),
+                                                                    other_array->vector(j))));
+                            }
+                        }
+
+                        // indices
+                        const auto indexed = inner_product->apply(*vec_array, *vec_array,
+                                                                  Indices({3, 1, 2}), Indices({3, 1, 2}));
+                        for (ssize_t i = 0; i < 3; ++i)
+                        {
+                            for (ssize_t j = 0; j < 3; ++j)
+                            {
+                                const auto index_i = as_size_t(i == 0 ? 3 : i);
+                                const auto index_j = as_size_t(j == 0 ? 3 : j);
+                                expect(
+                                    close(indexed[as_size_t(i)][as_size_t(j)], expected[index_i][index_j]));
+                            }
+                        }
+
+                        // pairwise
+                        const auto pairwise = inner_product->apply_pairwise(*vec_array, *vec_array);
+                        expect(pairwise.size() == as_size_t(size));
+                        for (ssize_t i = 0; i < size; ++i)
+                        {
+                            expect(close(pairwise[as_size_t(i)], expected[as_size_t(i)][as_size_t(i)]));
+                        }
+                    }
+                };
+            }
+        }
+
+        test("Invalid parameters") = []()
+        {
+            expect(throws<InvalidArgumentError>(
+                []()
+                {
+                    static_cast<void>(VectorFunctionBasedInnerProduct<F>(weighted_inner_product<F>, 1, 0));
+                }));
+            expect(throws<InvalidArgumentError>(
+                []()
+                {
+                    static_cast<void>(VectorFunctionBasedInnerProduct<F>(weighted_inner_product<F>, -1));
+                }));
+        };
+    } | std::tuple<float, double, std::complex<float>, std::complex<double>>{};
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/operator_based.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../operators/common.h"
+#include "../vectorarray/common.h"
+
+namespace
+{
+// tridiagonal matrix with 4 on the diagonal and 1 on the off-diagonals (the P1 finite element mass matrix
+// up to a factor)
+template <floating_point_or_complex F>
+std::shared_ptr<CsrMatrixOperator<F>> create_mass_matrix(ssize_t dim)
+{
+    return std::make_shared<CsrMatrixOperator<F>>(
+        tridiagonal_operator<F>(std::vector<F>(as_size_t(dim), F(4)), F(1), F(1)));
+}
+
+}  // namespace
+
+int main()
+{
+    "OperatorBasedInnerProduct"_test = []<floating_point_or_complex F>()
+    {
+        const auto mass_matrix = create_mass_matrix<F>(30);
+        OperatorBasedInnerProduct<F> inner_product(mass_matrix);
+        const auto left = create_test_array<F>(4, 30);
+        const auto right = create_test_array<F>(6, 30);
+        const auto expected = left->inner(*mass_matrix->apply(*right));
+        expect(inner_product.apply(*left, *right) == expected);
+        expect(inner_product.apply(*left, *right, Indices{3}, Indices{5, 0}) ==
+               left->inner(*mass_matrix->apply(*right, Indices{5, 0}), Indices{3}));
+        expect(inner_product.apply_pairwise(*left, *right, std::nullopt, Indices{1, 2, 3, 4}) ==
+               left->pairwise_inner(*mass_matrix->apply(*right, Indices{1, 2, 3, 4})));
+
+        // cached products are used until the cache is cleared
+        expect(!inner_product.is_cached(*right));
+        inner_product.cache_right_array(right);
+        expect(inner_product.is_cached(*right));
+        expect(inner_product.apply(*left, *right) == expected);
+        expect(inner_product.apply(*left, *right, Indices{3}, Indices{5, 0}) ==
+               left->inner(*mass_matrix->apply(*right, Indices{5, 0}), Indices{3}));
+        expect(inner_product.apply_pairwise(*left, *right, std::nullopt, Indices{1, 2, 3, 4}) ==
+               left->pairwise_inner(*mass_matrix->apply(*right, Indices{1, 2, 3, 4})));
+        inner_product.clear_cache();
+        expect(!inner_product.is_cached(*right));
+
+        // modifications of the cached array invalidate the cache
+        inner_product.cache_right_array(right);
+        right->scal(F(2));
+        expect(!inner_product.is_cached(*right));
+        expect(inner_product.apply(*left, *right) == left->inner(*mass_matrix->apply(*right)));
+        inner_product.cache_right_array(right);
+        right->append(*left);
+        expect(!inner_product.is_cached(*right));
+        expect(inner_product.apply(*left, *right) == left->inner(*mass_matrix->apply(*right)));
+    } | std::tuple<double, float, std::complex<double>>{};
+
+    "Gram-Schmidt with mass matrix"_test = []()
+    {
+        const auto mass_matrix = create_mass_matrix<double>(40);
+        const OperatorBasedInnerProduct<double> inner_product(mass_matrix);
+        const auto array = create_test_array<double>(5, 40);
+        gram_schmidt_cpp(*array, inner_product);
+        const auto gram = inner_product.apply(*array, *array);
+        expect(array->size() == 5);
+        for (size_t i = 0; i < gram.size(); ++i)
+        {
+            for (size_t j = 0; j < gram.size(); ++j)
+            {
+                expect(std::abs(gram[i][j] - (i == j ? 1. : 0.)) < 1e-12);
+            }
+        }
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                const auto op = std::make_shared<CsrMatrixOperator<double>>(
+                    1, 2, std::vector<ssize_t>{0, 0}, std::vector<ssize_t>{}, std::vector<double>{});
+                return OperatorBasedInnerProduct<double>(op);
+            }));
+    };
+
+    return 0;
+}
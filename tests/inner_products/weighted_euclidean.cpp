@@ -0,0 +1,112 @@
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/weighted_euclidean.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/sparse.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../vectorarray/common.h"
+
+namespace
+{
+// weights are small integers divided by 4 (like the entries of the test arrays, so all results are exact)
+template <floating_point_or_complex F>
+std::vector<typename VectorArrayInterface<F>::RealType> create_weights(ssize_t dim)
+{
+    using RealType = typename VectorArrayInterface<F>::RealType;
+    std::vector<RealType> ret;
+    for (ssize_t j = 0; j < dim; ++j)
+    {
+        ret.push_back(RealType((j % 7) + 1) / RealType(4));
+    }
+    return ret;
+}
+
+// sum_k w_k conj(u_k) v_k computed entry by entry
+template <floating_point_or_complex F>
+std::vector<std::vector<F>> reference_gram(
+    const std::vector<typename VectorArrayInterface<F>::RealType>& weights,
+    const VectorArrayInterface<F>& left, const VectorArrayInterface<F>& right)
+{
+    std::vector<std::vector<F>> ret(as_size_t(left.size()), std::vector<F>(as_size_t(right.size()), F(0)));
+    for (ssize_t i = 0; i < left.size(); ++i)
+    {
+        for (ssize_t j = 0; j < right.size(); ++j)
+        {
+            for (ssize_t k = 0; k < left.dim(); ++k)
+            {
+                ret[as_size_t(i)][as_size_t(j)] +=
+                    weights[as_size_t(k)] * conj_if_complex(left.get(i, k)) * right.get(j, k);
+            }
+        }
+    }
+    return ret;
+}
+}  // namespace
+
+int main()
+{
+    "WeightedEuclideanInnerProduct"_test = []<floating_point_or_complex F>()
+    {
+        // dimensions which are not a multiple of the SIMD width and do not fit into a single block
+        for (const ssize_t dim : {0, 1, 13, 1500})
+        {
+            const auto weights = create_weights<F>(dim);
+            const WeightedEuclideanInnerProduct<F> inner_product(weights);
+            expect(inner_product.dim() == dim);
+            const auto left = create_test_array<F>(4, dim);
+            const auto right = create_test_array<F>(5, dim);
+            const auto expected = reference_gram<F>(weights, *left, *right);
+            expect(inner_product.apply(*left, *right) == expected);
+            expect(inner_product.apply(*left, *left) == reference_gram<F>(weights, *left, *left));
+            expect(inner_product.apply(*left, *right, Indices{3, 0}, Indices{1}) ==
+                   reference_gram<F>(weights, *left->copy(Indices{3, 0}), *right->copy(Indices{1})));
+            // arrays of other types are copied first
+            const SparseVectorArray<F> sparse(*right);
+            expect(inner_product.apply(*left, sparse) == expected);
+            const auto pairwise =
+                inner_product.apply_pairwise(*left, *right, std::nullopt, Indices{4, 3, 2, 1});
+            const auto norms2 = inner_product.apply_pairwise(*left, *left);
+            for (size_t i = 0; i < 4; ++i)
+            {
+                expect(pairwise[i] == expected[i][4 - i]);
+                expect(norms2[i] == reference_gram<F>(weights, *left, *left)[i][i]);
+            }
+            const auto norms = inner_product.induced_norm()(*left);
+            expect(std::abs(norms[0] - std::sqrt(norms2[0])) == 0);
+        }
+    } | std::tuple<double, float, std::complex<double>>{};
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return WeightedEuclideanInnerProduct<double>({1., 0.});
+            }));
+        const WeightedEuclideanInnerProduct<double> inner_product({1., 2.});
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                const auto array = create_test_array<double>(1, 3);
+                return inner_product.apply(*array, *array);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return inner_product.apply_pairwise(*create_test_array<double>(1, 2),
+                                                    *create_test_array<double>(2, 2));
+            }));
+    };
+
+    return 0;
+}
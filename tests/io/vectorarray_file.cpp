@@ -0,0 +1,168 @@
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/interfaces/vector.h>
+#include <nias_cpp/io/npy.h>
+#include <nias_cpp/io/vectorarray_file.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../test_vector.h"
+#include "../vectorarray/common.h"
+
+namespace
+{
+std::filesystem::path temporary_file(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() /
+           std::format("nias_cpp_test_vectorarray_file_{}.bin", name);
+}
+
+// header checksum as computed by save_vector_array (FNV-1a over 8-byte words, followed by the length)
+std::uint64_t header_checksum(std::string_view header)
+{
+    constexpr std::uint64_t prime = 1099511628211ULL;
+    constexpr size_t checksum_offset = 56;
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (size_t pos = 0; pos < checksum_offset; pos += sizeof(std::uint64_t))
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, header.data() + pos, sizeof(std::uint64_t));
+        hash = (hash ^ word) * prime;
+    }
+    return (hash ^ checksum_offset) * prime;
+}
+}  // namespace
+
+int main()
+{
+    "Saving and loading vector arrays"_test = []<floating_point_or_complex F>()
+    {
+        const auto path = temporary_file(npy_descr<F>().substr(1));
+        for (const ssize_t size : {0, 1, 7})
+        {
+            for (const ssize_t dim : {0, 3, 100})
+            {
+                const auto array = create_test_array<F>(size, dim);
+                // chunks of 64 bytes, so most arrays are split into several chunks
+                for (const VectorArrayFileOptions options :
+                     {VectorArrayFileOptions{}, VectorArrayFileOptions{.chunk_size = 64, .num_threads = 4}})
+                {
+                    save_vector_array(*array, path, options);
+                    expect(std::filesystem::file_size(path) ==
+                           as_size_t(vector_array_file_header_size + (size * dim * ssize_t(sizeof(F)))));
+                    const auto header = read_vector_array_file_header(path);
+                    expect(header.template has_scalar_type<F>());
+                    expect(header.size == size && header.dim == dim);
+                    expect(exactly_equal(*load_vector_array<F>(path, options), *array));
+                    expect(exactly_equal(*open_vector_array<F>(path, true), *array));
+                }
+            }
+        }
+
+        // arrays which are not stored contiguously are saved using get
+        const std::shared_ptr<VectorInterface<F>> vec1(new DynamicVector{F(1), F(2), F(3)});
+        const std::shared_ptr<VectorInterface<F>> vec2(new DynamicVector{F(4), F(5), F(6)});
+        const ListVectorArray<F> list_array({vec1, vec2}, 3);
+        save_vector_array(list_array, path, {.chunk_size = 64, .num_threads = 2, .verify_checksum = true});
+        expect(exactly_equal(*load_vector_array<F>(path), list_array));
+        std::filesystem::remove(path);
+    } | std::tuple<float, double, std::complex<float>, std::complex<double>>{};
+
+    "Corrupted vector array files"_test = []()
+    {
+        const auto path = temporary_file("corrupted");
+        save_vector_array(*create_test_array<double>(5, 4), path);
+
+        // wrong scalar type
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return load_vector_array<float>(path);
+            }));
+
+        // flip a byte in the data
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(vector_array_file_header_size + 17);
+            file.put('\x42');
+        }
+        expect(throws<IOError>(
+            [&]()
+            {
+                return load_vector_array<double>(path);
+            }));
+        expect(nothrow(
+            [&]()
+            {
+                return load_vector_array<double>(
+                    path, {.chunk_size = 64, .num_threads = 1, .verify_checksum = false});
+            }));
+        expect(throws<IOError>(
+            [&]()
+            {
+                return open_vector_array<double>(path, true);
+            }));
+
+        // flip a byte in the header
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(24);
+            file.put('\x01');
+        }
+        expect(throws<IOError>(
+            [&]()
+            {
+                return read_vector_array_file_header(path);
+            }));
+
+        // shapes for which the file size is not representable are rejected (even with a valid checksum)
+        save_vector_array(*create_test_array<double>(5, 4), path);
+        std::string header(as_size_t(vector_array_file_header_size), '\0');
+        std::ifstream(path, std::ios::binary).read(header.data(), vector_array_file_header_size);
+        const auto set_size = [&header](std::int64_t size)
+        {
+            std::memcpy(header.data() + 24, &size, sizeof(size));
+            const auto checksum = header_checksum(header);
+            std::memcpy(header.data() + 56, &checksum, sizeof(checksum));
+        };
+        set_size(std::int64_t(1) << 61);
+        expect(throws<IOError>(
+            [&]()
+            {
+                return parse_vector_array_file_header(header);
+            }));
+        // the checksum is computed correctly
+        set_size(3);
+        expect(parse_vector_array_file_header(header).size == 3);
+
+        // truncated file
+        save_vector_array(*create_test_array<double>(5, 4), path);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+        expect(throws<IOError>(
+            [&]()
+            {
+                return load_vector_array<double>(path);
+            }));
+        expect(throws<IOError>(
+            [&]()
+            {
+                return open_vector_array<double>(path);
+            }));
+        std::filesystem::remove(path);
+    };
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <complex>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/krylov.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "operators/common.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+constexpr ssize_t dim = 60;
+
+template <floating_point_or_complex F>
+std::shared_ptr<VectorArrayInterface<F>> zeros_like(const VectorArrayInterface<F>& vec_array)
+{
+    auto ret = vec_array.copy();
+    ret->scal(F(0));
+    return ret;
+}
+}  // namespace
+
+int main()
+{
+    "Hermitian positive definite operators"_test = []<floating_point_or_complex F>()
+    {
+        const auto op = tridiagonal_operator<F>(std::vector<F>(dim, F(4)), off_diagonal<F>(),
+                                       conj_if_complex(off_diagonal<F>()));
+        const auto rhs = create_test_array<F>(5, dim);
+        // a zero right-hand side converges immediately
+        rhs->scal(F(0), Indices{3});
+        for (const auto solver : {&cg<F>, &block_cg<F>, &minres<F>, &gmres<F>})
+        {
+            const auto solution = zeros_like(*rhs);
+            const auto result = solver(op, *rhs, *solution, KrylovOptions{.tolerance = 1e-12});
+            expect(result.converged);
+            expect(result.num_iterations > 0 && result.num_iterations < dim);
+            expect(result.residual_norms.size() == 5 && result.residual_norms[3] == 0.);
+            expect(approx_equal(to_rows(*op.apply(*solution)), to_rows(*rhs), 1e-10));
+        }
+        // the initial guess is used
+        const auto solution = zeros_like(*rhs);
+        static_cast<void>(cg(op, *rhs, *solution));
+        const auto result = cg(op, *rhs, *solution);
+        expect(result.converged && result.num_iterations == 0);
+    } | std::tuple<double, long double, std::complex<double>>{};
+
+    "Block CG with linearly dependent right-hand sides"_test = []<floating_point_or_complex F>()
+    {
+        const auto op = tridiagonal_operator<F>(std::vector<F>(dim, F(4)), off_diagonal<F>(),
+                                       conj_if_complex(off_diagonal<F>()));
+        const auto rhs = create_test_array<F>(3, dim);
+        rhs->append(*rhs->copy(Indices{1}));
+        const auto solution = zeros_like(*rhs);
+        const auto result = block_cg(op, *rhs, *solution);
+        expect(result.block_breakdown);
+        expect(result.converged);
+        expect(approx_equal(to_rows(*op.apply(*solution)), to_rows(*rhs), 1e-8));
+    } | std::tuple<double, std::complex<double>>{};
+
+    "Indefinite and nonsymmetric operators"_test = []<floating_point_or_complex F>()
+    {
+        std::vector<F> diagonal;
+        for (ssize_t i = 0; i < dim; ++i)
+        {
+            diagonal.push_back(F(i % 2 == 0 ? 3 : -3));
+        }
+        const auto indefinite =
+            tridiagonal_operator<F>(diagonal, off_diagonal<F>(), conj_if_complex(off_diagonal<F>()));
+        const auto nonsymmetric =
+            tridiagonal_operator<F>(std::vector<F>(dim, F(4)), off_diagonal<F>(), F(-2));
+        const auto rhs = create_test_array<F>(4, dim);
+        const auto minres_solution = zeros_like(*rhs);
+        expect(minres(indefinite, *rhs, *minres_solution).converged);
+        expect(approx_equal(to_rows(*indefinite.apply(*minres_solution)), to_rows(*rhs), 1e-8));
+        for (const ssize_t restart : {5, 100})
+        {
+            const auto solution = zeros_like(*rhs);
+            const auto result = gmres(nonsymmetric, *rhs, *solution, KrylovOptions{.restart = restart});
+            expect(result.converged);
+            expect(approx_equal(to_rows(*nonsymmetric.apply(*solution)), to_rows(*rhs), 1e-8));
+        }
+        // CG detects indefinite operators, the iteration limit is respected
+        expect(throws<InvalidStateError>(
+            [&]()
+            {
+                return cg(indefinite, *rhs, *zeros_like(*rhs));
+            }));
+        const auto result = gmres(nonsymmetric, *rhs, *zeros_like(*rhs), KrylovOptions{.max_iterations = 3});
+        expect(!result.converged && result.num_iterations == 3);
+    } | std::tuple<double, std::complex<double>>{};
+
+    "Invalid arguments"_test = []()
+    {
+        const auto op = tridiagonal_operator<double>(std::vector<double>(dim, 4.), -1., -1.);
+        const auto rhs = create_test_array<double>(2, dim);
+        const auto wrong_size = create_test_array<double>(1, dim);
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return cg(op, *rhs, *wrong_size);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return gmres(op, *rhs, *zeros_like(*rhs), KrylovOptions{.restart = 0});
+            }));
+        const CsrMatrixOperator<double> rectangular(1, 2, {0, 1}, {1}, {1.});
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return minres(rectangular, *create_test_array<double>(0, dim),
+                              *create_test_array<double>(0, dim));
+            }));
+    };
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/algorithms/mixed_precision_gram_schmidt.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/reduced_precision.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+// monomials t^i evaluated at dim equidistant points in [0, 1] (an ill-conditioned basis)
+template <std::floating_point F>
+std::shared_ptr<MappedNpyVectorArray<F>> create_monomials(ssize_t size, ssize_t dim)
+{
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(size, dim);
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            ret->set(i, j, F(std::pow(double(j) / double(dim - 1), double(i))));
+        }
+    }
+    return ret;
+}
+}  // namespace
+
+int main()
+{
+    "Mixed precision Gram-Schmidt in double precision"_test = []()
+    {
+        const auto array = create_monomials<double>(8, 200);
+        const auto reference = array->copy();
+        gram_schmidt_cpp(*reference);
+        const auto report = mixed_precision_gram_schmidt<double, float>(*array);
+        expect(array->size() == 8);
+        expect(loss_of_orthogonality(*array) < 1e-13);
+        expect(report.num_low_precision_passes == 7);
+        expect(report.num_high_precision_passes >= 7);
+        expect(report.num_removed_vectors == 0);
+        expect(!report.measured_loss_of_orthogonality.has_value());
+        // same basis as the double-only path (up to the loss of orthogonality of the reference)
+        const auto products = array->pairwise_inner(*reference);
+        for (const auto product : products)
+        {
+            expect(std::abs(product - 1.) < 1e-6);
+        }
+
+        // with a larger tolerance, well-conditioned vectors are not reorthogonalized in double precision
+        // (only the linearly dependent vector is, before it is removed)
+        const auto random_array = create_random_test_array<double>(10, 300, {2});
+        const auto loose_report =
+            mixed_precision_gram_schmidt<double, float>(*random_array, {.tolerance = 1e-4});
+        expect(random_array->size() == 9);
+        expect(loose_report.num_removed_vectors == 1);
+        expect(loose_report.num_high_precision_passes <= 2);
+        expect(loose_report.estimated_loss_of_orthogonality < 1e-4);
+        expect(loss_of_orthogonality(*random_array) < 1e-4);
+        // but ill-conditioned ones are
+        const auto monomials = create_monomials<double>(8, 200);
+        const auto monomials_report =
+            mixed_precision_gram_schmidt<double, float>(*monomials, {.tolerance = 1e-4});
+        expect(monomials_report.num_high_precision_passes > 0);
+        expect(loss_of_orthogonality(*monomials) < 1e-4);
+    };
+
+    "Mixed precision Gram-Schmidt of a numerically rank-deficient basis"_test = []()
+    {
+        // the higher monomials are numerically linearly dependent on the lower ones, so Gram-Schmidt in
+        // double precision cannot reach the tolerance without removing some of them
+        const auto reference = create_monomials<double>(25, 400);
+        gram_schmidt_cpp(*reference);
+        expect(loss_of_orthogonality(*reference) > 1e-4);
+        const auto monomials = create_monomials<double>(25, 400);
+        const auto report = mixed_precision_gram_schmidt<double, float>(*monomials, {.tolerance = 1e-4});
+        expect(monomials->size() < 25);
+        expect(report.num_removed_vectors == 25 - monomials->size());
+        expect(report.estimated_loss_of_orthogonality <= 1e-4);
+        expect(loss_of_orthogonality(*monomials) < 1e-4);
+    };
+
+    "Mixed precision Gram-Schmidt in single precision"_test = []()
+    {
+        const auto array = create_monomials<float>(6, 200);
+        const auto report =
+            mixed_precision_gram_schmidt<float, float>(*array, {.cholesky_qr_correction = true});
+        expect(array->size() == 6);
+        expect(report.measured_loss_of_orthogonality.has_value());
+        expect(loss_of_orthogonality(*array) < 1e-5F);
+
+        // half precision storage
+        const auto random_array = create_random_test_array<float>(10, 300, {2});
+        const auto half_report = mixed_precision_gram_schmidt<float, float16>(
+            *random_array, {.tolerance = 1e-2, .cholesky_qr_correction = true});
+        expect(random_array->size() == 9);
+        expect(half_report.num_high_precision_passes <= 2);
+        expect(half_report.measured_loss_of_orthogonality.value_or(1.) < 1e-2);
+        expect(!half_report.cholesky_qr_applied);
+        expect(loss_of_orthogonality(*random_array) < 1e-2F);
+    };
+
+    "Cholesky-QR"_test = []()
+    {
+        const auto array = create_random_test_array<double>(6, 50, {2});
+        array->delete_vectors(Indices{2});
+        cholesky_qr(*array);
+        expect(loss_of_orthogonality(*array) < 1e-13);
+
+        // with half precision storage and a large tolerance, the Gram-Schmidt result of an ill-conditioned
+        // basis is not orthogonal, so a Cholesky-QR step is applied
+        const auto monomials = create_monomials<double>(8, 200);
+        const auto report = mixed_precision_gram_schmidt<double, float16>(
+            *monomials, {.tolerance = 0.5, .cholesky_qr_correction = true});
+        expect(report.measured_loss_of_orthogonality.value_or(0.) > 0.5);
+        expect(report.cholesky_qr_applied);
+        expect(loss_of_orthogonality(*monomials) < 1e-13);
+
+        // linearly dependent vectors
+        const auto dependent_array = create_random_test_array<double>(3, 50);
+        dependent_array->scal(0., Indices{2});
+        expect(throws<InvalidStateError>(
+            [&]()
+            {
+                cholesky_qr(*dependent_array);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return mixed_precision_gram_schmidt(*dependent_array, {.tolerance = -1.});
+            }));
+    };
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef NIAS_CPP_TEST_OPERATORS_COMMON_H
+#define NIAS_CPP_TEST_OPERATORS_COMMON_H
+
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/type_traits.h>
+
+/**
+ * \brief Tridiagonal <tt>n x n</tt> CsrMatrixOperator with <tt>n = diagonal.size()</tt>
+ *
+ * Row \c i contains \c lower (left of the diagonal), <tt>diagonal[i]</tt> and \c upper (right of the
+ * diagonal), each divided by <tt>row_divisors[i]</tt> if \c row_divisors is not empty. Zero off-diagonal
+ * entries are not stored, so bidiagonal matrices can be created as well.
+ */
+template <nias::floating_point_or_complex F>
+nias::CsrMatrixOperator<F> tridiagonal_operator(const std::vector<F>& diagonal, F lower, F upper,
+                                                const std::vector<double>& row_divisors = {})
+{
+    using namespace nias;
+    std::vector<ssize_t> row_offsets{0};
+    std::vector<ssize_t> column_indices;
+    std::vector<F> values;
+    const auto n = std::ssize(diagonal);
+    for (ssize_t i = 0; i < n; ++i)
+    {
+        const auto divisor = real_type_t<F>(row_divisors.empty() ? 1. : row_divisors[as_size_t(i)]);
+        for (const auto& [j, value] : {std::pair{i - 1, lower}, {i, diagonal[as_size_t(i)]}, {i + 1, upper}})
+        {
+            if (j >= 0 && j < n && (j == i || value != F(0)))
+            {
+                column_indices.push_back(j);
+                values.push_back(value / divisor);
+            }
+        }
+        row_offsets.push_back(std::ssize(values));
+    }
+    return CsrMatrixOperator<F>(n, n, row_offsets, column_indices, values);
+}
+
+/// Off-diagonal entry of the Hermitian test matrices, of modulus 1 and complex for complex F
+template <nias::floating_point_or_complex F>
+F off_diagonal()
+{
+    if constexpr (nias::complex<F>)
+    {
+        return F(-0.6, 0.8);
+    }
+    else
+    {
+        return F(-1);
+    }
+}
+
+#endif  // NIAS_CPP_TEST_OPERATORS_COMMON_H
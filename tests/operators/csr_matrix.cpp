@@ -0,0 +1,154 @@
+#include <complex>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/operators/identity.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/sparse.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "../vectorarray/common.h"
+
+namespace
+{
+// range_dim x source_dim matrix with a few entries per row (including an entry given twice)
+template <floating_point_or_complex F>
+CsrMatrixOperator<F> create_test_matrix(ssize_t range_dim, ssize_t source_dim, ssize_t num_threads)
+{
+    std::vector<ssize_t> row_offsets{0};
+    std::vector<ssize_t> column_indices;
+    std::vector<F> values;
+    for (ssize_t i = 0; i < range_dim; ++i)
+    {
+        for (ssize_t j = i % 5; j < source_dim; j += 97 + (i % 3))
+        {
+            column_indices.push_back(j);
+            values.push_back(test_entry<F>(i, j));
+        }
+        if (source_dim > 0)
+        {
+            column_indices.push_back(i % source_dim);
+            values.push_back(F(1));
+        }
+        row_offsets.push_back(std::ssize(values));
+    }
+    return CsrMatrixOperator<F>(range_dim, source_dim, row_offsets, column_indices, values, num_threads);
+}
+
+// product of the matrix (or its adjoint) with the vectors indices of vec_array, computed entry by entry
+template <floating_point_or_complex F>
+std::vector<std::vector<F>> reference_product(const CsrMatrixOperator<F>& op,
+                                              const VectorArrayInterface<F>& vec_array,
+                                              const std::vector<ssize_t>& indices, bool adjoint)
+{
+    std::vector<std::vector<F>> ret(
+        indices.size(), std::vector<F>(as_size_t(adjoint ? op.source_dim() : op.range_dim()), F(0)));
+    for (size_t v = 0; v < indices.size(); ++v)
+    {
+        for (ssize_t i = 0; i < op.range_dim(); ++i)
+        {
+            for (ssize_t k = op.row_offsets()[as_size_t(i)]; k < op.row_offsets()[as_size_t(i + 1)]; ++k)
+            {
+                const auto j = op.column_indices()[as_size_t(k)];
+                const F value = op.values()[as_size_t(k)];
+                if (adjoint)
+                {
+                    ret[v][as_size_t(j)] += conj_if_complex(value) * vec_array.get(indices[v], i);
+                }
+                else
+                {
+                    ret[v][as_size_t(i)] += value * vec_array.get(indices[v], j);
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+}  // namespace
+
+int main()
+{
+    "CsrMatrixOperator"_test = []<floating_point_or_complex F>()
+    {
+        // more than one row block and vector block
+        for (const auto& [range_dim, source_dim] : {std::pair<ssize_t, ssize_t>{1100, 700}, {3, 0}, {0, 4}})
+        {
+            for (const ssize_t num_threads : {1, 4})
+            {
+                const auto op = create_test_matrix<F>(range_dim, source_dim, num_threads);
+                expect(op.range_dim() == range_dim && op.source_dim() == source_dim);
+                for (const ssize_t size : {0, 1, 40})
+                {
+                    const auto source = create_test_array<F>(size, source_dim, 3);
+                    const auto range = create_test_array<F>(size, range_dim, 3);
+                    const auto all = index_vector(std::nullopt, size);
+                    expect(to_rows(*op.apply(*source)) == reference_product(op, *source, all, false));
+                    expect(to_rows(*op.apply_adjoint(*range)) == reference_product(op, *range, all, true));
+                    if (size > 0)
+                    {
+                        const std::vector<ssize_t> indices{size - 1, 0, size - 1};
+                        const auto expected = reference_product(op, *source, indices, false);
+                        expect(to_rows(*op.apply(*source, indices)) == expected);
+                        // arrays which are not stored contiguously are read by get
+                        const SparseVectorArray<F> sparse(*source);
+                        expect(to_rows(*op.apply(sparse, indices)) == expected);
+                        const auto apply2 = op.apply2(*range, *source, Indices{0}, indices);
+                        expect(apply2 == range->inner(*op.apply(*source, indices), Indices{0}));
+                    }
+                }
+            }
+        }
+    } | std::tuple<double, float, std::complex<double>>{};
+
+    "IdentityOperator"_test = []()
+    {
+        const auto array = create_test_array<double>(3, 5);
+        const IdentityOperator<double> op(5);
+        const auto image = op.apply(*array, Indices{2, 0});
+        expect(image->size() == 2 && image->get(0, 1) == array->get(2, 1));
+        expect(op.apply2(*array, *array) == array->inner(*array));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return IdentityOperator<double>(4).apply(*array);
+            }));
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return CsrMatrixOperator<double>(2, 2, {0, 1}, {0}, {1.});
+            }));
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return CsrMatrixOperator<double>(1, 2, {0, 1}, {2}, {1.});
+            }));
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return CsrMatrixOperator<double>(1, 2, {0, 0}, {}, {}, -1);
+            }));
+        const auto op = CsrMatrixOperator<double>(1, 2, {0, 1}, {1}, {1.});
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return op.apply(*create_test_array<double>(1, 1));
+            }));
+    };
+
+    return 0;
+}
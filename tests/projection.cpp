@@ -0,0 +1,112 @@
+#include <complex>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/projection.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/interfaces/operator.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/operators/csr_matrix.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "operators/common.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+constexpr ssize_t dim = 30;
+
+// bidiagonal matrix with diagonal entries diagonal and entries upper above the diagonal
+template <floating_point_or_complex F>
+std::shared_ptr<const OperatorInterface<F>> bidiagonal(F diagonal, F upper)
+{
+    return std::make_shared<CsrMatrixOperator<F>>(
+        tridiagonal_operator<F>(std::vector<F>(dim, diagonal), F(0), upper));
+}
+
+/// Entries of \c matrix as a vector of rows
+template <floating_point_or_complex F>
+std::vector<std::vector<F>> to_rows(const ReducedMatrix<F>& matrix)
+{
+    std::vector<std::vector<F>> ret;
+    for (ssize_t i = 0; i < matrix.rows(); ++i)
+    {
+        const auto* row = matrix.data() + (i * matrix.cols());
+        ret.emplace_back(row, row + matrix.cols());
+    }
+    return ret;
+}
+}  // namespace
+
+int main()
+{
+    "Operator projection"_test = []<floating_point_or_complex F>()
+    {
+        const std::vector operators{bidiagonal<F>(F(2), F(-1)), bidiagonal<F>(F(1), F(3))};
+        const auto basis = create_test_array<F>(10, dim);
+        const auto left_basis = create_test_array<F>(7, dim, 5);
+        for (const ssize_t num_threads : {1, 4})
+        {
+            const GalerkinProjector<F> projector(operators, basis,
+                                                 {.num_threads = num_threads, .block_size = 4});
+            expect(projector.num_operators() == 2);
+            const auto galerkin = projector.project();
+            const auto petrov_galerkin = projector.project(*left_basis);
+            expect(galerkin.size() == 2 && petrov_galerkin.size() == 2);
+            for (size_t k = 0; k < 2; ++k)
+            {
+                expect(approx_equal(to_rows(galerkin[k]), operators[k]->apply2(*basis, *basis)));
+                expect(approx_equal(to_rows(petrov_galerkin[k]),
+                                    operators[k]->apply2(*left_basis, *basis)));
+            }
+            const std::vector<std::shared_ptr<const VectorArrayInterface<F>>> rhs{
+                create_test_array<F>(1, dim, 2), create_test_array<F>(3, dim, 4)};
+            const auto projected_rhs = project_vectors(*basis, rhs, {.num_threads = num_threads});
+            for (size_t k = 0; k < 2; ++k)
+            {
+                expect(approx_equal(to_rows(projected_rhs[k]), basis->inner(*rhs[k])));
+            }
+        }
+    } | std::tuple<double, std::complex<double>>{};
+
+    "ReducedMatrix"_test = []()
+    {
+        ReducedMatrix<double> matrix(2, 3);
+        matrix(1, 2) = 5.;
+        expect(matrix.data()[5] == 5. && matrix.row(1)[2] == 5.);
+        const auto data = matrix.release();
+        expect(data.size() == 6 && data[5] == 5.);
+        expect(matrix.rows() == 0 && matrix.cols() == 0);
+        // empty bases result in empty matrices
+        const GalerkinProjector<double> projector({bidiagonal(2., -1.)}, create_test_array<double>(0, dim));
+        const auto projected = projector.project(*create_test_array<double>(2, dim));
+        expect(projected[0].rows() == 2 && projected[0].cols() == 0);
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        const auto op = bidiagonal(2., -1.);
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return GalerkinProjector<double>({op},
+                                                 std::make_shared<MappedNpyVectorArray<double>>(2, dim + 1));
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return GalerkinProjector<double>({op}, create_test_array<double>(2, dim), {.block_size = 0});
+            }));
+        const GalerkinProjector<double> projector({op}, create_test_array<double>(2, dim));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return projector.project(MappedNpyVectorArray<double>(2, dim + 1));
+            }));
+    };
+
+    return 0;
+}
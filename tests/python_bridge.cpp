@@ -0,0 +1,86 @@
+#include <chrono>
+
+#include <nias_cpp/python_bridge.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/pytypes.h>
+
+#include "boost_ext_ut_no_module.h"
+
+int main()
+{
+    using namespace boost::ut;
+    using namespace nias;
+    namespace py = pybind11;
+
+    "PythonBridge"_test = []()
+    {
+        auto& bridge = PythonBridge::instance();
+
+        test("instance returns the same bridge") = [&]()
+        {
+            expect(&bridge == &PythonBridge::instance());
+        };
+
+        test("NiAS objects are resolved") = [&]()
+        {
+            for (const auto* obj : {&bridge.nias_vector_array_impl(), &bridge.nias_vector_array(),
+                                    &bridge.nias_inner_product(), &bridge.nias_gram_schmidt()})
+            {
+                expect(static_cast<bool>(*obj));
+            }
+            expect(bridge.nias_gram_schmidt().is(
+                py::module_::import("nias.linalg.gram_schmidt").attr("gram_schmidt")));
+        };
+
+        test("modules and attributes are cached") = [&]()
+        {
+            const auto& sqrt = bridge.attribute("math", "sqrt");
+            expect(&sqrt == &bridge.attribute("math", "sqrt"));
+            expect(&bridge.module("math") == &bridge.module("math"));
+            expect(sqrt(4.).cast<double>() == 2.);
+        };
+
+        test("unknown modules and attributes throw") = [&]()
+        {
+            expect(throws<py::error_already_set>(
+                [&]()
+                {
+                    static_cast<void>(bridge.module("nias_cpp_this_module_does_not_exist"));
+                }));
+            expect(throws<py::error_already_set>(
+                [&]()
+                {
+                    static_cast<void>(bridge.attribute("math", "this_attribute_does_not_exist"));
+                }));
+        };
+
+        test("cached lookup is faster than importing") = [&]()
+        {
+            constexpr int num_lookups = 10000;
+            const auto time = [](const auto& func)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < num_lookups; ++i)
+                {
+                    func();
+                }
+                return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                           .count() /
+                       num_lookups;
+            };
+            const auto import_time = time(
+                []()
+                {
+                    static_cast<void>(py::module_::import("nias.linalg.gram_schmidt").attr("gram_schmidt"));
+                });
+            const auto cached_time = time(
+                [&]()
+                {
+                    static_cast<void>(bridge.attribute("nias.linalg.gram_schmidt", "gram_schmidt"));
+                });
+            expect(cached_time < import_time);
+        };
+    };
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/algorithms/gram_schmidt.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/python_executor.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "test_vector.h"
+
+int main()
+{
+    using namespace boost::ut;
+    using namespace nias;
+    namespace py = pybind11;
+
+    // create the executor on the main thread (which starts the interpreter)
+    auto& executor = PythonExecutor::instance();
+
+    "PythonExecutor"_test = [&]()
+    {
+        test("run returns the result of the task") = [&]()
+        {
+            const auto result = executor.run(
+                []()
+                {
+                    return py::module_::import("math").attr("sqrt")(16.).cast<double>();
+                });
+            expect(result == 4.);
+        };
+
+        test("exceptions are passed on to the caller") = [&]()
+        {
+            expect(throws<std::runtime_error>(
+                [&]()
+                {
+                    executor.run(
+                        []()
+                        {
+                            throw std::runtime_error("error in task");
+                        });
+                }));
+            expect(throws<py::error_already_set>(
+                [&]()
+                {
+                    executor.run(
+                        []()
+                        {
+                            return py::module_::import("math").attr("sqrt")(-1.);
+                        });
+                }));
+        };
+
+        test("nested tasks are executed directly") = [&]()
+        {
+            const auto result = executor.run(
+                [&]()
+                {
+                    expect(executor.on_worker_thread());
+                    return executor.run(
+                        []()
+                        {
+                            return 42;
+                        });
+                });
+            expect(result == 42);
+        };
+
+        test("tasks from multiple threads") = [&]()
+        {
+            constexpr ssize_t num_threads = 8;
+            constexpr ssize_t tasks_per_thread = 50;
+            const auto num_tasks_before = executor.num_tasks();
+            std::atomic<ssize_t> num_correct{0};
+            std::vector<std::thread> threads;
+            for (ssize_t t = 0; t < num_threads; ++t)
+            {
+                threads.emplace_back(
+                    [&, t]()
+                    {
+                        for (ssize_t i = 0; i < tasks_per_thread; ++i)
+                        {
+                            const auto value = double((t * tasks_per_thread) + i);
+                            const auto result = executor.run(
+                                [value]()
+                                {
+                                    const auto math = py::module_::import("math");
+                                    return math.attr("sqrt")(value * value).cast<double>();
+                                });
+                            if (result == value)
+                            {
+                                ++num_correct;
+                            }
+                        }
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            expect(num_correct == num_threads * tasks_per_thread);
+            expect(executor.num_tasks() - num_tasks_before == as_size_t(num_threads * tasks_per_thread));
+        };
+
+        test("Python-backed algorithms from multiple threads") = [&]()
+        {
+            constexpr ssize_t num_threads = 4;
+            std::vector<std::shared_ptr<ListVectorArray<double>>> results(as_size_t(num_threads));
+            std::vector<std::thread> threads;
+            for (ssize_t t = 0; t < num_threads; ++t)
+            {
+                threads.emplace_back(
+                    [&, t]()
+                    {
+                        ListVectorArray<double> vec_array(3);
+                        vec_array.append(std::make_shared<DynamicVector<double>>(
+                            std::initializer_list<double>{1., double(t), 0.}));
+                        vec_array.append(std::make_shared<DynamicVector<double>>(
+                            std::initializer_list<double>{2., 1., double(t)}));
+                        results[as_size_t(t)] = executor.run(
+                            [&]()
+                            {
+                                return gram_schmidt(vec_array);
+                            });
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            // without the executor, each thread acquires the GIL itself (the main thread released it when the
+            // executor was created)
+            threads.clear();
+            results.resize(as_size_t(2 * num_threads));
+            for (ssize_t t = 0; t < num_threads; ++t)
+            {
+                threads.emplace_back(
+                    [&, t]()
+                    {
+                        auto vec_array = std::make_shared<ListVectorArray<double>>(3);
+                        vec_array->append(std::make_shared<DynamicVector<double>>(
+                            std::initializer_list<double>{double(t), 1., 0.}));
+                        vec_array->append(std::make_shared<DynamicVector<double>>(
+                            std::initializer_list<double>{1., 2., double(t)}));
+                        gram_schmidt_in_place(*vec_array);
+                        results[as_size_t(num_threads + t)] = vec_array;
+                    });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            for (const auto& result : results)
+            {
+                expect(result->size() == 2);
+                for (ssize_t i = 0; i < result->size(); ++i)
+                {
+                    for (ssize_t j = 0; j < result->size(); ++j)
+                    {
+                        const auto expected = i == j ? 1. : 0.;
+                        const auto product = dot_product(result->vector(i), result->vector(j));
+                        expect(std::abs(product - expected) < 1e-12);
+                    }
+                }
+            }
+        };
+    };
+
+    return 0;
+}
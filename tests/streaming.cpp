@@ -0,0 +1,113 @@
+#include <complex>
+#include <concepts>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/gram_schmidt_cpp.h>
+#include <nias_cpp/algorithms/streaming.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "vectorarray/common.h"
+
+int main()
+{
+    "streaming_gram_matrix"_test = []<floating_point_or_complex F>()
+    {
+        const ssize_t dim = 5;
+        const auto array = create_random_test_array<F>(7, dim, {2, 5});
+        const auto expected = array->inner(*array);
+        const auto bytes_per_vector = dim * ssize_t(sizeof(F));
+        for (const bool prefetch : {false, true})
+        {
+            for (const ssize_t tile_size : {1, 2, 3, 7})
+            {
+                const StreamingOptions options{
+                    .memory_budget = 4 * tile_size * bytes_per_vector, .tile_size = 0, .prefetch = prefetch};
+                StreamingReport report;
+                const auto gram =
+                    streaming_gram_matrix<F>(*array, EuclideanInnerProduct<F>(), options, &report);
+                expect(gram == expected);
+                expect(report.tile_size == tile_size);
+                expect(report.peak_memory <= options.memory_budget);
+                expect(report.peak_memory >= tile_size * bytes_per_vector);
+                // each tile is loaded once as left tile and once as right tile for each left tile before it
+                const auto num_tiles = (7 + tile_size - 1) / tile_size;
+                expect(report.num_tile_loads == num_tiles + ((num_tiles * (num_tiles - 1)) / 2));
+            }
+        }
+    } | std::tuple<float, double, std::complex<float>, std::complex<double>>{};
+
+    "Invalid streaming options"_test = []()
+    {
+        const auto array = create_random_test_array<double>(7, 3, {2, 5});
+        const auto bytes_per_vector = 3 * ssize_t(sizeof(double));
+        const auto gram_matrix = [&](const StreamingOptions& options)
+        {
+            return streaming_gram_matrix<double>(*array, EuclideanInnerProduct<double>(), options);
+        };
+        // the budget does not even suffice for tiles containing a single vector
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return gram_matrix({.memory_budget = 10, .tile_size = 0, .prefetch = true});
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return gram_matrix({.memory_budget = 4 * bytes_per_vector, .tile_size = 2, .prefetch = true});
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return gram_matrix({.memory_budget = 1024, .tile_size = -1, .prefetch = true});
+            }));
+    };
+
+    "streaming_gram_schmidt"_test = []<std::floating_point F>()
+    {
+        const ssize_t dim = 6;
+        const auto tolerance = std::numeric_limits<F>::epsilon() * F(1000);
+        const auto reference = create_random_test_array<F>(8, dim, {2, 5});
+        gram_schmidt_cpp<F>(*reference);
+        for (const bool prefetch : {false, true})
+        {
+            for (const ssize_t tile_size : {1, 2, 3, 8})
+            {
+                const auto array = create_random_test_array<F>(8, dim, {2, 5});
+                const StreamingOptions options{.memory_budget = 4 * tile_size * dim * ssize_t(sizeof(F)),
+                                               .tile_size = tile_size,
+                                               .prefetch = prefetch};
+                StreamingReport report;
+                streaming_gram_schmidt<F>(*array, EuclideanInnerProduct<F>(), options, &report);
+                expect(report.peak_memory <= options.memory_budget);
+                // the two linearly dependent vectors have been removed
+                expect(array->size() == 6);
+                std::vector<std::vector<F>> identity(6, std::vector<F>(6, F(0)));
+                for (size_t i = 0; i < 6; ++i)
+                {
+                    identity[i][i] = F(1);
+                }
+                expect(approx_equal(array->inner(*array), identity, tolerance));
+                expect(approx_equal(array->inner(*array), reference->inner(*array), tolerance));
+            }
+        }
+
+        // the removal tolerance is relative, so the result does not depend on the scaling of the input
+        const auto scaled = create_random_test_array<F>(8, dim, {2, 5});
+        scaled->scal(F(1e-4));
+        const StreamingOptions options{.memory_budget = 1024, .tile_size = 3, .prefetch = true};
+        streaming_gram_schmidt<F>(*scaled, EuclideanInnerProduct<F>(), options);
+        expect(scaled->size() == 6);
+        expect(approx_equal(scaled->inner(*scaled), reference->inner(*reference), tolerance));
+    } | std::tuple<float, double>{};
+
+    return 0;
+}
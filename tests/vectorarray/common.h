@@ -2,7 +2,10 @@
 #define NIAS_CPP_TEST_VECTORARRAY_COMMON_H
 
 #include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <format>
 #include <memory>
 #include <ostream>
@@ -19,6 +22,7 @@
 #include <nias_cpp/interfaces/vectorarray.h>
 #include <nias_cpp/type_traits.h>
 #include <nias_cpp/vectorarray/list.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
 #include <nias_cpp/vectorarray/numpy.h>
 #include <pybind11/numpy.h>
 
@@ -243,7 +247,24 @@ struct TestVectorArrayFactory<NumpyVectorArray<F>>
         {
             for (ssize_t j = 0; j < dim; ++j)
             {
-                array->set(i, j, start + (i * dim) + j);
+                array->set(i, j, start + F((i * dim) + j));
+            }
+        }
+        return array;
+    }
+};
+
+template <floating_point_or_complex F>
+struct TestVectorArrayFactory<MappedNpyVectorArray<F>>
+{
+    static std::shared_ptr<VectorArrayInterface<F>> iota(ssize_t size, ssize_t dim, F start = F(1))
+    {
+        auto array = std::make_shared<MappedNpyVectorArray<F>>(size, dim);
+        for (ssize_t i = 0; i < size; ++i)
+        {
+            for (ssize_t j = 0; j < dim; ++j)
+            {
+                array->set(i, j, start + F((i * dim) + j));
             }
         }
         return array;
@@ -256,12 +277,171 @@ struct TestVectorArrayFactory<pybind11::array_t<F>>
     static std::shared_ptr<pybind11::array_t<F>> iota(ssize_t size, ssize_t dim, F start = F(1))
     {
         auto array = std::make_shared<pybind11::array_t<F>>(std::vector{size, dim});
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        std::iota(array->mutable_data(), array->mutable_data() + (size * dim), start);
+        for (ssize_t i = 0; i < size; ++i)
+        {
+            for (ssize_t j = 0; j < dim; ++j)
+            {
+                array->mutable_at(i, j) = start + F((i * dim) + j);
+            }
+        }
         return array;
     }
 };
 
+/**
+ * \brief Entry <tt>(i, j)</tt> of the arrays created by create_test_array
+ *
+ * The entries are small integers divided by 4 (with an imaginary part of the same kind for complex F), so sums
+ * and products of a few entries are computed exactly in all floating point types.
+ */
+template <floating_point_or_complex F>
+F test_entry(ssize_t i, ssize_t j)
+{
+    using R = real_type_t<F>;
+    F ret(R((((i * 7) + (j * 3)) % 33) - 16) / R(4));
+    if constexpr (complex<F>)
+    {
+        ret += F(R(0), R((((i * 5) + (j * 11)) % 29) - 14) / R(4));
+    }
+    return ret;
+}
+
+/// Sets the entries of \c vec_array to <tt>test_entry(i + offset, j)</tt>
+template <floating_point_or_complex F>
+void fill_test_array(VectorArrayInterface<F>& vec_array, ssize_t offset = 0)
+{
+    for (ssize_t i = 0; i < vec_array.size(); ++i)
+    {
+        for (ssize_t j = 0; j < vec_array.dim(); ++j)
+        {
+            vec_array.set(i, j, test_entry<F>(i + offset, j));
+        }
+    }
+}
+
+/// \c size x \c dim MappedNpyVectorArray with the entries <tt>test_entry(i + offset, j)</tt>
+template <floating_point_or_complex F>
+std::shared_ptr<MappedNpyVectorArray<F>> create_test_array(ssize_t size, ssize_t dim, ssize_t offset = 0)
+{
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(size, dim);
+    fill_test_array(*ret, offset);
+    return ret;
+}
+
+/**
+ * \brief \c size x \c dim MappedNpyVectorArray with reproducible pseudo-random (real) entries in
+ * <tt>[-0.5, 0.5)</tt>
+ *
+ * The vectors with the given indices are replaced by <tt>v_0 - 2 v_1</tt>, so that they are linearly
+ * dependent on the first two vectors.
+ */
+template <floating_point_or_complex F>
+std::shared_ptr<MappedNpyVectorArray<F>> create_random_test_array(
+    ssize_t size, ssize_t dim, const std::vector<ssize_t>& dependent_indices = {})
+{
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(size, dim);
+    // simple linear congruential generator, so the tests are reproducible
+    std::uint32_t state = 42;
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            state = (state * 1103515245U) + 12345U;
+            ret->set(i, j, F((double(state >> 8U) / double(1U << 24U)) - 0.5));
+        }
+    }
+    for (const auto i : dependent_indices)
+    {
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            ret->set(i, j, ret->get(0, j) - (F(2) * ret->get(1, j)));
+        }
+    }
+    return ret;
+}
+
+/// Entries of \c vec_array as a vector of rows (one row per vector)
+template <floating_point_or_complex F>
+std::vector<std::vector<F>> to_rows(const VectorArrayInterface<F>& vec_array)
+{
+    std::vector<std::vector<F>> ret(as_size_t(vec_array.size()), std::vector<F>(as_size_t(vec_array.dim())));
+    for (ssize_t i = 0; i < vec_array.size(); ++i)
+    {
+        for (ssize_t j = 0; j < vec_array.dim(); ++j)
+        {
+            ret[as_size_t(i)][as_size_t(j)] = vec_array.get(i, j);
+        }
+    }
+    return ret;
+}
+
+// Comparison operator for small dense matrices (given as vectors of rows)
+template <floating_point_or_complex F>
+struct ApproxEqualOpMatrix
+{
+    ApproxEqualOpMatrix(const std::vector<std::vector<F>>& lhs, const std::vector<std::vector<F>>& rhs,
+                        double tolerance)
+        : lhs_(lhs)
+        , rhs_(rhs)
+        , tolerance_(tolerance)
+    {
+    }
+
+    [[nodiscard]] explicit operator bool() const
+    {
+        if (lhs_.size() != rhs_.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < lhs_.size(); ++i)
+        {
+            if (lhs_[i].size() != rhs_[i].size())
+            {
+                return false;
+            }
+            for (size_t j = 0; j < lhs_[i].size(); ++j)
+            {
+                if (!(std::abs(lhs_[i][j] - rhs_[i][j]) <= tolerance_ * (1 + std::abs(rhs_[i][j]))))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ApproxEqualOpMatrix& eq)
+    {
+        const auto print = [&os](const std::vector<std::vector<F>>& matrix)
+        {
+            for (const auto& row : matrix)
+            {
+                os << "\n";
+                for (const auto& entry : row)
+                {
+                    os << entry << " ";
+                }
+            }
+        };
+        print(eq.lhs_);
+        os << "\n==";
+        print(eq.rhs_);
+        return os;
+    }
+
+    const std::vector<std::vector<F>>& lhs_;
+    const std::vector<std::vector<F>>& rhs_;
+    double tolerance_;
+};
+
+/// Entry-wise comparison with the relative (for entries larger than 1) tolerance \c tolerance
+template <floating_point_or_complex F>
+auto approx_equal(const std::vector<std::vector<F>>& lhs, const std::vector<std::vector<F>>& rhs,
+                  double tolerance = 1e-12)
+{
+    return ApproxEqualOpMatrix<F>(lhs, rhs, tolerance);
+}
+
 template <class F>
 auto create_test_alphas(ssize_t size)
 {
@@ -881,5 +1061,205 @@ void check_axpy(const VectorArrayInterface<typename VectorArray::ScalarType>& v,
     };
 }
 
+template <floating_point_or_complex F>
+F reference_inner(const VectorArrayInterface<F>& v, ssize_t i, const VectorArrayInterface<F>& w, ssize_t j)
+{
+    F ret(0);
+    for (ssize_t k = 0; k < v.dim(); ++k)
+    {
+        if constexpr (complex<F>)
+        {
+            ret += std::conj(v.get(i, k)) * w.get(j, k);
+        }
+        else
+        {
+            ret += v.get(i, k) * w.get(j, k);
+        }
+    }
+    return ret;
+}
+
+template <floating_point_or_complex F>
+void check_bulk_operations(const VectorArrayInterface<F>& v, ssize_t size, ssize_t dim)
+{
+    using namespace boost::ut::bdd;
+    using R = real_type_t<F>;
+
+    given("A vectorarray v of size size and dimension dim") = [&]()
+    {
+        when("Calling v.inner(v) and v.pairwise_inner(v)") = [&]()
+        {
+            const auto gram = v.inner(v);
+            const auto pairwise = v.pairwise_inner(v);
+            then("the results equal the entry-wise computed inner products") = [&]()
+            {
+                expect(fatal(std::ssize(gram) == size && std::ssize(pairwise) == size));
+                for (ssize_t i = 0; i < size; ++i)
+                {
+                    expect(fatal(std::ssize(gram[as_size_t(i)]) == size));
+                    for (ssize_t j = 0; j < size; ++j)
+                    {
+                        expect(approx_equal(gram[as_size_t(i)][as_size_t(j)], reference_inner(v, i, v, j)));
+                    }
+                    expect(approx_equal(pairwise[as_size_t(i)], reference_inner(v, i, v, i)));
+                }
+            };
+        };
+
+        given("Multiple indices") = [&](const std::vector<ssize_t>& index_vec)
+        {
+            const auto indices = Indices(index_vec);
+            if (contains_invalid_index(index_vec, size))
+            {
+                then("inner, pairwise_inner and norm2 throw") = [&]()
+                {
+                    expect(throws<InvalidIndexError>(
+                        [&]()
+                        {
+                            static_cast<void>(v.inner(v, indices));
+                        }));
+                    expect(throws<InvalidIndexError>(
+                        [&]()
+                        {
+                            static_cast<void>(v.pairwise_inner(v, indices, indices));
+                        }));
+                    expect(throws<InvalidIndexError>(
+                        [&]()
+                        {
+                            static_cast<void>(v.norm2(indices));
+                        }));
+                };
+                return;
+            }
+            when("Calling v.inner(v, indices, indices)") = [&]()
+            {
+                const auto gram = v.inner(v, indices, indices);
+                const auto gram_of_view = v[indices].inner(v[indices]);
+                then("the result is the submatrix of the Gram matrix (also if computed on views)") = [&]()
+                {
+                    expect(fatal(gram.size() == index_vec.size() && gram_of_view.size() == index_vec.size()));
+                    for (size_t i = 0; i < index_vec.size(); ++i)
+                    {
+                        const auto vi = index_vec[i] < 0 ? index_vec[i] + size : index_vec[i];
+                        for (size_t j = 0; j < index_vec.size(); ++j)
+                        {
+                            const auto vj = index_vec[j] < 0 ? index_vec[j] + size : index_vec[j];
+                            expect(approx_equal(gram[i][j], reference_inner(v, vi, v, vj)));
+                            expect(approx_equal(gram_of_view[i][j], reference_inner(v, vi, v, vj)));
+                        }
+                    }
+                };
+            };
+
+            when("Calling v.norm(indices) and v.norm2(indices)") = [&]()
+            {
+                const auto norms = v.norm(indices);
+                const auto norms2 = v.norm2(indices);
+                then("the results match the inner products") = [&]()
+                {
+                    expect(fatal(norms.size() == index_vec.size() && norms2.size() == index_vec.size()));
+                    for (size_t i = 0; i < index_vec.size(); ++i)
+                    {
+                        const auto vi = index_vec[i] < 0 ? index_vec[i] + size : index_vec[i];
+                        expect(approx_equal(norms2[i], R(std::real(reference_inner(v, vi, v, vi)))));
+                        expect(approx_equal(norms[i] * norms[i], norms2[i]));
+                    }
+                };
+            };
+
+            if (dim > 0)
+            {
+                when("Calling v.amax(indices)") = [&]()
+                {
+                    const auto [max_indices, max_values] = v.amax(indices);
+                    then("the largest absolute values are found") = [&]()
+                    {
+                        expect(fatal(max_indices.size() == index_vec.size()));
+                        for (size_t i = 0; i < index_vec.size(); ++i)
+                        {
+                            const auto vi = index_vec[i] < 0 ? index_vec[i] + size : index_vec[i];
+                            expect(exactly_equal(max_values[i], R(std::abs(v.get(vi, max_indices[i])))));
+                            for (ssize_t k = 0; k < dim; ++k)
+                            {
+                                expect(R(std::abs(v.get(vi, k))) <= max_values[i]);
+                            }
+                        }
+                    };
+                };
+            }
+        } | create_test_index_vectors(size);
+
+        when("Calling v.lincomb(coefficients)") = [&]()
+        {
+            if (size == 0)
+            {
+                then("an exception is thrown for non-empty coefficients") = [&]()
+                {
+                    expect(throws<NotImplementedError>(
+                        [&]()
+                        {
+                            static_cast<void>(v.lincomb({std::vector<F>{}}));
+                        }));
+                };
+                return;
+            }
+            std::vector<std::vector<F>> coefficients(3, std::vector<F>(as_size_t(size)));
+            for (size_t i = 0; i < coefficients.size(); ++i)
+            {
+                for (ssize_t k = 0; k < size; ++k)
+                {
+                    coefficients[i][as_size_t(k)] = F(R(i) - R(k));
+                }
+            }
+            const auto result = v.lincomb(coefficients);
+            then("the result contains the linear combinations") = [&]()
+            {
+                expect(fatal(result->size() == 3 && result->dim() == dim));
+                for (ssize_t i = 0; i < 3; ++i)
+                {
+                    for (ssize_t j = 0; j < dim; ++j)
+                    {
+                        F expected(0);
+                        for (ssize_t k = 0; k < size; ++k)
+                        {
+                            expected += coefficients[as_size_t(i)][as_size_t(k)] * v.get(k, j);
+                        }
+                        expect(approx_equal(result->get(i, j), expected));
+                    }
+                }
+            };
+            then("coefficients of the wrong size are rejected") = [&]()
+            {
+                expect(throws<InvalidArgumentError>(
+                    [&]()
+                    {
+                        static_cast<void>(v.lincomb({std::vector<F>(as_size_t(size) + 1)}));
+                    }));
+            };
+        };
+
+        when("Calling v.dofs(dof_indices)") = [&]()
+        {
+            std::vector<ssize_t> dof_indices(as_size_t(dim));
+            for (ssize_t j = 0; j < dim; ++j)
+            {
+                dof_indices[as_size_t(j)] = dim - 1 - j;
+            }
+            const auto dofs = v.dofs(dof_indices);
+            then("the selected entries are returned") = [&]()
+            {
+                expect(fatal(std::ssize(dofs) == size));
+                for (ssize_t i = 0; i < size; ++i)
+                {
+                    for (ssize_t j = 0; j < dim; ++j)
+                    {
+                        expect(exactly_equal(dofs[as_size_t(i)][as_size_t(j)], v.get(i, dim - 1 - j)));
+                    }
+                }
+            };
+        };
+    };
+}
+
 
 #endif  // NIAS_CPP_TEST_VECTORARRAY_COMMON_H
@@ -1,4 +1,5 @@
 #include <concepts>
+#include <limits>
 #include <tuple>
 
 #include <nias_cpp/checked_integer_cast.h>
@@ -135,6 +136,11 @@ int main()
                         check_axpy<VecArray>(*v, size, dim);
                     };
 
+                    scenario("bulk operations") = [&]()
+                    {
+                        check_bulk_operations(*v, size, dim);
+                    };
+
                     scenario("random vector access") = [&]()
                     {
                         check_random_vector_access(*v);
@@ -142,6 +148,17 @@ int main()
                 };
             }
         }
+
+        test("lincomb skips zero coefficients") = []()
+        {
+            const auto v = VecArrayFactory::iota(3, 4);
+            v->set(1, 2, std::numeric_limits<F>::quiet_NaN());
+            const auto result = v->lincomb({{F(1), F(0), F(2)}});
+            for (ssize_t j = 0; j < 4; ++j)
+            {
+                expect(result->get(0, j) == v->get(0, j) + (F(2) * v->get(2, j)));
+            }
+        };
     } | std::tuple<float, double>{};
 
     return 0;
@@ -0,0 +1,304 @@
+#include <complex>
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/io/mapped_file.h>
+#include <nias_cpp/io/npy.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "common.h"
+
+namespace
+{
+std::filesystem::path temporary_file(const std::string& name)
+{
+    return std::filesystem::temp_directory_path() / std::format("nias_cpp_test_mapped_npy_{}.npy", name);
+}
+}  // namespace
+
+int main()
+{
+    using namespace nias;
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+
+    "MappedNpyVectorArray"_test = []<floating_point_or_complex F>()
+    {
+        using VecArray = MappedNpyVectorArray<F>;
+        using VecArrayFactory = TestVectorArrayFactory<VecArray>;
+
+        for (ssize_t size : {0, 1, 3, 4})
+        {
+            for (ssize_t dim : {0, 1, 3, 4})
+            {
+                test(std::format("MappedNpyVectorArray<{}> of size {} and dim {}", reflection::type_name<F>(),
+                                 size, dim)) = [size, dim]()
+                {
+                    const auto v = VecArrayFactory::iota(size, dim);
+                    scenario("Copying") = [&]()
+                    {
+                        check_copy(*v, size, dim);
+                    };
+
+                    scenario("append") = [&]()
+                    {
+                        check_append<VecArray>(*v, size, dim);
+                    };
+
+                    scenario("scal") = [&]()
+                    {
+                        check_scal(*v, size, dim);
+                    };
+
+                    scenario("axpy") = [&]()
+                    {
+                        check_axpy<VecArray>(*v, size, dim);
+                    };
+
+                    scenario("bulk operations") = [&]()
+                    {
+                        check_bulk_operations(*v, size, dim);
+                    };
+                };
+            }
+        }
+
+        test("Bulk operations with small blocks") = []()
+        {
+            // blocks of a single vector, so the blocked code paths are exercised
+            const auto v = VecArrayFactory::iota(5, 3);
+            auto& v_mapped = dynamic_cast<VecArray&>(*v);
+            const auto w = VecArrayFactory::iota(5, 3);
+            v_mapped.set_block_size(1);
+            expect(exactly_equal(*v, *w));
+            expect(v->inner(*v) == w->inner(*w));
+            expect(v->norm2() == w->norm2());
+            expect(v->lincomb({{F(1), F(0), F(2), F(0), F(-1)}})->get(0, 1) ==
+                   w->get(0, 1) + (F(2) * w->get(2, 1)) - w->get(4, 1));
+        };
+
+        test("Files are created, written and reopened") = []()
+        {
+            const auto path = temporary_file(std::format("create_{}", npy_descr<F>().substr(1)));
+            {
+                const auto v = VecArray::create(path, 3, 2);
+                expect(v->writable());
+                expect(v->path() == path);
+                for (ssize_t i = 0; i < 3; ++i)
+                {
+                    for (ssize_t j = 0; j < 2; ++j)
+                    {
+                        v->set(i, j, F((i * 2) + j));
+                    }
+                }
+                v->flush();
+            }
+            const VecArray v(path);
+            expect(!v.writable());
+            expect(v.size() == 3);
+            expect(v.dim() == 2);
+            expect(!v.fortran_order());
+            for (ssize_t i = 0; i < 3; ++i)
+            {
+                for (ssize_t j = 0; j < 2; ++j)
+                {
+                    expect(v.get(i, j) == F((i * 2) + j));
+                }
+            }
+
+            then("The file is a valid .npy file") = [&]()
+            {
+                const MappedFile file(path, MappedFileMode::read_only);
+                const auto header = parse_npy_header(std::string_view(file.data(), as_size_t(file.size())));
+                expect(header.descr == npy_descr<F>());
+                expect(header.shape == std::vector<ssize_t>{3, 2});
+                expect(header.header_size % 64 == 0);
+                expect(file.size() == header.header_size + (6 * ssize_t(sizeof(F))));
+            };
+            std::filesystem::remove(path);
+        };
+
+        test("Read-only arrays cannot be modified") = []()
+        {
+            const auto path = temporary_file(std::format("read_only_{}", npy_descr<F>().substr(1)));
+            static_cast<void>(VecArray::create(path, 2, 2));
+            VecArray v(path);
+            expect(throws<InvalidStateError>(
+                [&]()
+                {
+                    v.set(0, 0, F(1));
+                }));
+            expect(throws<InvalidStateError>(
+                [&]()
+                {
+                    v.scal(F(2));
+                }));
+            expect(throws<InvalidStateError>(
+                [&]()
+                {
+                    v.delete_vectors(Indices{0});
+                }));
+            expect(v.size() == 2);
+            std::filesystem::remove(path);
+        };
+
+        test("Files grow and shrink with the array") = []()
+        {
+            const auto path = temporary_file(std::format("append_{}", npy_descr<F>().substr(1)));
+            const auto v = VecArray::create(path, 0, 3);
+            const auto w = VecArrayFactory::iota(4, 3);
+            const auto initial_file_size = std::filesystem::file_size(path);
+            v->append(*w);
+            v->append(*w, false, Indices{1, 3});
+            expect(v->size() == 6);
+            // the second append reserves room for further vectors
+            expect(std::filesystem::file_size(path) == initial_file_size + (24 * sizeof(F)));
+            expect(exactly_equal(*v->copy(Indices{0, 1, 2, 3}), *w));
+            expect(exactly_equal(*v->copy(Indices{4, 5}), *w->copy(Indices{1, 3})));
+            v->delete_vectors(Indices{0, 2, 4});
+            expect(v->size() == 3);
+            expect(std::filesystem::file_size(path) == initial_file_size + (9 * sizeof(F)));
+            expect(exactly_equal(*v, *w->copy(Indices{1, 3, 3})));
+            // appending vectors one at a time grows the file geometrically, flush removes the reserved room
+            for (ssize_t i = 0; i < 20; ++i)
+            {
+                v->append(*w, false, Indices{i % 4});
+            }
+            expect(v->size() == 23);
+            expect(std::filesystem::file_size(path) == initial_file_size + (72 * sizeof(F)));
+            expect(exactly_equal(VecArray(path), *v));
+            v->flush();
+            expect(std::filesystem::file_size(path) == initial_file_size + (69 * sizeof(F)));
+            expect(exactly_equal(VecArray(path), *v));
+            std::filesystem::remove(path);
+        };
+
+        test("Files in Fortran order are supported") = []()
+        {
+            const auto path = temporary_file(std::format("fortran_{}", npy_descr<F>().substr(1)));
+            const auto v = VecArray::create(path, 2, 3, true);
+            const auto w = VecArrayFactory::iota(4, 3);
+            expect(v->fortran_order());
+            v->append(*w);
+            for (ssize_t j = 0; j < 3; ++j)
+            {
+                v->set(0, j, F(j));
+            }
+            // entry j of vector i is stored at position j * size + i
+            expect(v->data()[(2 * 6) + 0] == F(2));
+            expect(v->data()[(1 * 6) + 3] == w->get(1, 1));
+            v->delete_vectors(Indices{0, 1, 3});
+            expect(v->size() == 3);
+            expect(exactly_equal(*v, *w->copy(Indices{0, 2, 3})));
+            expect(v->norm2() == w->norm2(Indices{0, 2, 3}));
+            v->flush();
+            const VecArray v_reopened(path);
+            expect(v_reopened.fortran_order());
+            expect(exactly_equal(v_reopened, *v));
+            std::filesystem::remove(path);
+        };
+
+        test("Opening files with a different scalar type fails") = []()
+        {
+            const auto path = temporary_file(std::format("scalar_type_{}", npy_descr<F>().substr(1)));
+            using OtherF = std::conditional_t<std::same_as<F, double>, float, double>;
+            static_cast<void>(MappedNpyVectorArray<OtherF>::create(path, 2, 2));
+            expect(throws<InvalidArgumentError>(
+                [&]()
+                {
+                    return VecArray(path);
+                }));
+            std::filesystem::remove(path);
+        };
+
+        test("Opening files with an invalid shape fails") = []()
+        {
+            const auto path = temporary_file(std::format("invalid_shape_{}", npy_descr<F>().substr(1)));
+            const auto open_with_header = [&](const std::string& header)
+            {
+                std::ofstream(path, std::ios::binary) << header << std::string(64, '\0');
+                return VecArray(path);
+            };
+            // the data size overflows
+            const auto header = format_npy_header({.descr = npy_descr<F>(), .shape = {ssize_t(1) << 61, 4}});
+            expect(throws<InvalidArgumentError>(
+                [&]()
+                {
+                    return open_with_header(header);
+                }));
+            // a shape entry overflows (padding spaces are removed, so the header size does not change)
+            auto overflowing_header = format_npy_header({.descr = npy_descr<F>(), .shape = {1, 4}});
+            const auto shape = "(" + std::string(21, '9') + ", 4)";
+            overflowing_header.replace(overflowing_header.find("(1, 4)"), 6, shape);
+            overflowing_header.erase(overflowing_header.find('}') + 1, shape.size() - 6);
+            expect(throws<InvalidArgumentError>(
+                [&]()
+                {
+                    return open_with_header(overflowing_header);
+                }));
+            std::filesystem::remove(path);
+        };
+
+        test("Arrays in shared memory can be attached to") = []()
+        {
+            const auto name = std::format("/nias_cpp_test_mapped_npy_{}", npy_descr<F>().substr(1));
+            const auto v = VecArray::create_shared_memory(name, 4, 3);
+            expect(v->shared_memory_name() == name);
+            expect(v->path().empty());
+            const auto w = VecArrayFactory::iota(4, 3);
+            v->axpy(F(1), *w);
+            // the attached array sees the same memory (this works the same way in another process)
+            const auto attached = VecArray::open_shared_memory(name);
+            expect(exactly_equal(*attached, *w));
+            attached->scal(F(2));
+            expect(exactly_equal(*v, *attached));
+            const auto read_only = VecArray::open_shared_memory(name, MappedFileMode::read_only);
+            expect(throws<InvalidStateError>(
+                [&]()
+                {
+                    read_only->set(0, 0, F(1));
+                }));
+            // the shared memory object is removed if the array cannot be created
+            const auto invalid_name = name + "_invalid";
+            expect(throws<InvalidArgumentError>(
+                [&]()
+                {
+                    return VecArray::create_shared_memory(invalid_name, -1, 3);
+                }));
+            expect(throws<IOError>(
+                [&]()
+                {
+                    return VecArray::open_shared_memory(invalid_name);
+                }));
+            // names are unique
+            expect(throws<IOError>(
+                [&]()
+                {
+                    return VecArray::create_shared_memory(name, 1, 1);
+                }));
+            MappedFile::unlink_shared_memory(name);
+            // existing mappings stay valid, but the name can no longer be used
+            expect(exactly_equal(*v, *attached));
+            expect(throws<IOError>(
+                [&]()
+                {
+                    return VecArray::open_shared_memory(name);
+                }));
+        };
+    } | std::tuple<float, double, std::complex<float>, std::complex<double>>{};
+
+    return 0;
+}
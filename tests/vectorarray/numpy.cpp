@@ -73,7 +73,7 @@ int main()
     using namespace boost::ut::bdd;
     ensure_interpreter_and_venv_are_active();
 
-    "NumpyVectorArray"_test = []<std::floating_point F>()
+    "NumpyVectorArray"_test = []<floating_point_or_complex F>()
     {
         using VecArray = NumpyVectorArray<F>;
         using VecArrayFactory = TestVectorArrayFactory<VecArray>;
@@ -127,6 +127,10 @@ int main()
                     {
                         check_axpy<VecArray>(*v, size, dim);
                     };
+                    scenario("bulk operations") = [&]()
+                    {
+                        check_bulk_operations(*v, size, dim);
+                    };
                     scenario("random vector access") = [&]()
                     {
                         check_random_vector_access(*v);
@@ -134,7 +138,7 @@ int main()
                 };
             }
         }
-    } | std::tuple<float, double>{};
+    } | std::tuple<float, double, std::complex<float>, std::complex<double>>{};
 
     return 0;
 }
@@ -0,0 +1,109 @@
+#include <complex>
+#include <concepts>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/planar_complex.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "common.h"
+
+int main()
+{
+    "PlanarComplexVectorArray"_test = []<std::floating_point R>()
+    {
+        using F = std::complex<R>;
+        using VecArray = PlanarComplexVectorArray<R>;
+        // dimensions which are not a multiple of the SIMD width and do not fit into a single block
+        for (const ssize_t dim : {0, 1, 13, 1500})
+        {
+            const auto reference = create_test_array<F>(5, dim);
+            VecArray v(*reference);
+            expect(v.size() == 5 && v.dim() == dim);
+            expect(exactly_equal(v, *reference));
+            expect(exactly_equal(VecArray(reference->data(), 5, dim), *reference));
+            // arrays in Fortran order are converted using get
+            const auto path = std::filesystem::temp_directory_path() /
+                              std::format("nias_cpp_test_planar_complex_{}.npy", sizeof(R));
+            const auto fortran_array = MappedNpyVectorArray<F>::create(path, 5, dim, true);
+            fill_test_array(*fortran_array);
+            expect(exactly_equal(VecArray(*fortran_array), *reference));
+            std::filesystem::remove(path);
+            std::vector<F> interleaved(as_size_t(5 * dim));
+            v.to_interleaved(interleaved.data());
+            expect(exactly_equal(VecArray(interleaved.data(), 5, dim), *reference));
+            expect(exactly_equal(*v.copy(Indices{3, 1}), *reference->copy(Indices{3, 1})));
+
+            expect(v.inner(v) == reference->inner(*reference));
+            expect(v.inner(v, Indices{4, 0}, Indices{1}) ==
+                   reference->inner(*reference, Indices{4, 0}, Indices{1}));
+            expect(EuclideanInnerProduct<F>().apply(v, v) == reference->inner(*reference));
+            expect(v.pairwise_inner(v, Indices{0, 1}, Indices{2, 3}) ==
+                   reference->pairwise_inner(*reference, Indices{0, 1}, Indices{2, 3}));
+            expect(v.norm2() == reference->norm2());
+            expect(dot_product<F>(v, v) == reference->pairwise_inner(*reference));
+            // arrays of other types are supported, too
+            expect(v.inner(*reference) == reference->inner(*reference));
+            if (dim > 0)
+            {
+                expect(v.amax() == reference->amax());
+            }
+            const std::vector<std::vector<F>> coefficients{{F(1), F(-1, 2), F(0), F(2), F(0)},
+                                                           {F(0), F(0), F(0, 1), F(0), F(0)}};
+            expect(exactly_equal(*v.lincomb(coefficients), *reference->lincomb(coefficients)));
+
+            v.scal(F(2, -1), Indices{1});
+            reference->scal(F(2, -1), Indices{1});
+            v.axpy(F(0.5, 0.25), v, Indices{0, 2}, Indices{3, 4});
+            reference->axpy(F(0.5, 0.25), *reference, Indices{0, 2}, Indices{3, 4});
+            expect(exactly_equal(v, *reference));
+            v.axpy(F(-1), *reference, Indices{3}, Indices{4});
+            reference->axpy(F(-1), *reference, Indices{3}, Indices{4});
+            expect(exactly_equal(v, *reference));
+
+            v.append(v, false, Indices{0});
+            v.append(*reference, false, Indices{4});
+            reference->append(*reference, false, Indices{0, 4});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(Indices{0, 5, 2});
+            reference->delete_vectors(Indices{0, 5, 2});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(std::nullopt);
+            expect(v.size() == 0);
+        }
+    } | std::tuple<float, double, long double>{};
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return PlanarComplexVectorArray<double>(-1, 2);
+            }));
+        PlanarComplexVectorArray<double> v(2, 3);
+        expect(throws<InvalidIndexError>(
+            [&]()
+            {
+                return v.get(0, 3);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return v.inner(PlanarComplexVectorArray<double>(2, 4));
+            }));
+    };
+
+    return 0;
+}
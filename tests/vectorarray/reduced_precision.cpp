@@ -0,0 +1,201 @@
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/reduced_precision.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/reduced_precision.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "common.h"
+
+namespace
+{
+using namespace nias;
+
+template <class S>
+void check_all_bit_patterns()
+{
+    using namespace boost::ut;
+
+    // every 16-bit number is converted to float and back without changes (NaNs stay NaNs)
+    bool all_equal = true;
+    for (std::uint32_t bits = 0; bits <= 0xffffU; ++bits)
+    {
+        const S value{static_cast<std::uint16_t>(bits)};
+        const float wide = widen(value);
+        if (std::isnan(wide))
+        {
+            all_equal = all_equal && std::isnan(widen(narrow<S>(wide)));
+        }
+        else
+        {
+            all_equal = all_equal && narrow<S>(wide) == value;
+        }
+    }
+    expect(all_equal);
+}
+}  // namespace
+
+int main()
+{
+    using namespace boost::ut;
+    using namespace nias;
+
+    "Conversion to and from float16 and bfloat16"_test = []()
+    {
+        check_all_bit_patterns<float16>();
+        check_all_bit_patterns<bfloat16>();
+
+        // rounding to nearest even
+        const auto epsilon = std::ldexp(1.F, -10);
+        expect(widen(narrow<float16>(1.F + (epsilon / 2))) == 1.F);
+        expect(widen(narrow<float16>(1.F + (epsilon * 3 / 2))) == 1.F + (2 * epsilon));
+        expect(widen(narrow<float16>(1.F + (epsilon * 3 / 4))) == 1.F + epsilon);
+        expect(widen(narrow<bfloat16>(1.F + std::ldexp(1.F, -8))) == 1.F);
+        expect(widen(narrow<bfloat16>(1.F + std::ldexp(3.F, -8))) == 1.F + std::ldexp(1.F, -6));
+        // doubles are rounded only once (rounding to float first would give a tie which is rounded down)
+        const auto tiny = std::ldexp(1., -40);
+        expect(widen(narrow<float16>(1. + std::ldexp(1., -11) + tiny)) == 1.F + epsilon);
+        expect(widen(narrow<float16>(-1. - std::ldexp(1., -11) - tiny)) == -1.F - epsilon);
+        expect(widen(narrow<float16>(1. + std::ldexp(1., -11))) == 1.F);
+        expect(widen(narrow<bfloat16>(1. + std::ldexp(1., -8) + tiny)) == 1.F + std::ldexp(1.F, -7));
+        expect(std::isinf(widen(narrow<bfloat16>(1e300))) && std::isinf(widen(narrow<float16>(-1e300))));
+        expect(std::isnan(widen(narrow<float16>(std::numeric_limits<double>::quiet_NaN()))));
+        // overflow, subnormal numbers and signed zeros
+        expect(widen(narrow<float16>(65504.F)) == 65504.F);
+        expect(std::isinf(widen(narrow<float16>(65520.F))));
+        expect(widen(narrow<float16>(-1e10F)) == -std::numeric_limits<float>::infinity());
+        expect(widen(narrow<float16>(std::ldexp(1.F, -24))) == std::ldexp(1.F, -24));
+        expect(widen(narrow<float16>(std::ldexp(1.F, -26))) == 0.F);
+        expect(std::signbit(widen(narrow<float16>(-0.F))));
+        expect(widen(narrow<bfloat16>(1e38F)) > 9.9e37F);
+        expect(std::isnan(widen(narrow<bfloat16>(std::numeric_limits<float>::quiet_NaN()))));
+
+        // the block conversions agree with the scalar ones
+        std::vector<float> values(1001);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = std::ldexp(float(i) - 500.F, int(i % 40) - 20) / 3.F;
+        }
+        std::vector<float16> halves(values.size());
+        std::vector<float> widened(values.size());
+        narrow(values.data(), std::ssize(values), halves.data());
+        widen(halves.data(), std::ssize(halves), widened.data());
+        bool all_equal = true;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            all_equal = all_equal && halves[i] == narrow<float16>(values[i]);
+            all_equal = all_equal && widened[i] == widen(halves[i]);
+        }
+        expect(all_equal);
+    };
+
+    "ReducedPrecisionVectorArray"_test = []<class Types>()
+    {
+        using F = std::tuple_element_t<0, Types>;
+        using S = std::tuple_element_t<1, Types>;
+        using VecArray = ReducedPrecisionVectorArray<F, S>;
+        // 300 entries do not fit into a single block
+        for (const ssize_t dim : {0, 1, 300})
+        {
+            const auto reference = create_test_array<F>(5, dim);
+            VecArray v(*reference);
+            expect(v.size() == 5 && v.dim() == dim);
+            expect(exactly_equal(v, *reference));
+            expect(exactly_equal(*v.copy(Indices{3, 1}), *reference->copy(Indices{3, 1})));
+            expect(v.inner(v) == reference->inner(*reference));
+            expect(v.inner(v, Indices{4, 0}, Indices{1}) ==
+                   reference->inner(*reference, Indices{4, 0}, Indices{1}));
+            expect(v.pairwise_inner(v, Indices{0, 1}, Indices{2, 3}) ==
+                   reference->pairwise_inner(*reference, Indices{0, 1}, Indices{2, 3}));
+            expect(v.norm2() == reference->norm2());
+            expect(dot_product<F>(v, v) == reference->norm2());
+            // arrays of other types are supported, too
+            expect(v.inner(*reference) == reference->inner(*reference));
+            if (dim > 0)
+            {
+                expect(v.amax() == reference->amax());
+            }
+            const std::vector<std::vector<F>> coefficients{{F(1), F(-1), F(0), F(2), F(0)},
+                                                           {F(0), F(0), F(1), F(0), F(0)}};
+            expect(exactly_equal(*v.lincomb(coefficients), *reference->lincomb(coefficients)));
+
+            v.scal(F(2), Indices{1});
+            reference->scal(F(2), Indices{1});
+            v.axpy(F(0.5), v, Indices{0, 2}, Indices{3, 4});
+            reference->axpy(F(0.5), *reference, Indices{0, 2}, Indices{3, 4});
+            expect(exactly_equal(v, *reference));
+            v.axpy(F(-1), *reference, Indices{3}, Indices{4});
+            reference->axpy(F(-1), *reference, Indices{3}, Indices{4});
+            expect(exactly_equal(v, *reference));
+
+            v.append(v, false, Indices{0});
+            v.append(*reference, false, Indices{4});
+            reference->append(*reference, false, Indices{0, 4});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(Indices{0, 5, 2});
+            reference->delete_vectors(Indices{0, 5, 2});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(std::nullopt);
+            expect(v.size() == 0);
+        }
+    } | std::tuple<std::tuple<float, float16>, std::tuple<float, bfloat16>, std::tuple<double, float16>,
+                   std::tuple<double, float>>{};
+
+    "Inner products accumulate in higher precision"_test = []()
+    {
+        // one million entries of 0.1 (rounded to half precision)
+        const ssize_t dim = 1'000'000;
+        ReducedPrecisionVectorArray<float, float16> v(1, dim);
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            v.set(0, j, 0.1F);
+        }
+        const double entry = widen(narrow<float16>(0.1F));
+        const double expected = double(dim) * entry * entry;
+        expect(std::abs(double(v.norm2()[0]) - expected) / expected < 1e-5);
+        expect(std::abs(double(v.inner(v)[0][0]) - expected) / expected < 1e-5);
+        // the rounding error of naive summation in single precision is several orders of magnitude larger
+        float naive = 0.F;
+        for (ssize_t j = 0; j < dim; ++j)
+        {
+            naive += v.get(0, j) * v.get(0, j);
+        }
+        expect(std::abs(double(naive) - expected) / expected > 1e-3);
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return ReducedPrecisionVectorArray<double, float16>(-1, 2);
+            }));
+        ReducedPrecisionVectorArray<double, bfloat16> v(2, 3);
+        expect(throws<InvalidIndexError>(
+            [&]()
+            {
+                return v.get(2, 0);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                v.axpy(1., ReducedPrecisionVectorArray<double, bfloat16>(2, 4));
+            }));
+    };
+
+    return 0;
+}
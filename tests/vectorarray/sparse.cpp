@@ -0,0 +1,179 @@
+#include <complex>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <nias_cpp/algorithms/dot_product.h>
+#include <nias_cpp/concepts.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/mapped_npy.h>
+#include <nias_cpp/vectorarray/sparse.h>
+
+#include "../boost_ext_ut_no_module.h"
+#include "common.h"
+
+namespace
+{
+// size x dim array whose few nonzero entries are the ones of create_test_array
+template <floating_point_or_complex F>
+std::shared_ptr<MappedNpyVectorArray<F>> create_sparse_test_array(ssize_t size, ssize_t dim)
+{
+    auto ret = std::make_shared<MappedNpyVectorArray<F>>(size, dim);
+    for (ssize_t i = 0; i < size; ++i)
+    {
+        for (ssize_t j = (i * 3) % 7; j < dim; j += 7 + i)
+        {
+            ret->set(i, j, test_entry<F>(i, j));
+        }
+    }
+    return ret;
+}
+
+// explicit zeros are never stored
+template <floating_point_or_complex F>
+bool only_nonzeros_stored(const SparseVectorArray<F>& v)
+{
+    for (const auto& value : v.values())
+    {
+        if (value == F(0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+int main()
+{
+    "SparseVectorArray"_test = []<floating_point_or_complex F>()
+    {
+        using VecArray = SparseVectorArray<F>;
+        for (const ssize_t dim : {0, 1, 50, 1000})
+        {
+            const auto reference = create_sparse_test_array<F>(5, dim);
+            VecArray v(*reference);
+            expect(v.size() == 5 && v.dim() == dim);
+            expect(exactly_equal(v, *reference));
+            expect(v.nnz() < 5 * (dim / 7 + 1) + 1);
+            expect(exactly_equal(VecArray(dim, v.row_offsets(), v.column_indices(), v.values()), *reference));
+            expect(exactly_equal(*v.copy(Indices{3, 1}), *reference->copy(Indices{3, 1})));
+
+            // sparse x sparse, sparse x dense and dense x sparse inner products
+            expect(v.inner(v) == reference->inner(*reference));
+            expect(v.inner(v, Indices{4, 0}, Indices{1}) ==
+                   reference->inner(*reference, Indices{4, 0}, Indices{1}));
+            expect(v.inner(*reference) == reference->inner(*reference));
+            expect(EuclideanInnerProduct<F>().apply(*reference, v, Indices{2, 0}) ==
+                   reference->inner(*reference, Indices{2, 0}));
+            expect(EuclideanInnerProduct<F>().apply_pairwise(*reference, v, Indices{0, 1}, Indices{2, 3}) ==
+                   reference->pairwise_inner(*reference, Indices{0, 1}, Indices{2, 3}));
+            expect(v.pairwise_inner(v, Indices{0, 1}, Indices{2, 3}) ==
+                   reference->pairwise_inner(*reference, Indices{0, 1}, Indices{2, 3}));
+            expect(v.norm2() == reference->norm2());
+            expect(dot_product<F>(v, v) == reference->pairwise_inner(*reference));
+            if (dim > 0)
+            {
+                expect(v.amax() == reference->amax());
+            }
+            const std::vector<std::vector<F>> coefficients{{F(1), F(-1), F(0), F(2), F(0)},
+                                                           {F(0), F(0), F(0.5), F(0), F(0)}};
+            const auto lincomb = v.lincomb(coefficients);
+            expect(exactly_equal(*lincomb, *reference->lincomb(coefficients)));
+            expect(only_nonzeros_stored(dynamic_cast<const VecArray&>(*lincomb)));
+
+            // adding a sparse vector to a dense one
+            const auto dense = reference->copy();
+            v.add_to(*dense, F(2), Indices{0, 1}, Indices{4});
+            reference->axpy(F(2), *reference->copy(), Indices{0, 1}, Indices{4});
+            expect(exactly_equal(*dense, *reference));
+
+            v = VecArray(*reference);
+            v.scal(F(-0.5), Indices{1});
+            reference->scal(F(-0.5), Indices{1});
+            v.axpy(F(0.5), v, Indices{0, 2}, Indices{3, 4});
+            reference->axpy(F(0.5), *reference, Indices{0, 2}, Indices{3, 4});
+            expect(exactly_equal(v, *reference));
+            // dense x and cancellation
+            v.axpy(F(-1), *reference, Indices{3}, Indices{3});
+            reference->axpy(F(-1), *reference, Indices{3}, Indices{3});
+            expect(exactly_equal(v, *reference));
+            expect(v.nnz(3) == 0);
+            v.scal(F(0), Indices{2});
+            reference->scal(F(0), Indices{2});
+            expect(exactly_equal(v, *reference));
+            expect(only_nonzeros_stored(v));
+
+            if (dim > 0)
+            {
+                v.set(1, dim - 1, F(3));
+                v.set(1, 0, F(0));
+                reference->set(1, dim - 1, F(3));
+                reference->set(1, 0, F(0));
+                expect(exactly_equal(v, *reference));
+                expect(only_nonzeros_stored(v));
+            }
+
+            v.append(v, false, Indices{0});
+            v.append(*reference, false, Indices{4});
+            reference->append(*reference, false, Indices{0, 4});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(Indices{0, 5, 2});
+            reference->delete_vectors(Indices{0, 5, 2});
+            expect(exactly_equal(v, *reference));
+            v.delete_vectors(std::nullopt);
+            expect(v.size() == 0 && v.nnz() == 0);
+        }
+    } | std::tuple<double, float, std::complex<double>>{};
+
+    "CSR constructor"_test = []()
+    {
+        // stored zeros are removed
+        const SparseVectorArray<double> v(4, {0, 2, 2, 4}, {0, 3, 1, 2}, {1., 0., 2., 3.});
+        expect(v.size() == 3 && v.nnz() == 3);
+        expect(v.get(0, 0) == 1. && v.get(0, 3) == 0. && v.get(1, 2) == 0. && v.get(2, 2) == 3.);
+        expect(v.row_offsets() == std::vector<ssize_t>{0, 1, 1, 3});
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return SparseVectorArray<double>(4, {0, 2}, {2, 1}, {1., 1.});
+            }));
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return SparseVectorArray<double>(4, {0, 1}, {4}, {1.});
+            }));
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return SparseVectorArray<double>(4, {0, 2}, {0}, {1.});
+            }));
+    };
+
+    "Invalid arguments"_test = []()
+    {
+        expect(throws<InvalidArgumentError>(
+            []()
+            {
+                return SparseVectorArray<double>(-1, 2);
+            }));
+        SparseVectorArray<double> v(2, 3);
+        expect(throws<InvalidIndexError>(
+            [&]()
+            {
+                return v.get(0, 3);
+            }));
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return v.inner(SparseVectorArray<double>(2, 4));
+            }));
+    };
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <memory>
+#include <vector>
+
+#include <nias_cpp/algorithms/weak_greedy.h>
+#include <nias_cpp/checked_integer_cast.h>
+#include <nias_cpp/exceptions.h>
+#include <nias_cpp/indices.h>
+#include <nias_cpp/inner_products/euclidean.h>
+#include <nias_cpp/interfaces/vector.h>
+#include <nias_cpp/interfaces/vectorarray.h>
+#include <nias_cpp/type_traits.h>
+#include <nias_cpp/vectorarray/list.h>
+
+#include "boost_ext_ut_no_module.h"
+#include "test_vector.h"
+#include "vectorarray/common.h"
+
+namespace
+{
+constexpr ssize_t dim = 40;
+constexpr ssize_t training_set_size = 50;
+
+// snapshot for the i-th training parameter (a smooth function of the parameter)
+std::shared_ptr<ListVectorArray<double>> snapshot(ssize_t i)
+{
+    const double mu = double(i) / double(training_set_size - 1);
+    auto vector = std::make_shared<DynamicVector<double>>(dim);
+    for (ssize_t j = 0; j < dim; ++j)
+    {
+        vector->get(j) = 1. / (1. + (10. * mu * double(j + 1) / double(dim)));
+    }
+    auto ret = std::make_shared<ListVectorArray<double>>(dim);
+    ret->append(std::shared_ptr<VectorInterface<double>>(vector));
+    return ret;
+}
+
+// norm of the part of the i-th snapshot that is orthogonal to the (orthonormal) basis
+double projection_error(const VectorArrayInterface<double>& basis, ssize_t i)
+{
+    const auto u = snapshot(i);
+    if (basis.size() > 0)
+    {
+        const auto coefficients = basis.inner(*u);
+        std::vector<std::vector<double>> transposed(1);
+        for (const auto& row : coefficients)
+        {
+            transposed[0].push_back(row[0]);
+        }
+        u->axpy(-1., *basis.lincomb(transposed));
+    }
+    return u->norm()[0];
+}
+}  // namespace
+
+int main()
+{
+    "Weak greedy"_test = []()
+    {
+        for (const ssize_t num_threads : {1, 4})
+        {
+            ListVectorArray<double> basis(dim);
+            const auto report = weak_greedy(basis, training_set_size, &projection_error, &snapshot,
+                                            EuclideanInnerProduct<double>(),
+                                            {.tolerance = 1e-8, .num_threads = num_threads});
+            expect(report.converged && report.max_error <= 1e-8);
+            expect(basis.size() > 1 && basis.size() < 20);
+            std::vector<std::vector<double>> identity(as_size_t(basis.size()),
+                                                      std::vector<double>(as_size_t(basis.size()), 0.));
+            for (size_t i = 0; i < identity.size(); ++i)
+            {
+                identity[i][i] = 1.;
+            }
+            expect(approx_equal(basis.inner(basis), identity));
+            // one estimation per extension plus the final one
+            expect(std::ssize(report.iterations) == basis.size() + 1);
+            // the first snapshot (parameter 0) has the largest norm
+            expect(report.iterations[0].selected_index == 0);
+            for (const auto& iteration : report.iterations)
+            {
+                expect(iteration.estimation_milliseconds >= 0. && iteration.solve_milliseconds >= 0. &&
+                       iteration.orthonormalization_milliseconds >= 0.);
+            }
+            expect(report.iterations.back().num_appended == 0);
+            for (ssize_t i = 0; i < training_set_size; ++i)
+            {
+                expect(projection_error(basis, i) <= 1e-8);
+            }
+        }
+    };
+
+    "Stopping criteria"_test = []()
+    {
+        ListVectorArray<double> basis(dim);
+        auto report = weak_greedy(basis, training_set_size, &projection_error, &snapshot,
+                                  EuclideanInnerProduct<double>(), {.max_extensions = 3});
+        expect(!report.converged && basis.size() == 3 && report.iterations.size() == 4);
+        expect(report.max_error == report.iterations.back().max_error && report.max_error > 0.);
+        // snapshots which are already contained in the basis stop the algorithm
+        ListVectorArray<double> other_basis(dim);
+        report = weak_greedy(
+            other_basis, training_set_size,
+            [](const VectorArrayInterface<double>& /*basis*/, ssize_t /*i*/)
+            {
+                return 1.;
+            },
+            [](ssize_t /*i*/)
+            {
+                return snapshot(0);
+            });
+        expect(!report.converged && other_basis.size() == 1 && report.iterations.size() == 2);
+        expect(throws<InvalidArgumentError>(
+            [&]()
+            {
+                return weak_greedy(basis, 0, &projection_error, &snapshot);
+            }));
+    };
+
+    return 0;
+}